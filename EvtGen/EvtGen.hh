@@ -25,6 +25,12 @@
 //                               for the lifetime of the generator.
 //    JBack   June 2011          Added HepMC event interface.
 //
+//            Oct 2026           The generator state now lives in an
+//                               EvtGenContext owned by this class, so that
+//                               several instances can run on separate
+//                               threads. Construct them one at a time;
+//                               the particle property table is shared.
+//
 //------------------------------------------------------------------------
 
 #ifndef EVTGEN_HH
@@ -32,7 +38,12 @@
 
 #include "EvtGenBase/EvtPDL.hh"
 
+#include <stdint.h>
+
 #include <list>
+#include <string>
+#include <utility>
+#include <vector>
 
 class EvtParticle;
 class EvtRandomEngine;
@@ -42,6 +53,9 @@ class EvtSpinDensity;
 class EvtAbsRadCorr;
 class EvtDecayBase;
 class EvtHepMCEvent;
+class EvtGenContext;
+class EvtStartupProfile;
+class EvtDecayStats;
 
 class EvtGen{
 
@@ -62,11 +76,108 @@ public:
 
   void generateDecay(EvtParticle *p);
 
+  // Receives the decays made by generateDecays, in event-number order and
+  // on the thread which called generateDecays. The decay tree is deleted
+  // once decayDone returns.
+  class DecayCallback {
+  public:
+    virtual ~DecayCallback() {}
+    virtual void decayDone(int iEvent, EvtParticle* particle)=0;
+  };
+
+  // Decay nEvents particles with the given PDG code and lab momenta,
+  // spread over the worker generators (see setWorkers) with work stealing.
+  // Without workers the decays are made serially by this generator.
+  void generateDecays(int PDGId, const EvtVector4R* momenta, int nEvents,
+		      DecayCallback& callback,
+		      EvtSpinDensity* spinDensity = 0);
+
+  // Create one worker generator per random engine for generateDecays.
+  // Each worker reads the same decay and user decay files as this
+  // generator, into its own clones of the extra models. The engines are
+  // not owned and must give independent streams. The workers share this
+  // generator's radiative correction engine, which then has to be thread
+  // safe, unless isrEngines holds one engine per worker.
+  // The external generators (Pythia, Photos, Tauola) are engines shared
+  // by the whole process; EvtExternalGenFactory::doDecay makes their
+  // decays one at a time, so the workers wait for each other there.
+  void setWorkers(const std::vector<EvtRandomEngine*>& randomEngines,
+		  const std::vector<EvtAbsRadCorr*>* isrEngines = 0);
+
+  int getNWorkers() const {return _workers.size();}
+
+  // Event numbering for generateDecays: event i of the next call is number
+  // firstEvent+i of the given run, and the numbers carry on from call to
+  // call. Random engines which support it (e.g. EvtPhiloxRandomEngine) are
+  // moved to the stream of each event before it is decayed, so the random
+  // numbers an event starts from do not depend on the worker it runs on.
+  // The decays themselves still can: every worker has its own models,
+  // which learn their maximum probabilities (EvtDecayBase::getProbMax)
+  // and keep other state from the events they saw before. The output is
+  // therefore not guaranteed to be the same for different numbers of
+  // workers.
+  void setEventNumber(uint32_t run, uint64_t firstEvent);
+
+  // Maximum probabilities learned by the models without a fixed one (see
+  // EvtDecayBase::getProbMax). Write them at the end of a job and read
+  // them before the first decay of the next one, which then starts with
+  // the same maxima instead of a warm-up over the first 500 decays of
+  // each mode. Writing merges the values of all workers and the ones read
+  // before, keeping the largest. Both return false on I/O errors.
+  bool readProbMaxCache(const std::string& fileName);
+  bool writeProbMaxCache(const std::string& fileName);
+
+  // Calls, accept/reject tries, mass tree retries, probmax overruns and
+  // (with EvtDecayStats::setTiming) the decay() time of every channel
+  // used so far, summed over the workers. May be taken at any point
+  // between generate calls; writeDecayStats writes them as JSON.
+  EvtDecayStats getDecayStats();
+  bool writeDecayStats(const std::string& fileName);
+
+  // Compile the particle properties and the decay table read so far
+  // (including the user decay files) into a binary image, see
+  // EvtDecayImage. Passing such an image as the decay file to the
+  // constructor loads it directly; the PDT file is then not read.
+  bool writeDecayImage(const std::string& fileName);
+
+  // Wall time and heap growth of the phases of the constructor and of
+  // readUDecay, down to the init of each model. Only filled if
+  // EvtStartupProfile::setEnabled(true) was called before the constructor;
+  // see EvtStartupProfile::print and writeJSON for the report.
+  const EvtStartupProfile& getStartupProfile() const;
+
+  // The generator state. generateDecay and readUDecay bind it for their
+  // duration; bind it with EvtGenContext::Scope on any other thread that
+  // builds particles or uses EvtRandom outside of these calls.
+  EvtGenContext* getContext() {return _context;}
+
 private:
 
+  EvtGen(const EvtGen&);
+  EvtGen& operator=(const EvtGen&);
+
+  void deleteWorkers();
+
   EvtPDL _pdl;
   int _mixingType;
 
+  EvtGenContext* _context;
+
+  // What is needed to build the worker generators
+  std::string _decayName;
+  std::string _pdtTableName;
+  EvtAbsRadCorr* _isrEngine;
+  std::list<EvtDecayBase*> _extraModels;
+  // The clones of the extra models made for a worker, which it owns
+  std::list<EvtDecayBase*> _ownedModels;
+  bool _useXml;
+  std::vector< std::pair<std::string, bool> > _userDecayFiles;
+
+  std::vector<EvtGen*> _workers;
+
+  uint32_t _runNumber;
+  uint64_t _nextEvent;
+
 };
 
 
@@ -0,0 +1,60 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtAliasTable.hh
+//
+// Description: Walker alias table for sampling an index from a discrete
+//              distribution in constant time (A.J. Walker, ACM Trans.
+//              Math. Software 3 (1977) 253; construction after M.D. Vose,
+//              IEEE Trans. Software Eng. 17 (1991) 972). The table is
+//              built once from the weights, after which each sample
+//              needs one uniform random number and one comparison.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTALIASTABLE_HH
+#define EVTALIASTABLE_HH
+
+#include <vector>
+
+class EvtAliasTable {
+
+public:
+
+  EvtAliasTable() {}
+
+  // The weights need not be normalised; entries with zero (or negative)
+  // weight are never picked.
+  EvtAliasTable(const std::vector<double>& weights);
+
+  void build(const std::vector<double>& weights);
+
+  // True if all weights were zero, in which case pick must not be used.
+  bool empty() const {return _prob.empty();}
+
+  // Index picked by the uniform random number u in [0,1).
+  int pick(double u) const {
+    int n = _prob.size();
+    double x = u*n;
+    int i = static_cast<int>(x);
+    if (i >= n) i = n-1;
+    return (x-i < _prob[i]) ? i : _alias[i];
+  }
+
+private:
+
+  std::vector<double> _prob;
+  std::vector<int> _alias;
+
+};
+
+#endif
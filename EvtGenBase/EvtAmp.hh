@@ -15,6 +15,8 @@
 // Modification history:
 //
 //    DJL/RYD     May 29, 1997         Module created
+//                Oct 2026             Contractions use strided kernels
+//                                     specialised on the number of states
 //
 //------------------------------------------------------------------------
 
@@ -91,6 +93,10 @@ private:
   void setNDaug(int n);
   void setNState(int parent_states,int *daug_states);
 
+  // Number of amplitudes for one value of the k:th nontrivial index:
+  // the product of the numbers of states before and after it.
+  void getStrides(int k,int& nInner,int& nOuter) const;
+
   // the amplitudes
   EvtComplex _amp[125];
 
@@ -15,6 +15,9 @@
 // Modification history:
 //
 //    DJL/RYD     August 11, 1998         Module created
+//                Oct 2026                Probmax from EvtProbMaxCache
+//                Oct 2026                Optional lazy initialisation
+//                Oct 2026                Run statistics, see EvtDecayStats
 //
 //------------------------------------------------------------------------
 
@@ -27,6 +30,11 @@
 #include "EvtGenBase/EvtSpinType.hh"
 #include <stdlib.h>
 #include <vector>
+
+#ifdef EVTGEN_CPP11
+#include <atomic>
+#endif
+
 class EvtParticle;
 class EvtSpinType;
 
@@ -54,6 +62,14 @@ class EvtDecayBase{
   double getProbMax( double prob );
   double resetProbMax( double prob );
 
+  // Identifies the decay in the EvtProbMaxCache of the current context;
+  // a maximum found there is used instead of the warm-up in getProbMax.
+  std::string getProbMaxKey() const;
+
+  // The maximum learned by getProbMax, once the warm-up is over (or it
+  // came from the cache); false if the model sets its own maximum.
+  bool getLearnedProbMax(double& prob) const;
+
   EvtDecayBase();
   virtual ~EvtDecayBase();
 
@@ -88,6 +104,42 @@ class EvtDecayBase{
   void printSummary() const ;
   void printInfo() const ;
 
+  // With lazy initialisation saveDecayInfo only stores the decay, and
+  // init(), initProbMax() and the charge check are left until the model
+  // is first picked by EvtParticleDecayList, so that a job only pays for
+  // the models it uses. Off by default; it applies to the decay tables
+  // read after it is set. The switch is kept per generator (EvtGenContext);
+  // set before the EvtGen constructor, it applies to the new generator and
+  // to its workers.
+  static void setLazyInit(bool lazy);
+  static bool getLazyInit();
+
+  // Initialise the model now if that was left for later; the first
+  // caller does it, concurrent callers wait until it is done.
+  void ensureInit() {
+    if (!_initialised) initDeferred();
+  }
+  bool isInitialised() const {return _initialised;}
+
+  // What this channel has cost so far, see EvtDecayStats. A call is one
+  // makeDecay, which takes one or more tries of decay() to be accepted;
+  // exhausted counts the calls which gave up after 10000 tries.
+  struct RunStats {
+    long calls;
+    long tries;
+    long exhausted;
+    long massTreeRetries;
+    long probMaxOverruns;
+    double decaySeconds;
+    double probMax;
+    double maxProb;
+    double sumProb;
+  };
+
+  RunStats getRunStats() const;
+  void resetRunStats();
+  void addMassTreeRetries(int n) {_massTreeRetries+=n;}
+
   
   //Does not really belong here but I don't have a better place.
   static void findMasses(EvtParticle *p, int ndaugs, 
@@ -115,6 +167,12 @@ protected:
   bool _daugsDecayedByParentModel;
   bool daugsDecayedByParentModel() {return _daugsDecayedByParentModel;}
 
+  // Used by makeDecay: startDecay counts the call, tryDecay runs decay(p)
+  // and counts (and, if switched on, times) the try.
+  void startDecay() {_calls++;}
+  void tryDecay(EvtParticle* p);
+  void countExhausted() {_exhausted++;}
+
 private:
 
 
@@ -132,10 +190,30 @@ private:
   int _summary;
   int _verbose;
 
+  void initModel();
+  void initDeferred();
+
+#ifdef EVTGEN_CPP11
+  // Some models are cloned by copying, which std::atomic does not allow
+  struct InitFlag {
+    std::atomic<bool> value;
+    InitFlag() : value(false) {}
+    InitFlag(const InitFlag& o) : value(o.value.load()) {}
+    InitFlag& operator=(const InitFlag& o) {value=o.value.load(); return *this;}
+    InitFlag& operator=(bool v) {value=v; return *this;}
+    operator bool() const {return value;}
+  };
+  InitFlag _initialised;
+#else
+  bool _initialised;
+#endif
+  bool _initStarted;
+
 
   int defaultprobmax;
   double probmax;
   int ntimes_prob;
+  bool _probMaxCached;
 
   //Should charge conservation be checked when model is 
   //created? 1=yes 0 no.
@@ -146,6 +224,13 @@ private:
   double sum_prob;
   double max_prob;
 
+  long _calls;
+  long _tries;
+  long _exhausted;
+  long _massTreeRetries;
+  long _probMaxOverruns;
+  double _decaySeconds;
+
 
 };
 
@@ -0,0 +1,56 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtDecayImage.hh
+//
+// Description: Precompiled decay table. write() stores the resolved state
+//              left by readPDT and the decay files read so far: the PDT
+//              entries, the aliases, charge conjugates and particle
+//              property changes in the order they were made, every decay
+//              mode (model, daughters, arguments and branching fractions,
+//              with CDecay, CopyDecay and user decay file overrides already
+//              applied), the model and external generator commands and the
+//              PHOTOS setting. read() maps such an image into memory and
+//              builds the particle list and decay table from its fixed-size
+//              records, without parsing any text.
+//
+//              The image is a versioned binary file for the machine which
+//              wrote it; images of another version or byte order are
+//              refused. It does not depend on the decay files any more, so
+//              it has to be made again after they change.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTDECAYIMAGE_HH
+#define EVTDECAYIMAGE_HH
+
+#include <string>
+
+class EvtDecayImage {
+
+public:
+
+  // Write the particle properties and the decay table of the current
+  // context. Returns false if the file can not be written.
+  static bool write(const std::string& fileName);
+
+  // True if the file starts like a decay image.
+  static bool isImage(const std::string& fileName);
+
+  // Load an image into the current context. The particle properties are
+  // shared by all generators; if they are already loaded they have to
+  // match the image. Aborts on a damaged or incompatible image.
+  static void read(const std::string& fileName, bool verbose=true);
+
+};
+
+#endif
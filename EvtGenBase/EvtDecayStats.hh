@@ -0,0 +1,89 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtDecayStats.hh
+//
+// Description: Run statistics of the decay channels (EvtDecayBase::RunStats)
+//              collected from one or more decay tables: the number of
+//              makeDecay calls, the accept/reject tries they took, the
+//              calls which gave up, the mass tree retries of
+//              EvtParticle::generateMassTree, the probmax overruns and the
+//              probabilities seen. Channels are matched by
+//              EvtDecayBase::getProbMaxKey, so the tables of several
+//              workers add up.
+//
+//              The counters are always kept. The wall time spent in the
+//              decay() of each channel (not including its daughters) is
+//              only measured after setTiming(true), as the clock costs
+//              about as much as a cheap decay. The switch is kept per
+//              generator (EvtGenContext): a generator takes it over from
+//              the thread that constructs it, and setWorkers passes it on
+//              to the workers.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTDECAYSTATS_HH
+#define EVTDECAYSTATS_HH
+
+#include "EvtGenBase/EvtDecayBase.hh"
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+class EvtDecayTable;
+
+class EvtDecayStats {
+
+public:
+
+  EvtDecayStats() {}
+
+  static void setTiming(bool timing);
+  static bool isTiming();
+
+  struct Channel {
+    std::string key;
+    std::string parent;
+    std::string model;
+    std::string daughters;
+    double branchingFraction;
+    EvtDecayBase::RunStats stats;
+  };
+
+  // Add the statistics of the channels of a decay table which have been
+  // used at all.
+  void collect(EvtDecayTable* decayTable);
+
+  const std::vector<Channel>& getChannels() const {return _channels;}
+  bool empty() const {return _channels.empty();}
+  void clear() {_channels.clear(); _index.clear();}
+
+  // The channels, most expensive first: by decay time if it was measured,
+  // else by the number of tries. maxLines<=0 prints all of them.
+  void print(std::ostream& output, int maxLines=0) const;
+
+  void writeJSON(std::ostream& output) const;
+  bool writeJSON(const std::string& fileName) const;
+
+private:
+
+  std::vector<std::size_t> sorted() const;
+
+  std::vector<Channel> _channels;
+  std::map<std::string,std::size_t> _index;
+
+};
+
+#endif
@@ -17,6 +17,7 @@
 // Modification history:
 //
 //    DJL/RYD     September 25, 1996         Module created
+//                Oct 2026                   EvtDecayImage may fill the table
 //
 //------------------------------------------------------------------------
 
@@ -73,6 +74,9 @@ public:
 
 protected:  
 
+  friend class EvtGenContext;
+  friend class EvtDecayImage;
+
   EvtDecayTable();
   ~EvtDecayTable();
 
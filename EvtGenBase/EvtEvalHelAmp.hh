@@ -17,6 +17,8 @@
 // Modification history:
 //
 //    RYD      October 24, 2002         Module created
+//             Oct 2026   Tabulated d-functions, flat amplitude storage
+//                        and optional consistency check
 //
 //------------------------------------------------------------------------
 
@@ -26,6 +28,7 @@
 #include "EvtGenBase/EvtDecayAmp.hh"
 #include "EvtGenBase/EvtSpinType.hh"
 #include "EvtGenBase/EvtId.hh"
+#include <vector>
 
 class EvtParticle;
 class EvtAmp;
@@ -45,30 +48,61 @@ public:
 
   void evalAmp(EvtParticle *p, EvtAmp& amp); 
 
+  //Compare the probability before and after the rotation to the
+  //helicity basis of the particles for each event and abort if they
+  //differ. Off by default; meant for debugging new models. Kept per
+  //generator (EvtGenContext) and passed on to its workers.
+  static void setConsistencyCheck(bool check);
+  static bool getConsistencyCheck();
 
 private:
 
   void fillHelicity(int* lambda2,int n,int J2, EvtId id);
+  void setUpDFunctions();
+  void evalDFunctions(double theta);
   void setUpRotationMatrices(EvtParticle *p,double theta, double phi);
   void applyRotationMatrices();
 
+  //index of the amplitude for the helicity states ia, ib and ic
+  int index(int ia,int ib,int ic) const {return (ia*_nB+ib)*_nC+ic;}
+
   //spins states available for particle A, B, and C.
   int _nA,_nB,_nC;
 
-  //helicity amplitudes
-  EvtComplexPtrPtr _HBC;
+  //helicity amplitudes, _HBC[ib*_nC+ic]
+  std::vector<EvtComplex> _HBC;
 
   //2 times spin for each of the particles
   int _JA2,_JB2,_JC2;
 
   //2 times the helicity for the states
-  int *_lambdaA2,*_lambdaB2,*_lambdaC2;
-
-  //Rotation matrices
-  EvtComplexPtrPtr _RA,_RB,_RC;
-
-  //temporary array for amplitudes
-  EvtComplexPtrPtrPtr _amp,_amp1,_amp3;
+  std::vector<int> _lambdaA2,_lambdaB2,_lambdaC2;
+
+  //The distinct d-functions d^JA_{lambdaA,lambdaB-lambdaC} of the decay
+  //as polynomials in cos(theta/2) and sin(theta/2): the terms of
+  //function i are _dFirst[i] to _dFirst[i+1]-1. _dIndex gives the
+  //function of each amplitude, -1 if it is not allowed.
+  std::vector<int> _dFirst;
+  std::vector<double> _dCoef;
+  std::vector<int> _dPowC,_dPowS;
+  std::vector<int> _dIndex;
+  std::vector<double> _dValue;
+
+  //The distinct phases, 2 times lambdaA-lambdaB+lambdaC, and the
+  //phase of each amplitude
+  std::vector<int> _phase2;
+  std::vector<int> _phaseIndex;
+  std::vector<EvtComplex> _phase;
+
+  //powers of cos(theta/2) and sin(theta/2)
+  std::vector<double> _powC,_powS;
+
+  //Rotation matrices, _RA[i*_nA+j]; not needed for scalars
+  bool _rotA,_rotB,_rotC;
+  std::vector<EvtComplex> _RA,_RB,_RC;
+
+  //amplitudes, _amp[index(ia,ib,ic)], and temporary array
+  std::vector<EvtComplex> _amp,_ampTmp;
 
 };
 
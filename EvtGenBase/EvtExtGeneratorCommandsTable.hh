@@ -14,6 +14,7 @@
 // Modification history:
 //
 //    Daniel Craik       March 2012            Module created
+//                       Oct 2026              Access to all commands
 //
 //------------------------------------------------------------------------
 
@@ -36,9 +37,12 @@ public:
 
   void addCommand(std::string extGenerator, Command command) { _commandMap[extGenerator].push_back(command); }
   const GeneratorCommands& getCommands(std::string extGenerator) { return _commandMap[extGenerator]; }
+  const GlobalCommandMap& getAllCommands() const { return _commandMap; }
 
 protected:
 
+  friend class EvtGenContext;
+
   EvtExtGeneratorCommandsTable();
   ~EvtExtGeneratorCommandsTable();
 
@@ -0,0 +1,59 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtFileReplacer.hh
+//
+// Description: Writes a file which replaces an existing one in one step,
+//              so that other jobs reading (or writing) the same file, e.g.
+//              a shared cache, never see it half written. The contents go
+//              to a temporary file next to the target, which commit()
+//              renames over it; a replacer destroyed without a successful
+//              commit removes its temporary file and leaves the target
+//              untouched.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTFILEREPLACER_HH
+#define EVTFILEREPLACER_HH
+
+#include <fstream>
+#include <string>
+
+class EvtFileReplacer {
+
+public:
+
+  EvtFileReplacer(const std::string& fileName);
+  ~EvtFileReplacer();
+
+  // False if the temporary file could not be opened
+  bool isOpen() const {return _output.is_open();}
+
+  std::ostream& stream() {return _output;}
+
+  // Close the temporary file and rename it to the target. Returns false
+  // if writing or renaming failed.
+  bool commit();
+
+private:
+
+  EvtFileReplacer(const EvtFileReplacer&);
+  EvtFileReplacer& operator=(const EvtFileReplacer&);
+
+  std::string _fileName;
+  std::string _tmpName;
+  std::ofstream _output;
+  bool _committed;
+
+};
+
+#endif
@@ -0,0 +1,218 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtGenContext.hh
+//
+// Description: Holds the state of one generation stream: the decay table,
+//              the model registry, the random and radiative correction
+//              engines, the reject flag and the CP/mixing settings.
+//              The static accessors (EvtDecayTable::getInstance(),
+//              EvtRandom::Flat(), EvtStatus::getRejectFlag(), ...) use the
+//              context bound to the calling thread, so that several EvtGen
+//              instances can generate events on separate threads.
+//
+//              Each EvtGen owns one context. Threads which never bind a
+//              context share a process-wide default one, which keeps the
+//              single generator use case unchanged.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//    Oct 2026            Added the buffer of random numbers
+//    Oct 2026            Added the particle memory pool
+//    Oct 2026            Added the probmax cache
+//    Oct 2026            Added the startup profile
+//    Oct 2026            Added the phase space batch
+//    Oct 2026            Added the lazy initialisation switch
+//    Oct 2026            Added the startup profile switch
+//    Oct 2026            Added the decay timing switch
+//    Oct 2026            Added the helicity amplitude check switch
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTGENCONTEXT_HH
+#define EVTGENCONTEXT_HH
+
+#include "EvtGenBase/EvtPhaseSpaceBatch.hh"
+#include "EvtGenBase/EvtProbMaxCache.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
+
+#include <stdint.h>
+#include <vector>
+
+class EvtDecayTable;
+class EvtModel;
+class EvtCPUtil;
+class EvtExtGeneratorCommandsTable;
+class EvtRandomEngine;
+class EvtAbsRadCorr;
+class EvtParticlePool;
+
+class EvtGenContext {
+
+public:
+
+  EvtGenContext();
+  ~EvtGenContext();
+
+  // The context used by the static accessors on the calling thread.
+  // Falls back to the process-wide default context if none is bound.
+  static EvtGenContext* current();
+
+  // Bind a context to the calling thread; 0 restores the default context.
+  static void setCurrent(EvtGenContext* context);
+
+  // Binds a context to the calling thread for the lifetime of the
+  // object and restores the previous binding afterwards.
+  class Scope {
+  public:
+    Scope(EvtGenContext* context);
+    ~Scope();
+  private:
+    EvtGenContext* _previous;
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+  };
+
+  EvtDecayTable* getDecayTable() {return _decayTable;}
+  EvtModel& getModelList() {return *_modelList;}
+  EvtCPUtil* getCPUtil() {return _cpUtil;}
+  EvtExtGeneratorCommandsTable* getExtGenCommands() {return _extGenCommands;}
+
+  // Memory for the particles created while this context is bound
+  EvtParticlePool* getParticlePool() {return _particlePool;}
+
+  // Maximum probabilities of earlier jobs, see EvtDecayBase::getProbMax
+  EvtProbMaxCache& getProbMaxCache() {return _probMaxCache;}
+
+  // Phases measured by EvtStartupProfile::Phase on this context, if
+  // profiling is switched on (see EvtStartupProfile::setEnabled)
+  EvtStartupProfile& getStartupProfile() {return _startupProfile;}
+  void setStartupProfileEnabled(bool enabled) {_startupProfileEnabled = enabled;}
+  bool isStartupProfileEnabled() const {return _startupProfileEnabled;}
+
+  // Whether decay() is timed for the run statistics (see
+  // EvtDecayStats::setTiming)
+  void setDecayTiming(bool timing) {_decayTiming = timing;}
+  bool isDecayTiming() const {return _decayTiming;}
+
+  // Whether EvtEvalHelAmp checks that the rotation to the helicity basis
+  // keeps the probability (see EvtEvalHelAmp::setConsistencyCheck)
+  void setHelAmpCheck(bool check) {_helAmpCheck = check;}
+  bool getHelAmpCheck() const {return _helAmpCheck;}
+
+  // Configurations prefetched by EvtGenKine::PhaseSpace; a batch size
+  // of 0 or 1 disables the prefetching (see EvtGenKine::setBatchSize).
+  EvtPhaseSpaceBatch& getPhaseSpaceBatch() {return _phaseSpaceBatch;}
+  void setPhaseSpaceBatchSize(int n) {
+    _phaseSpaceBatchSize = n > 1 ? n : 0;
+    _phaseSpaceBatch.clear();
+  }
+  int getPhaseSpaceBatchSize() const {return _phaseSpaceBatchSize;}
+
+  // Whether the decay tables read on this context leave the model
+  // initialisation until first use (see EvtDecayBase::setLazyInit)
+  void setLazyInit(bool lazy) {_lazyInit = lazy;}
+  bool getLazyInit() const {return _lazyInit;}
+
+  //The context does not take ownership of the engines set here;
+  //the caller needs to make sure that they are not destroyed.
+  EvtRandomEngine* getRandomEngine() {return _randomEngine;}
+  void setRandomEngine(EvtRandomEngine* randomEngine) {
+    _randomEngine=randomEngine;
+    clearRandomBuffer();
+    _phaseSpaceBatch.clear();
+  }
+
+  // The next number for EvtRandom. With a buffer size n > 0 the numbers
+  // are taken from the engine n at a time (EvtRandomEngine::randomArray)
+  // and handed out from the buffer; the sequence is the same as without
+  // buffering, but the engine runs up to n-1 numbers ahead of its users.
+  // A size of 0 or 1, the default 0, takes every number directly from the
+  // engine. Changing the size hands out the numbers already buffered first.
+  double nextRandom() {
+    if (_randomPosition < _randomFilled) return _randomBuffer[_randomPosition++];
+    return refillRandom();
+  }
+
+  void setRandomBufferSize(int n);
+  int getRandomBufferSize() const {return _randomBufferSize;}
+
+  // Move the engine to the stream of the given event (see
+  // EvtRandomEngine::setStream), dropping any numbers left in the buffer
+  // and any prefetched phase space configurations.
+  bool setRandomStream(uint32_t run, uint64_t event);
+
+  EvtAbsRadCorr* getRadCorrEngine() {return _radCorrEngine;}
+  void setRadCorrEngine(EvtAbsRadCorr* radCorrEngine) {_radCorrEngine=radCorrEngine;}
+
+  // Engines created on behalf of the user (e.g. the defaults chosen by
+  // EvtGen); these are deleted together with the context.
+  void adoptRandomEngine(EvtRandomEngine* randomEngine);
+  void adoptRadCorrEngine(EvtAbsRadCorr* radCorrEngine);
+
+  bool& alwaysRadCorr() {return _alwaysRadCorr;}
+  bool& neverRadCorr() {return _neverRadCorr;}
+
+  int* rejectFlag() {return &_rejectFlag;}
+
+  // Parameters of the incoherent B0 and Bs mixing, see EvtIncoherentMixing
+  struct IncoherentMixing {
+    bool doB0Mixing;
+    bool doBsMixing;
+    bool enableFlip;
+    double dGammad;
+    double deltamd;
+    double dGammas;
+    double deltams;
+  };
+
+  IncoherentMixing& getIncoherentMixing() {return _incoherentMixing;}
+
+private:
+
+  double refillRandom();
+  void clearRandomBuffer() {_randomPosition=0; _randomFilled=0;}
+
+  EvtDecayTable* _decayTable;
+  EvtModel* _modelList;
+  EvtCPUtil* _cpUtil;
+  EvtExtGeneratorCommandsTable* _extGenCommands;
+  EvtParticlePool* _particlePool;
+  EvtProbMaxCache _probMaxCache;
+  EvtStartupProfile _startupProfile;
+  bool _startupProfileEnabled;
+  bool _decayTiming;
+  bool _helAmpCheck;
+  EvtPhaseSpaceBatch _phaseSpaceBatch;
+  int _phaseSpaceBatchSize;
+  bool _lazyInit;
+
+  EvtRandomEngine* _randomEngine;
+  EvtRandomEngine* _ownedRandomEngine;
+
+  std::vector<double> _randomBuffer;
+  int _randomBufferSize;
+  int _randomPosition;
+  int _randomFilled;
+
+  EvtAbsRadCorr* _radCorrEngine;
+  EvtAbsRadCorr* _ownedRadCorrEngine;
+  bool _alwaysRadCorr;
+  bool _neverRadCorr;
+
+  int _rejectFlag;
+
+  IncoherentMixing _incoherentMixing;
+
+  EvtGenContext(const EvtGenContext&);
+  EvtGenContext& operator=(const EvtGenContext&);
+
+};
+
+#endif
@@ -15,12 +15,14 @@
 // Modification history:
 //
 //    RYD     March 24, 1998         Module created
+//            Oct 2026               Added PhaseSpaceBatch and setBatchSize
 //
 //------------------------------------------------------------------------
 #ifndef EVTGENKINE_HH
 #define EVTGENKINE_HH
 
 class EvtVector4R;
+class EvtPhaseSpaceBatch;
 
 class EvtGenKine{
 
@@ -29,6 +31,22 @@ public:
 static double PhaseSpace( int ndaug, double mass[30],
 			  EvtVector4R p4[30], double mp );
 
+// Fills the batch with nEvents phase space configurations of the same
+// daughters, as nEvents calls of PhaseSpace would, but one step at a time
+// for all events of the batch. Returns the number of events filled.
+static int PhaseSpaceBatch( int ndaug, const double mass[], double mp,
+			    int nEvents, EvtPhaseSpaceBatch& batch );
+
+// With a batch size n > 1, PhaseSpace prefetches configurations with
+// PhaseSpaceBatch once it is called twice in a row with the same masses,
+// and hands them out until they are used up or the masses change. The
+// batches start at 4 configurations and double up to n while they are
+// used up. The configurations follow the same distribution, but use the
+// random numbers in a different order than without batching. 0, the
+// default, disables it. The size is kept per generator (EvtGenContext).
+static void setBatchSize(int n);
+static int getBatchSize();
+
 static double PhaseSpacePole(double M, double m1, double m2, double m3, 
 			     double a,EvtVector4R p4[10]);
 
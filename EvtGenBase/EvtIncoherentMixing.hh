@@ -63,16 +63,5 @@ public:
   static void enableFlip() ;
   static void disableFlip() ;
 
-protected:
-
-private:
-
-  static bool _doB0Mixing ;
-  static bool _doBsMixing ;
-  static double _dGammad ;
-  static double _deltamd ;
-  static double _dGammas ;
-  static double _deltams ;
-  static bool _enableFlip ;
 };
 #endif // EVTGENBASE_EVTINCOHERENTMIXING_HH
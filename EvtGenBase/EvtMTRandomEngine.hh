@@ -35,6 +35,8 @@ public:
 
     virtual double random();
 
+    virtual void randomArray(double* values, int n);
+
 private:
 
     std::mt19937 engine_;
@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    DJL/RYD     August 8, 1998         Module created
+//                Oct 2026               Keep the stored commands
 //
 //------------------------------------------------------------------------
 
@@ -24,6 +25,9 @@
 #include "EvtGenBase/EvtDecayBase.hh"
 #include "EvtGenBase/EvtStringHash.hh"
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 //#include <fstream.h>
 
 
@@ -37,7 +41,9 @@ public:
 
   static EvtModel& instance();
 
-  void registerModel(EvtDecayBase* prototype);
+  // The model list deletes the prototypes it owns with the context;
+  // the extra models handed to EvtGen are registered as not owned.
+  void registerModel(EvtDecayBase* prototype, bool owned = true);
       
   int isModel(std::string name);
 
@@ -46,24 +52,30 @@ public:
   int isCommand(std::string cmd);
   void storeCommand(std::string cmd,std::string cnfgstr);
 
+  // All commands passed to storeCommand, in order
+  const std::vector<std::pair<std::string,std::string> >& getStoredCommands() const {
+    return _storedCommands;
+  }
+
 
 private:
 
+  friend class EvtGenContext;
+
   EvtModel();
+  ~EvtModel();
 
-  static EvtModel* _instance;
+  EvtModel(const EvtModel&);
+  EvtModel& operator=(const EvtModel&);
 
   std::map<std::string,EvtDecayBase*> _modelNameHash;
   std::map<std::string,EvtDecayBase*> _commandNameHash;
 
+  std::vector<std::pair<std::string,std::string> > _storedCommands;
 
-};
+  std::vector<EvtDecayBase*> _ownedPrototypes;
 
-
-inline EvtModel& EvtModel::instance() {
-  if ( _instance == 0 )  _instance=new EvtModel;
-  return *_instance;
-}
+};
 
 
 #endif
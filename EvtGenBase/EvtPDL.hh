@@ -15,6 +15,8 @@
 // Modification history: 
 //
 // DJL/RYD September 25, 1996 Module created 
+//         Oct 2026           Keep the PDT entries and the changes made
+//                            to them, for EvtDecayTable::writeDecayImage
 //
 //------------------------------------------------------------------------
 
@@ -25,6 +27,7 @@
 #include "EvtGenBase/EvtId.hh"
 #include "EvtGenBase/EvtSpinType.hh"
 #include "EvtGenBase/EvtStringHash.hh"
+#include <string>
 #include <vector>
 #include <map>
 
@@ -79,10 +82,49 @@ public:
   static void changeLS(EvtId i, std::string &newLS );
   static void setPWForDecay(EvtId i, int spin, EvtId d1, EvtId d2);
   static void setPWForBirthL(EvtId i, int spin, EvtId par, EvtId othD);
+
+  // An "add" line of the PDT file
+  struct PdtEntry {
+    std::string name;
+    int stdhep;
+    double mass;
+    double width;
+    double maxWidth;
+    int chg3;
+    int spin2;
+    double ctau;
+    int lundkc;
+  };
+
+  // A call of one of the functions above which change the particle
+  // list after readPDT. Particles are given by their entry number.
+  struct Change {
+    enum Type {ALIAS, ALIASCHGCONJ, MASS, WIDTH, MASSMIN, MASSMAX, BLATT,
+	       BLATTBIRTH, BIRTHFACTOR, DECAYFACTOR, LINESHAPE, PWDECAY,
+	       PWBIRTH};
+    int type;
+    int entry[3];
+    int value;
+    double number;
+    std::string name;
+  };
+
+  // The entries read by readPDT and the changes made since, in order;
+  // adding the first and applying the second gives the same list again.
+  // Only the last change of each property of a particle is kept.
+  static const std::vector<PdtEntry>& getPdtEntries() {return pdtEntries();}
+  static const std::vector<Change>& getChanges() {return changes();}
+
+  static void addPdtEntry(const PdtEntry& pdtEntry);
+  static void applyChange(const Change& change);
+
 private:
 
   void setUpConstsPdt();
 
+  // Add a particle list entry to the StdHep and LundKC code indices
+  static void indexCodes(int entry);
+
   static unsigned int    _firstAlias;
   static int    _nentries;
 
@@ -92,6 +134,20 @@ private:
   }
 
   static std::map<std::string, int> _particleNameLookup;
+
+  static std::vector<PdtEntry>& pdtEntries() {
+    static std::vector<PdtEntry> s_pdtEntries;
+    return s_pdtEntries;
+  }
+
+  static std::vector<Change>& changes() {
+    static std::vector<Change> s_changes;
+    return s_changes;
+  }
+
+  static void addChange(int type, EvtId i, EvtId j=EvtId(-1,-1),
+			EvtId k=EvtId(-1,-1), int value=0, double number=0.0,
+			const std::string& name="");
   
 }; // EvtPDL.h
 
@@ -15,6 +15,12 @@
 // Modification history:
 //
 //    DJL/RYD     Sept. 25, 1996         Module created
+//                Oct 2026               Particles are allocated from the
+//                                       pool of the generator context
+//                Oct 2026               Spin densities returned by
+//                                       const reference
+//                Oct 2026               Cache of the lab frame momenta
+//                                       and vertices of a tree
 //
 //------------------------------------------------------------------------
 
@@ -27,6 +33,8 @@
 #include "EvtGenBase/EvtSpinDensity.hh"
 #include "EvtGenBase/EvtId.hh"
 #include "EvtGenBase/EvtSpinType.hh"
+#include <cstddef>
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <map>
@@ -56,6 +64,11 @@ public:
   */
   virtual ~EvtParticle();
 
+  // Particles of all types take their memory from the EvtParticlePool of
+  // the generator context bound to the calling thread.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* p);
+
   /**
   * Returns polarization vector in the parents restframe.
   */
@@ -218,6 +231,18 @@ public:
   */
   EvtVector4R get4Pos() const;
 
+  /**
+  * Computes the lab frame 4momenta and production vertices of this
+  * particle and all its descendants in one pass down the tree and caches
+  * them, so that getP4Lab() and get4Pos() return without walking up to
+  * the root. Any later change of a particle (momentum, lifetime or
+  * daughters) on the same thread drops all cached values. Only changes
+  * on the same thread do: once cached, the tree must not be changed on
+  * another thread unless that thread calls cacheLabKinematics again
+  * first (debug builds assert this).
+  */
+  void cacheLabKinematics();
+
   /**
   * Returns pointer to parent particle.
   */
@@ -227,7 +252,8 @@ public:
   * Makes partptr the idaug:th daugther.
   */ 
   void insertDaugPtr(int idaug,EvtParticle* partptr){ _daug[idaug]=partptr;
-                                                 partptr->_parent=this; }
+                                                 partptr->_parent=this;
+                                                 treeChanged(); }
   /**
   * Returns mass of particle.
   */
@@ -273,10 +299,12 @@ public:
   void setP4(const EvtVector4R& p4){
     _p=p4;
     _pBeforeFSR=p4;
+    treeChanged();
   }
 
   void setP4WithFSR(const EvtVector4R& p4){
     _p=p4;
+    treeChanged();
   }
 
   void setFSRP4toZero(){
@@ -292,7 +320,7 @@ public:
   * Returns number of daugthers.
   */ 
   size_t getNDaug() const;
-  void resetNDaug() {_ndaug=0; return;}
+  void resetNDaug() {_ndaug=0; treeChanged(); return;}
 
   /**
   * Prints out the particle "tree" of a given particle.  The
@@ -365,7 +393,7 @@ public:
   /**
   * Get forward spin density matrix.
   */
-  EvtSpinDensity getSpinDensityForward(){return _rhoForward;}
+  const EvtSpinDensity& getSpinDensityForward() const {return _rhoForward;}
 
   /**
   * Set backward spin density matrix.
@@ -375,7 +403,7 @@ public:
   /**
   * Get backward spin density matrix.
   */
-  EvtSpinDensity getSpinDensityBackward(){return _rhoBackward;}
+  const EvtSpinDensity& getSpinDensityBackward() const {return _rhoBackward;}
 
   //Hacks will be removed when better solutions are thought of!
   //This is used to suppress use of random numbers when doing initialization
@@ -390,7 +418,7 @@ public:
   double compMassProb();
 
   //setMass will blow away any existing 4vector
-  void setMass(double m) { _p=EvtVector4R(m,0.0,0.0,0.0);}
+  void setMass(double m) { _p=EvtVector4R(m,0.0,0.0,0.0); treeChanged();}
 
   //void setMixed() {_mix=true;}
   //void setUnMixed() {_mix=false;}
@@ -438,11 +466,13 @@ protected:
   void setp( double e, double px, double py, double pz) { 
     _p.set(e,px,py,pz); 
     _pBeforeFSR=_p;
+    treeChanged();
   }
 
   void setp( const EvtVector4R& p4 ) { 
     _p =p4; 
     _pBeforeFSR=_p;
+    treeChanged();
   }
 
   void setpart_num(EvtId particle_number ) { 
@@ -484,6 +514,15 @@ private:
 		 EvtSecondary& secondary,EvtId *stable_parent_ihep);
   void makeStdHepRec(int firstparent,int lastparent,EvtStdHep& stdhep);
 
+  // Lab frame values of cacheLabKinematics; valid while _labVersion is
+  // the tree version of the thread, which every change increments.
+  void treeChanged();
+  void cacheLabKinematicsRec(const double frame[4][4], const EvtVector4R& pos,
+			     uint64_t version);
+  EvtVector4R    _p4Lab;
+  EvtVector4R    _pos;
+  uint64_t       _labVersion;
+
 
   //This is a hack until things gets straightened out. (Ryd)
   int         _genlifetime;
@@ -15,6 +15,10 @@
 // Modification history:
 //
 //    DJL/RYD     August 11, 1998         Module created
+//                Oct 2026                Channels are picked from alias
+//                                        tables per threshold mass
+//                Oct 2026                Lazily initialised models are
+//                                        initialised when picked
 //
 //------------------------------------------------------------------------
 
@@ -23,6 +27,10 @@
 
 #include "EvtGenBase/EvtParticleDecay.hh"
 
+#include <vector>
+
+class EvtAliasTable;
+
 typedef EvtParticleDecay* EvtParticleDecayPtr;
 
 class EvtParticleDecayList{
@@ -33,6 +41,7 @@ public:
    _decaylist=0;
     _nmode=0;
     _rawbrfrsum=0;
+    _channelTablesBuilt=false;
   }
 
   EvtParticleDecayList(const EvtParticleDecayList &o);
@@ -45,6 +54,8 @@ public:
 
   void setNMode(int nmode);
 
+  // Picks the channel of p (unless it already has one) and returns its
+  // model, which is initialised first if that was deferred.
   EvtDecayBase* getDecayModel(EvtParticle *p);
   EvtDecayBase* getDecayModel(int imode);
 
@@ -72,11 +83,26 @@ public:
 
 private:
 
+  EvtDecayBase* pickDecayModel(EvtParticle *p);
+
+  // The channels are picked from Walker alias tables, one for each set of
+  // kinematically open channels: the distinct minimum masses of the
+  // channels split the parent mass range into intervals in which this
+  // set does not change. The tables are made when first needed and
+  // thrown away whenever the modes change.
+  const EvtAliasTable* getChannelTable(EvtParticle* p);
+  void clearChannelTables();
+
   EvtParticleDecayPtr* _decaylist;
 
   double _rawbrfrsum;
   int _nmode;
 
+  bool _channelTablesBuilt;
+  std::vector<double> _thresholds;
+  std::vector<int> _channelThreshold;
+  std::vector<EvtAliasTable*> _channelTables;
+
 };
 
 #endif
@@ -0,0 +1,118 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtParticlePool.hh
+//
+// Description: Memory pool for EvtParticle objects. EvtParticle's own
+//              operator new and delete take the memory from the pool of
+//              the generator context bound to the calling thread, so that
+//              building and deleting decay trees (including the trees
+//              thrown away on every accept/reject retry) reuses the same
+//              few blocks instead of going through the heap.
+//
+//              Memory is taken from the heap in large chunks and split
+//              into blocks of a fixed size per size class; freed blocks go
+//              onto a free list of their class and are handed out again
+//              first. The pool belongs to the thread which last allocated
+//              from it; only one thread may allocate from a pool at a
+//              time. Blocks freed on another thread (e.g. trees made by a
+//              worker generator and deleted by the caller of
+//              EvtGen::generateDecays) are passed back through a lock-free
+//              list and reused by the owner.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTPARTICLEPOOL_HH
+#define EVTPARTICLEPOOL_HH
+
+#include <cstddef>
+#include <vector>
+
+#ifdef EVTGEN_CPP11
+#include <atomic>
+#include <thread>
+#endif
+
+class EvtParticlePool {
+
+public:
+
+  EvtParticlePool();
+
+  // Give a block of at least size bytes, owned by this pool.
+  void* allocate(std::size_t size);
+
+  // Give a block back to the pool which handed it out.
+  static void release(void* block);
+
+  // Called instead of the destructor by the owner of the pool. If blocks
+  // are still in use (particles kept beyond the lifetime of the generator
+  // which made them) the pool is kept until the last of them is released.
+  void destroy();
+
+  // Number of blocks handed out by allocate and not yet released
+  long getBlocksInUse() const {return _inUse+_remoteBalance;}
+
+  // Memory taken from the heap, in bytes
+  std::size_t getReserved() const {return _chunks.size()*chunkSize;}
+
+private:
+
+  ~EvtParticlePool();
+
+  EvtParticlePool(const EvtParticlePool&);
+  EvtParticlePool& operator=(const EvtParticlePool&);
+
+  // Each block starts with a header which remembers its pool and class;
+  // free blocks keep the link to the next free block after the header.
+  struct Header {
+    EvtParticlePool* pool;
+    int sizeClass;
+  };
+
+  static const std::size_t headerSize = 16;
+  static const std::size_t granularity = 16;
+  static const int nSizeClasses = 512;
+  static const std::size_t chunkSize = 262144;
+
+  static void*& next(void* block) {
+    return *reinterpret_cast<void**>(static_cast<char*>(block)+headerSize);
+  }
+
+  void* newBlock(int sizeClass);
+  void collectRemote();
+  void freeLocal(void* block);
+  void releaseRemote(void* block);
+
+  std::vector<void*> _freeLists;
+  std::vector<char*> _chunks;
+  std::size_t _chunkUsed;
+
+  // Blocks allocated less those released on the owning thread
+  long _inUse;
+
+  // Less the number of blocks released on other threads; destroy adds
+  // _inUse, after which the release bringing it to zero deletes the pool.
+#ifdef EVTGEN_CPP11
+  std::atomic<long> _remoteBalance;
+  std::atomic<bool> _destroyed;
+  std::atomic<std::thread::id> _owner;
+  std::atomic<void*> _remoteFree;
+#else
+  long _remoteBalance;
+  bool _destroyed;
+  void* _remoteFree;
+#endif
+
+};
+
+#endif
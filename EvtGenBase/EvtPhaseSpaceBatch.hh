@@ -0,0 +1,89 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtPhaseSpaceBatch.hh
+//
+// Description: A batch of N body phase space configurations, filled by
+//              EvtGenKine::PhaseSpaceBatch. The four vectors are stored as
+//              structure of arrays: for each daughter one array per
+//              component, indexed by the event in the batch, so that the
+//              generation and any user of the whole batch run over
+//              contiguous memory.
+//
+//              The batch also remembers the kinematics (daughter masses
+//              and parent mass) it was generated for and a read position,
+//              which lets EvtGenKine::PhaseSpace hand out prefetched
+//              configurations one at a time while the same kinematics are
+//              asked for again, as in the accept/reject loops of the models.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTPHASESPACEBATCH_HH
+#define EVTPHASESPACEBATCH_HH
+
+#include <vector>
+
+class EvtVector4R;
+
+class EvtPhaseSpaceBatch {
+
+public:
+
+  EvtPhaseSpaceBatch();
+
+  // Room for nEvents configurations of nDaug daughters; the contents are
+  // undefined until filled and the read position is reset.
+  void resize(int nDaug, int nEvents);
+
+  int getNDaug() const {return _nDaug;}
+  int size() const {return _size;}
+
+  // The components of daughter daug for all events of the batch
+  double* e(int daug) {return &_e[daug*_size];}
+  double* px(int daug) {return &_px[daug*_size];}
+  double* py(int daug) {return &_py[daug*_size];}
+  double* pz(int daug) {return &_pz[daug*_size];}
+  const double* e(int daug) const {return &_e[daug*_size];}
+  const double* px(int daug) const {return &_px[daug*_size];}
+  const double* py(int daug) const {return &_py[daug*_size];}
+  const double* pz(int daug) const {return &_pz[daug*_size];}
+
+  EvtVector4R getP4(int daug, int event) const;
+
+  // The kinematics the batch is used for. Setting them drops the events.
+  void setKinematics(int nDaug, const double mass[], double mp);
+  bool matches(int nDaug, const double mass[], double mp) const;
+
+  // The four vectors of the next unused event; false if all are used
+  bool next(EvtVector4R p4[]);
+  int remaining() const {return _size-_position;}
+
+  // Drop the events and the kinematics
+  void clear();
+
+private:
+
+  int _nDaug;
+  int _size;
+  int _position;
+
+  std::vector<double> _e;
+  std::vector<double> _px;
+  std::vector<double> _py;
+  std::vector<double> _pz;
+
+  std::vector<double> _mass;
+  double _mp;
+
+};
+
+#endif
@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtProbMaxCache.hh
+//
+// Description: Maximum probabilities learned by the decay models (see
+//              EvtDecayBase::getProbMax), keyed by model, parent,
+//              daughters and arguments (EvtDecayBase::getProbMaxKey).
+//              The values can be written to a file at the end of a job
+//              and read by the next one, whose models then start from
+//              the stored maximum instead of the warm-up over the first
+//              decays. The file has one decay per line: the maximum
+//              followed by the key; lines starting with # are comments.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTPROBMAXCACHE_HH
+#define EVTPROBMAXCACHE_HH
+
+#include <map>
+#include <string>
+
+class EvtDecayTable;
+
+class EvtProbMaxCache {
+
+public:
+
+  EvtProbMaxCache() {}
+
+  // Add the entries of a file, keeping the larger value for keys which
+  // are already known. Returns false if the file can not be read.
+  bool read(const std::string& fileName);
+
+  // Replaces the file in one step (see EvtFileReplacer). Returns false
+  // if the file can not be written.
+  bool write(const std::string& fileName) const;
+
+  // Add the maxima learned by the models of a decay table.
+  void collect(EvtDecayTable* decayTable);
+
+  // Keeps the larger of the stored and the given value.
+  void merge(const std::string& key, double probMax);
+  void merge(const EvtProbMaxCache& other);
+
+  bool get(const std::string& key, double& probMax) const;
+
+  bool empty() const {return _probMax.empty();}
+  int size() const {return _probMax.size();}
+  void clear() {_probMax.clear();}
+
+private:
+
+  std::map<std::string, double> _probMax;
+
+};
+
+#endif
@@ -35,7 +35,8 @@ public:
   
   //This class does not take ownership of the fsr engine;
   //the caller needs to make sure that the engine is not
-  //destroyed.
+  //destroyed. The engine and the flags below belong to the
+  //generator context bound to the calling thread (see EvtGenContext).
   static void setRadCorrEngine(EvtAbsRadCorr* fsrEngine);
   static bool alwaysRadCorr();
   static bool neverRadCorr();
@@ -43,11 +44,6 @@ public:
   static void setNeverRadCorr();
   static void setNormalRadCorr();
 
-private:
-
-  static EvtAbsRadCorr* _fsrEngine;
-  static bool _alwaysRadCorr;
-  static bool _neverRadCorr;
 };
 
 #endif
@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    RYD     March 24, 1998         Module created
+//            Oct 2026               Added setBufferSize
 //
 //------------------------------------------------------------------------
 
@@ -39,12 +40,14 @@ public:
   
   //This class does not take ownership of the random engine;
   //the caller needs to make sure that the engine is not
-  //destroyed.
+  //destroyed. The engine is set for the generator context
+  //bound to the calling thread (see EvtGenContext).
   static void setRandomEngine(EvtRandomEngine* randomEngine);
 
-private:
-
-  static EvtRandomEngine* _randomEngine;
+  //Take the random numbers from the engine n at a time instead of
+  //one by one, for the context bound to the calling thread. The numbers
+  //are the same either way; 0 (the default) turns the buffering off.
+  static void setBufferSize(int n);
 
 };
 
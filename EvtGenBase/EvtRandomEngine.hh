@@ -18,12 +18,17 @@
 //
 //    RYD     December 25, 1999         Module created
 //    RYD     October 2, 2006           Converted to a pure interface class 
+//            Oct 2026                  Added setStream for engines with
+//                                      independent per-event streams
+//            Oct 2026                  Added randomArray for bulk generation
 //
 //------------------------------------------------------------------------
 
 #ifndef EVTRANDOMENGINE_HH
 #define EVTRANDOMENGINE_HH
 
+#include <stdint.h>
+
 class EvtRandomEngine{
 
 public:
@@ -32,6 +37,18 @@ public:
 
   virtual double random()=0;
 
+  // Fill values with the next n numbers of the sequence, in the order in
+  // which random() would return them. Engines override this when they can
+  // generate a block faster than one number at a time.
+  virtual void randomArray(double* values, int n) {
+    for (int i=0; i<n; i++) values[i] = random();
+  }
+
+  // Engines which can give each (run, event) pair an independent stream,
+  // e.g. counter-based ones, move to the start of that stream and return
+  // true. Sequential engines ignore the call and return false.
+  virtual bool setStream(uint32_t /*run*/, uint64_t /*event*/) {return false;}
+
 private:
 
 };
@@ -0,0 +1,37 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtReportUtils.hh
+//
+// Description: Helpers shared by the run reports (EvtStartupProfile,
+//              EvtDecayStats) and the benchmarks: a wall clock for the
+//              timings and the quoting of strings in the JSON output.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTREPORTUTILS_HH
+#define EVTREPORTUTILS_HH
+
+#include <string>
+
+namespace EvtReportUtils {
+
+  // Seconds from an arbitrary start, on a clock which never goes back
+  double wallTime();
+
+  // text as a quoted JSON string, with quotes, backslashes and control
+  // characters escaped
+  std::string jsonString(const std::string& text);
+
+}
+
+#endif
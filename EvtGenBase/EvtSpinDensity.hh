@@ -11,42 +11,65 @@
 // Module: EvtGen/EvtSpinDensity.hh
 //
 // Description: This class holds a spin density matrix, it is
-//              a complex nxn matrix.
+//              a complex nxn matrix. Matrices of up to inlineDim states
+//              (spin 3/2) are stored inline, so that copying them never
+//              allocates memory; larger ones, up to maxDim states (spin 4),
+//              are kept on the heap.
 //
 // Modification history:
 //
 //    RYD     May 29, 1997         Module created
+//            Oct 2026             Inline storage
 //
 //------------------------------------------------------------------------
 
 #ifndef EVTSPINDENSITY_HH
 #define EVTSPINDENSITY_HH
 #include "EvtGenBase/EvtComplex.hh"
+#include <assert.h>
 
 
 class EvtSpinDensity {
 
 public:
 
+  // Number of states of the highest spin supported (EvtSpinType::SPIN4)
+  static const int maxDim = 9;
+
+  // Number of states of the largest matrix stored inline
+  static const int inlineDim = 4;
+
   EvtSpinDensity(const EvtSpinDensity& density);
   EvtSpinDensity& operator=(const EvtSpinDensity& density);
   virtual ~EvtSpinDensity();
 
   EvtSpinDensity();
   void setDim(int n);
-  int getDim() const;
-  void set(int i,int j,const EvtComplex& rhoij);
-  const EvtComplex& get(int i,int j) const;
-  double normalizedProb(const EvtSpinDensity& d);
+  int getDim() const {return dim;}
+  void set(int i,int j,const EvtComplex& rhoij) {
+    assert(i<dim&&j<dim);
+    rho[i*dim+j]=rhoij;
+  }
+  const EvtComplex& get(int i,int j) const {
+    assert(i<dim&&j<dim);
+    return rho[i*dim+j];
+  }
+  double normalizedProb(const EvtSpinDensity& d) const;
   friend std::ostream& operator<<(std::ostream& s,const EvtSpinDensity& d);
   void setDiag(int n);
 
-  int check();
+  int check() const;
 
 private:
 
-  EvtComplexPtrPtr rho;
+  // The elements, row by row; points to inlineRho or to overflowRho
+  EvtComplex* rho;
   int dim;
+  EvtComplex inlineRho[inlineDim*inlineDim];
+  EvtComplex* overflowRho;
+  int overflowSize;
+
+  void resize(int n);
 };
 
 #endif
@@ -0,0 +1,115 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtStartupProfile.hh
+//
+// Description: Wall time and heap growth of the phases of setting up a
+//              generator: the model registration, reading the PDT,
+//              tokenising the decay files, constructing the models and
+//              their init() and initProbMax(). A Phase object measures the
+//              code between its construction and destruction and adds it
+//              to the profile of the context bound to the thread.
+//
+//              Repeated phases with the same name and detail (e.g. the init
+//              of all decays of one model) are summed into one entry, which
+//              also remembers its slowest single call. Nested phases are
+//              kept with their depth, so the time of a phase includes that
+//              of the phases within it.
+//
+//              Profiling is off by default and has to be switched on with
+//              setEnabled before the EvtGen constructor runs. The switch
+//              is kept per generator (EvtGenContext): a generator takes it
+//              over from the thread that constructs it and passes it on
+//              to its workers. The heap is
+//              measured with mallinfo where the C library provides it;
+//              elsewhere heapAvailable() is false and the sizes are 0.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTSTARTUPPROFILE_HH
+#define EVTSTARTUPPROFILE_HH
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+class EvtStartupProfile {
+
+public:
+
+  EvtStartupProfile() : _depth(0) {}
+
+  static void setEnabled(bool enabled);
+  static bool isEnabled();
+
+  // True if the heap growth is measured on this platform
+  static bool heapAvailable();
+
+  struct Entry {
+    std::string phase;
+    std::string detail;
+    int depth;
+    long calls;
+    double seconds;
+    long long heapBytes;
+    double maxSeconds;
+    std::string slowest;
+  };
+
+  class Phase {
+  public:
+    Phase(const char* phase, const std::string& detail="");
+    ~Phase();
+
+    // Whether this phase is measured at all
+    bool active() const {return _profile!=0;}
+
+    // Names the call, e.g. the decay of a model init, in case it turns
+    // out to be the slowest of its entry.
+    void setLabel(const std::string& label) {_label=label;}
+
+  private:
+    EvtStartupProfile* _profile;
+    const char* _phase;
+    std::string _detail;
+    std::string _label;
+    double _start;
+    long long _heap;
+    std::size_t _firstEntry;
+    Phase(const Phase&);
+    Phase& operator=(const Phase&);
+  };
+
+  const std::vector<Entry>& getEntries() const {return _entries;}
+  void clear() {_entries.clear(); _index.clear(); _depth=0;}
+
+  // A table of the entries in the order in which they were first seen
+  void print(std::ostream& output) const;
+
+  void writeJSON(std::ostream& output) const;
+  bool writeJSON(const std::string& fileName) const;
+
+private:
+
+  void add(const char* phase, const std::string& detail, int depth,
+	   std::size_t position, double seconds, long long heapBytes,
+	   const std::string& label);
+
+  std::vector<Entry> _entries;
+  std::map<std::string,std::size_t> _index;
+  int _depth;
+
+};
+
+#endif
@@ -30,6 +30,7 @@
 #ifndef EVTSTATUS_HH
 #define EVTSTATUS_HH
 
+#include "EvtGenBase/EvtGenContext.hh"
 
 class EvtStatus{
 
@@ -38,7 +39,7 @@ public:
 
   static void setRejectFlag() {int *temp=rejectFlag();  *temp=1; return;}
   static void initRejectFlag() {int *temp=rejectFlag();  *temp=0; return;}
-  static int* rejectFlag() {static int rejectEvent=0; return &rejectEvent;}
+  static int* rejectFlag() {return EvtGenContext::current()->rejectFlag();}
   static int getRejectFlag() {int *temp=rejectFlag(); return *temp;}
   
 };
@@ -0,0 +1,103 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenBase/EvtTaskPool.hh
+//
+// Description: Runs the tasks 0..nTasks-1 on a set of worker threads with
+//              work stealing. The tasks are dealt out in chunks, round
+//              robin, to one queue per worker; a worker takes the lowest
+//              chunk from its own queue and, once that is empty, steals
+//              the highest chunk from another worker. Tasks with very
+//              different costs (e.g. decays with many accept/reject
+//              retries) therefore stay balanced, while all workers move
+//              through the task numbers at a similar pace.
+//
+//              Threads need c++11 (EVTGEN_CPP11); without it all tasks
+//              run on the calling thread in wait().
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTTASKPOOL_HH
+#define EVTTASKPOOL_HH
+
+#include <vector>
+#include <deque>
+
+#ifdef EVTGEN_CPP11
+#include <mutex>
+#include <thread>
+#endif
+
+class EvtTaskPool {
+
+public:
+
+  class Task {
+  public:
+    virtual ~Task() {}
+    // Called once for each task number, on worker iWorker.
+    virtual void run(int iTask, int iWorker)=0;
+  };
+
+  EvtTaskPool(int nWorkers);
+  ~EvtTaskPool();
+
+  int getNWorkers() const {return _nWorkers;}
+
+  // Start the workers and return; chunkSize <= 0 picks a chunk size
+  // from the number of tasks and workers.
+  void start(Task& task, int nTasks, int chunkSize=0);
+
+  // Wait until all tasks of the last start() have run.
+  void wait();
+
+  // start() followed by wait().
+  void run(Task& task, int nTasks, int chunkSize=0);
+
+  // Number of concurrent threads supported by the machine (at least 1).
+  static int hardwareThreads();
+
+  // Number of threads the models use for their tabulations at
+  // initialisation (e.g. the probMax scan of EvtDalitzTable); all cores
+  // (hardwareThreads) by default, or at most n after setInitThreads(n)
+  // with n > 0. Has to be set before the decay files are read.
+  static void setInitThreads(int n);
+  static int getInitThreads();
+
+private:
+
+  EvtTaskPool(const EvtTaskPool&);
+  EvtTaskPool& operator=(const EvtTaskPool&);
+
+  struct Chunk {
+    int first;
+    int last;
+  };
+
+  bool nextChunk(int iWorker, Chunk& chunk);
+  void work(int iWorker);
+
+  static int& initThreads();
+
+  int _nWorkers;
+  Task* _task;
+
+  std::vector< std::deque<Chunk> > _queues;
+
+#ifdef EVTGEN_CPP11
+  std::vector<std::mutex*> _queueLocks;
+  std::vector<std::thread> _threads;
+#endif
+
+};
+
+#endif
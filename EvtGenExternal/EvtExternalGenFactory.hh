@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    John Back       April 2011            Module created
+//                    Oct 2026              Serialise the engine decays
 //
 //------------------------------------------------------------------------------
 //
@@ -36,6 +37,11 @@ public:
 
   EvtAbsExternalGen* getGenerator(int genId = 0);
 
+  // Decay with one of the engines. The engines are shared by all
+  // generators of the process, including the workers of
+  // EvtGen::setWorkers, so their decays are made one at a time.
+  static bool doDecay(EvtAbsExternalGen* engine, EvtParticle* theMother);
+
   void initialiseAllGenerators();
 
   void definePythiaGenerator(std::string xmlDir, bool convertPhysCodes, bool useEvtGenRandom = true);
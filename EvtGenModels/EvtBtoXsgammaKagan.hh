@@ -17,6 +17,8 @@
 // Modification history:
 //
 //       Jane Tinslay, Francesca Di Lodovico     March 27, 2001  Module created
+//       Oct 2026  Spectra computed in parallel and cached; members
+//                 replace the static spectrum state
 //
 //------------------------------------------------------------------------
 
@@ -24,13 +26,14 @@
 #define EVTBTOXSGAMMAKAGAN_HH
 
 #include <vector>
+#include <string>
 #include "EvtGenModels/EvtBtoXsgammaAbsModel.hh"
 
 class EvtBtoXsgammaKagan : public EvtBtoXsgammaAbsModel {
 
 public:
   
-  EvtBtoXsgammaKagan() {}
+  EvtBtoXsgammaKagan() : _boxHeight(0.), _bbprod(false) {}
 
   virtual ~EvtBtoXsgammaKagan();
 
@@ -48,6 +51,12 @@ public:
   void CalcDelta();
   double Fz(double);
 
+  // Text file in which computed hadronic mass spectra are kept, keyed
+  // by the model arguments, so that later jobs read them instead of
+  // integrating again. Empty (the default) keeps them in memory only.
+  // Has to be set before the decay file is read.
+  static void setSpectrumCacheFile(const std::string& fileName);
+
 private:
 
   //Input parameters
@@ -96,8 +105,6 @@ private:
   double _alphasmubar;
   double _etamu;
 
-  std::vector<double> _mHVect;
-
   static double ReG(double);
   static double ImG(double);
   static double s77(double);
@@ -114,15 +121,24 @@ private:
   static double s22FermiFunc(double, std::vector<double> &coeffs);
   static double s27FermiFunc(double, std::vector<double> &coeffs);
   static double s28FermiFunc(double, std::vector<double> &coeffs);
-  static double GetArrayVal(double, double, double, double, std::vector<double>);
+  static double GetArrayVal(double, double, double, double, const std::vector<double> &array);
   static double sFermiFunc(double, const std::vector<double> &coeffs1, const std::vector<double> &coeffs2, 
 			   const std::vector<double> &coeffs3, const std::vector<double> &coeffs4);
   static double FermiFunc(double, const std::vector<double> &coeffs);
   static double diLogFunc(double);
   static double diLogMathematica(double);
-  double *massHad; double *brHad;
-  static double intervalMH;
-  static bool bbprod;
+
+  bool readSpectrum(const std::vector<double> &key);
+  void writeSpectrum(const std::vector<double> &key) const;
+  static std::string& spectrumCacheFile();
+
+  class SCoeffTask;
+  class HadronicMassTask;
+
+  std::vector<double> _massHad;
+  std::vector<double> _brHad;
+  double _boxHeight;
+  bool _bbprod;
 };
 
 #endif
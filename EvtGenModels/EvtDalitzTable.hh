@@ -15,6 +15,8 @@
 // Modification history:
 //
 //    DCC     16 December, 2011         Module created
+//            Oct 2026                  Parallel probMax scan with a
+//                                      cache of its results
 //
 //------------------------------------------------------------------------
 
@@ -47,6 +49,12 @@ public:
 
   std::vector<EvtDalitzDecayInfo> getDalitzTable(const EvtId& parent);
 
+  // File which keeps the probMax values estimated for decays without a
+  // probMax attribute, keyed by a hash of the resonance list and the
+  // masses. Decays found there skip the scan; new results are added to
+  // the file. Has to be set before the XML files are read.
+  static void setProbMaxCacheFile(const std::string& fileName);
+
 protected:
 
   EvtDalitzTable();
@@ -66,8 +74,11 @@ private:
   EvtDalitzTable& operator=(const EvtDalitzTable&);
 
   //to calculate probMax
+  double findProbMax(const std::string& decay, const std::string& scanKey,
+                     EvtDalitzPlot dp, EvtDalitzDecayInfo* model);
   double calcProbMax(EvtDalitzPlot dp, EvtDalitzDecayInfo* model);
-  double calcProb(EvtDalitzPoint point, EvtDalitzDecayInfo* model);
+
+  static std::string& probMaxCacheFile();
 };
 
 #endif
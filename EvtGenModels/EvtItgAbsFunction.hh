@@ -19,6 +19,7 @@
 //
 //    Jane Tinslay                March 21, 2001       Module adapted for use in 
 //                                                     EvtGen
+//                                Oct 2026             Added values()
 //
 //------------------------------------------------------------------------
 
@@ -45,6 +46,10 @@ public:
   virtual double value( double x) const;
 
   virtual double operator()(double x) const;
+
+  // The function at the n points x, for integrators which need several
+  // values at once. Override to evaluate them together.
+  virtual void values(int n, const double x[], double f[]) const;
   
   // Selectors (const)
   
@@ -18,6 +18,7 @@
 //
 //    Jane Tinslay                March 21, 2001       Module adapted for use in 
 //                                                     EvtGen
+//                                Oct 2026             Added myFunctionValues()
 //
 //------------------------------------------------------------------------
 
@@ -47,6 +48,7 @@ protected:
   virtual double evaluateIt(double lower, double higher) const=0;
   
   double myFunction(double x) const {return _myFunction(x);}
+  void myFunctionValues(int n, const double x[], double f[]) const {_myFunction.values(n,x,f);}
  
 private:
   
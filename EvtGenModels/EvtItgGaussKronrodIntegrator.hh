@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------
+//
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Module: EvtItgGaussKronrodIntegrator.hh
+//
+// Description:
+//      Globally adaptive Gauss-Kronrod integrator: each interval is
+//      integrated with the 15 point Kronrod rule, and the difference
+//      to the embedded 7 point Gauss rule estimates its error (as in
+//      QUADPACK's QAG). The interval with the largest error is bisected
+//      until the total error is below the relative precision.
+//
+//      The 15 abscissae of an interval are passed to the function in one
+//      call of EvtItgAbsFunction::values. The intervals are kept in
+//      fixed size arrays, so an integration does not allocate, and one
+//      integrator can be used for any number of integrals of its
+//      function, e.g. after changing the coefficients of the function.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+#ifndef EVTITGGAUSSKRONRODINTEGRATOR_HH
+#define EVTITGGAUSSKRONRODINTEGRATOR_HH
+
+#include "EvtGenModels/EvtItgAbsIntegrator.hh"
+
+class EvtItgGaussKronrodIntegrator: public EvtItgAbsIntegrator {
+
+public:
+
+  // At most maxIntervals (and at most maxIntervalsLimit) intervals
+  EvtItgGaussKronrodIntegrator(const EvtItgAbsFunction &, double precision=1.0e-5, int maxIntervals=50);
+  virtual ~EvtItgGaussKronrodIntegrator( );
+
+  enum { maxIntervalsLimit=200 };
+
+protected:
+
+  virtual double evaluateIt(double , double) const;
+
+private:
+
+  // Kronrod and Gauss estimates of the integral from lower to upper
+  void rule(double lower, double upper, double &result, double &error) const;
+
+  double _precision;
+  int _maxIntervals;
+
+  EvtItgGaussKronrodIntegrator();
+  EvtItgGaussKronrodIntegrator( const EvtItgGaussKronrodIntegrator& );                //// Copy Constructor
+  EvtItgGaussKronrodIntegrator& operator= ( const EvtItgGaussKronrodIntegrator& );    // Assignment op
+
+};
+
+#endif // EVTITGGAUSSKRONRODINTEGRATOR_HH
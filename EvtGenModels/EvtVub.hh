@@ -17,6 +17,7 @@
 // Modification history:
 //
 //   Sven Menke     January 17, 2001         Module created
+//                  Oct 2026                 Weights in an EvtVubBinnedWeights
 //
 //------------------------------------------------------------------------
 
@@ -24,6 +25,7 @@
 #define EVTVUB_HH
 
 #include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenModels/EvtVubBinnedWeights.hh"
 
 #include <vector>
 
@@ -34,7 +36,7 @@ class EvtVub:public  EvtDecayIncoherent  {
 
 public:
   
-  EvtVub() : _masses(0) , _weights(0) , _dGamma(0) {}
+  EvtVub() : _dGamma(0) {}
   virtual ~EvtVub();
 
   std::string getName();
@@ -55,8 +57,8 @@ private:
   double _dGMax;  // max dGamma*p2 value;
   int    _nbins;
   int    _storeQplus;
-  double * _masses;
-  double * _weights;
+  std::vector<double> _masses;
+  EvtVubBinnedWeights _weights; // in bins of the hadronic mass
 
   EvtVubdGamma *_dGamma; // calculates the decay rate
   double findPFermi();
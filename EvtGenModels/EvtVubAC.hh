@@ -45,7 +45,19 @@ private:
 
   double beta0;
   
-  std::vector<double> gvars;
+  double LambdaQCD2;
+
+  // With a tolerance (optional second argument) the rate is interpolated
+  // in a table filled at init. Cells at the singular edges u = 1 and
+  // w = 0, and cells where the interpolation misses the exact rate by
+  // more than the tolerance at the centre, a face centre or near a
+  // corner of the cell, are evaluated exactly.
+  double tolerance;
+  std::vector<double> rateTable;
+  std::vector<char> exactCell;
+
+  void fillRateTable();
+  double interpolatedRate(double u, double w, double xb);
 
   double rate(double u, double w, double xb);
   double wreg(double w);
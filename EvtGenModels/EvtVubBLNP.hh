@@ -16,14 +16,17 @@
 
 #include <vector>
 #include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenModels/EvtVubIntegralGrid.hh"
 
 class EvtParticle;
+class EvtItgPtrFunction;
+class EvtItgAbsIntegrator;
 
 class EvtVubBLNP:public  EvtDecayIncoherent  {
 
 public:
   
-  EvtVubBLNP() {}
+  EvtVubBLNP();
   virtual ~EvtVubBLNP();
 
   std::string getName();
@@ -90,12 +93,32 @@ private:
   int flagpower;
   int flag2loop;
 
-  int maxLoop;
   double precision;
 
+  // The functions and integrators of DoneJS, Done1, Done2 and Done3, made
+  // once in init and used for every integral with new Pp and Pm
+  EvtItgPtrFunction *_funcJS, *_func1, *_func2, *_func3;
+  EvtItgAbsIntegrator *_integJS, *_integ1, *_integ2, *_integ3;
+  double Done(EvtItgPtrFunction *func, const EvtItgAbsIntegrator *integ, double Pp, double Pm);
+  void deleteIntegrators();
+
+  // The Done integrals as functions of u = Pp/mBB and v = y, tabulated if
+  // EvtVubIntegralGrid has a tolerance; shared with the other decays
+  // using the same arguments
+  class GridFunction : public EvtVubIntegralGrid::Function {
+  public:
+    GridFunction(EvtVubBLNP &model) : _model(model) {}
+    void values(double u, double v, double f[]) const;
+    double rate(double u, double v, double w, const double f[]) const;
+  private:
+    EvtVubBLNP &_model;
+  };
+  const EvtVubIntegralGrid *_grid;
+
   std::vector<double> gvars;
   
   double rate3(double Pp, double Pl, double Pm);
+  double rate3(double Pp, double Pl, double Pm, const double done[]);
   double F1(double Pp, double Pm, double muh, double mui, double mubar, double doneJS, double done1);
   double F2(double Pp, double Pm, double muh, double mui, double mubar, double done3);
   double F3(double Pp, double Pm, double muh, double mui, double mubar, double done2);
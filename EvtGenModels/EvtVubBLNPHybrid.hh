@@ -28,8 +28,12 @@
 
 #include <vector>
 #include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenModels/EvtVubIntegralGrid.hh"
+#include "EvtGenModels/EvtVubBinnedWeights.hh"
 
 class EvtParticle;
+class EvtItgPtrFunction;
+class EvtItgAbsIntegrator;
 
 class EvtVubBLNPHybrid:public  EvtDecayIncoherent  {
 
@@ -62,10 +66,7 @@ private:
   int    _nbins_El;
   int    _nbins;
   double _masscut;
-  double * _bins_mX;
-  double * _bins_q2;
-  double * _bins_El;
-  double * _weights;
+  EvtVubBinnedWeights _weights; // in bins of mX, q2 and El
   
   // Input parameters
   double mBB;
@@ -119,12 +120,32 @@ private:
   int flagpower;
   int flag2loop;
 
-  int maxLoop;
   double precision;
 
+  // The functions and integrators of DoneJS, Done1, Done2 and Done3, made
+  // once in init and used for every integral with new Pp and Pm
+  EvtItgPtrFunction *_funcJS, *_func1, *_func2, *_func3;
+  EvtItgAbsIntegrator *_integJS, *_integ1, *_integ2, *_integ3;
+  double Done(EvtItgPtrFunction *func, const EvtItgAbsIntegrator *integ, double Pp, double Pm);
+  void deleteIntegrators();
+
+  // The Done integrals as functions of u = Pp/mBB and v = y, tabulated if
+  // EvtVubIntegralGrid has a tolerance; shared with the other decays
+  // using the same arguments
+  class GridFunction : public EvtVubIntegralGrid::Function {
+  public:
+    GridFunction(EvtVubBLNPHybrid &model) : _model(model) {}
+    void values(double u, double v, double f[]) const;
+    double rate(double u, double v, double w, const double f[]) const;
+  private:
+    EvtVubBLNPHybrid &_model;
+  };
+  const EvtVubIntegralGrid *_grid;
+
   std::vector<double> gvars;
   
   double rate3(double Pp, double Pl, double Pm);
+  double rate3(double Pp, double Pl, double Pm, const double done[]);
   double F1(double Pp, double Pm, double muh, double mui, double mubar, double doneJS, double done1);
   double F2(double Pp, double Pm, double muh, double mui, double mubar, double done3);
   double F3(double Pp, double Pm, double muh, double mui, double mubar, double done2);
@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenModels/EvtVubBinnedWeights.hh
+//
+// Description: Table of weights in bins of one or more kinematic
+//              variables, used by the inclusive B -> Xu l nu models
+//              (EvtVub, EvtVubNLO, EvtVubHybrid, EvtVubBLNPHybrid) to
+//              reweight the generated events.
+//
+//              Each axis is given by the lower edges of its bins; the
+//              last bin of an axis is open ended, and points below the
+//              first edge are in no bin. Bins include their lower edge
+//              ([e_i,e_i+1), as in the hybrid models) or their upper edge
+//              ((e_i,e_i+1], as in the mass reweighting of EvtVub).
+//
+//              The range of the edges is divided into equal cells that
+//              store the bin at their lower end; a bin is found by
+//              bisecting the edges between the bins of the cell and of
+//              the next one, which takes constant time for evenly spread
+//              edges and logarithmic time in the number of edges of the
+//              cell otherwise. Axes whose edges are not in ascending order
+//              are searched linearly. At setup the lookup is checked
+//              against the linear search at and around every edge.
+//
+//              The weights are stored in one array, with the first axis
+//              varying fastest.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTVUBBINNEDWEIGHTS_HH
+#define EVTVUBBINNEDWEIGHTS_HH
+
+#include <vector>
+
+class EvtVubBinnedWeights {
+
+public:
+
+  enum EdgeType { closedBelow, closedAbove };
+
+  EvtVubBinnedWeights() {}
+
+  // Add an axis with the lower edges of its bins
+  void addAxis(const std::vector<double> &edges, EdgeType type=closedBelow);
+
+  // The weights of all bins, first axis fastest
+  void setWeights(const std::vector<double> &weights);
+
+  int getNAxes() const {return _axes.size();}
+  int getNBins() const {return _weights.size();}
+  const std::vector<double>& getEdges(int axis) const {return _axes[axis].edges;}
+
+  // The bin of x on an axis, or -1 if x is below the first edge
+  int findBin(int axis, double x) const;
+
+  // The bin in the weight table of the point x[0..getNAxes()-1], or -1
+  // if x is outside the table
+  int findBin(const double x[]) const;
+
+  double getWeight(int bin) const {return _weights[bin];}
+
+private:
+
+  struct Axis {
+    std::vector<double> edges;
+    bool closedBelow;
+    bool ascending;
+    // lower end and inverse width of the cells, and the bin at the lower
+    // end of each cell
+    double low;
+    double scale;
+    std::vector<int> cellBin;
+  };
+
+  static bool aboveEdge(const Axis &axis, double x, int i);
+  static int findBinLinear(const Axis &axis, double x);
+  static int findBin(const Axis &axis, double x);
+
+  std::vector<Axis> _axes;
+  std::vector<double> _weights;
+
+};
+
+#endif
@@ -28,12 +28,14 @@
 //   Jochen Dingfelder February 1, 2005  Created Module as update of
 //                                       the module EvtVub including
 //                                       hybrid model.
+//   Oct 2026                            Weights in an EvtVubBinnedWeights
 //------------------------------------------------------------------------
 
 #ifndef EVTVUBHYBRID_HH
 #define EVTVUBHYBRID_HH
 
 #include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenModels/EvtVubBinnedWeights.hh"
 
 #include <vector>
 
@@ -79,10 +81,7 @@ private:
   int    _nbins_El;
   int    _nbins;
   double _masscut;
-  double * _bins_mX;
-  double * _bins_q2;
-  double * _bins_El;
-  double * _weights;
+  EvtVubBinnedWeights _weights; // in bins of mX, q2 and El
   EvtVubdGamma *_dGamma; // calculates the decay rate
   std::vector<double> _pf;
 };
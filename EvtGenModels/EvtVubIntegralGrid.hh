@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenModels/EvtVubIntegralGrid.hh
+//
+// Description: Table of the shape function integrals of the inclusive
+//              B -> Xu l nu models (EvtVubBLNP, EvtVubBLNPHybrid and
+//              EvtVubNLO). The integrals only depend on P+ and P-, which
+//              the models map to u and v in [0,1]; they are computed at
+//              the nodes of a nGrid x nGrid grid and interpolated
+//              bilinearly in between.
+//
+//              A cell is evaluated exactly instead if the rate calculated
+//              from the interpolated integrals at its centre, an edge
+//              centre or just inside a corner differs from the exact one
+//              by more than the tolerance, relative to the exact rate or
+//              to the mean rate where the rate is smaller.
+//              Cells at u=0 or v=0, where the integrals are singular, are
+//              always evaluated exactly.
+//
+//              Grids are kept for the lifetime of the program and shared
+//              by all instances of a model that ask for the same key, so
+//              each set of model parameters is tabulated once, whatever
+//              the number of decays and aliases using it. The models ask
+//              for their grids in init, never per decay; getGrid may be
+//              called from several threads.
+//
+//              Tabulation is off (tolerance 0) by default, which keeps the
+//              exact integrals; setTolerance switches it on for models
+//              initialised afterwards.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#ifndef EVTVUBINTEGRALGRID_HH
+#define EVTVUBINTEGRALGRID_HH
+
+#include <vector>
+
+class EvtVubIntegralGrid {
+
+public:
+
+  // What a model tabulates
+  class Function {
+  public:
+    virtual ~Function() {}
+    // The integrals at (u,v)
+    virtual void values(double u, double v, double f[]) const = 0;
+    // The rate at (u,v) for the integrals f; w in [0,1] is the third
+    // kinematic variable, which the integrals do not depend on
+    virtual double rate(double u, double v, double w, const double f[]) const = 0;
+  };
+
+  enum { nGrid = 64 };
+
+  // The grid of nValues integrals for key, tabulated from function at
+  // the first request
+  static const EvtVubIntegralGrid* getGrid(const std::vector<double> &key, int nValues,
+                                           const Function &function);
+
+  // The interpolated integrals at (u,v); false if the point has to be
+  // evaluated exactly
+  bool interpolate(double u, double v, double f[]) const;
+
+  int getNExactCells() const {return _nExact;}
+
+  static void setTolerance(double tolerance) {_tolerance = tolerance;}
+  static double getTolerance() {return _tolerance;}
+
+private:
+
+  EvtVubIntegralGrid(int nValues, const Function &function, double tolerance);
+
+  EvtVubIntegralGrid(const EvtVubIntegralGrid&);
+  EvtVubIntegralGrid& operator=(const EvtVubIntegralGrid&);
+
+  // Bilinear interpolation in cell (iu,iv), at (du,dv) in [0,1] from
+  // its lower corner
+  void interpolateCell(int iu, int iv, double du, double dv, double f[]) const;
+
+  int _nValues;
+  int _nExact;
+
+  // The integrals at node (iu,iv) start at ((iu*(nGrid+1))+iv)*_nValues
+  std::vector<double> _table;
+  std::vector<bool> _exactCell;
+
+  static double _tolerance;
+
+};
+
+#endif
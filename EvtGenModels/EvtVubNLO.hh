@@ -17,6 +17,9 @@
 // Modification history:
 //
 //   Sven Menke     January 17, 2001         Module created
+//                  Oct 2026                 Reuse the jet function integrator
+//                  Oct 2026                 Optional tabulation of the integrals
+//                  Oct 2026                 Weights in an EvtVubBinnedWeights
 //
 //------------------------------------------------------------------------
 
@@ -25,15 +28,19 @@
 
 #include <vector>
 #include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenModels/EvtVubIntegralGrid.hh"
+#include "EvtGenModels/EvtVubBinnedWeights.hh"
 
 class EvtParticle;
 class RandGeneral;
+class EvtItgPtrFunction;
+class EvtItgAbsIntegrator;
 
 class EvtVubNLO:public  EvtDecayIncoherent  {
 
 public:
   
-  EvtVubNLO() {}
+  EvtVubNLO() : _jetFunc(0), _jetSF(0), _grid(0), _gridMB(0.) {}
   virtual ~EvtVubNLO();
 
   std::string getName();
@@ -63,14 +70,36 @@ private:
   double _dGMax;  // max dGamma*p2 value;
   int    _nbins;
   int    _idSF;// which shape function?
-  double * _masses;
-  double * _weights;
+  std::vector<double> _masses;
+  EvtVubBinnedWeights _weights; // in bins of the hadronic mass
 
   double _gmax;
   int _ngood,_ntot;
 
+  // integrand of tripleDiff and its integrator, made once in init
+  EvtItgPtrFunction *_jetFunc;
+  EvtItgAbsIntegrator *_jetSF;
+
+  // The integrals of F1Int and F2Int as functions of u = sqrt(pp/mB) and
+  // v = y, tabulated in init for the nominal B mass _gridMB if
+  // EvtVubIntegralGrid has a tolerance; shared with the other decays
+  // using the same parameters
+  class GridFunction : public EvtVubIntegralGrid::Function {
+  public:
+    GridFunction(EvtVubNLO &model) : _model(model) {}
+    void values(double u, double v, double f[]) const;
+    double rate(double u, double v, double w, const double f[]) const;
+  private:
+    EvtVubNLO &_model;
+  };
+  const EvtVubIntegralGrid *_grid;
+  double _gridMB;
+
 
   double tripleDiff(double pp, double pl, double pm);
+  // with the integrals of F1Int and F2Int, or integrating numerically if 0
+  double tripleDiff(double pp, double pl, double pm, const double jetInt[]);
+  std::vector<double> coefficients(double pp, double pl, double pm);
   double SFNorm(const std::vector<double> &coeffs);
   static double integrand(double omega, const std::vector<double> &coeffs);
   double F10(const std::vector<double> &coeffs);
@@ -37,7 +37,7 @@ class EvtbTosllMS:public  EvtDecayAmp{
 
 public:
 
-  EvtbTosllMS() {} ;
+  EvtbTosllMS() : _msffmodel(0), _calcamp(0), _wilscoeff(0) {} ;
   virtual ~EvtbTosllMS();
 
   virtual std::string getName() ;
@@ -38,7 +38,7 @@ class EvtbTosllMSExt:public  EvtDecayAmp{
 
 public:
 
-  EvtbTosllMSExt() {} ;
+  EvtbTosllMSExt() : _msffmodel(0), _calcamp(0), _wilscoeff(0) {} ;
   virtual ~EvtbTosllMSExt();
 
   virtual std::string getName() ;
@@ -32,7 +32,7 @@ class Evtbs2llGammaISRFSR:public  EvtDecayAmp{
 
 public:
 
-  Evtbs2llGammaISRFSR() {}
+  Evtbs2llGammaISRFSR() : _mntffmodel(0), _calcamp(0), _wilscoeff(0) {}
   virtual ~Evtbs2llGammaISRFSR();
 
   virtual std::string getName();
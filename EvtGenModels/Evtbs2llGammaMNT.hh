@@ -38,7 +38,7 @@ class Evtbs2llGammaMNT:public  EvtDecayAmp{
 
 public:
 
-  Evtbs2llGammaMNT() {}
+  Evtbs2llGammaMNT() : _mntffmodel(0), _calcamp(0), _wilscoeff(0) {}
   virtual ~Evtbs2llGammaMNT();
 
   virtual std::string getName();
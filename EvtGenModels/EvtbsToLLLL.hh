@@ -32,7 +32,7 @@ class EvtbsToLLLL:public  EvtDecayAmp{
 
 public:
 
-  EvtbsToLLLL() {} ;
+  EvtbsToLLLL() : _mntffmodel(0), _calcamp(0), _wilscoeff(0) {} ;
   virtual ~EvtbsToLLLL();
 
   virtual std::string getName() ;
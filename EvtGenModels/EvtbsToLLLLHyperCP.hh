@@ -30,7 +30,7 @@ class EvtbsToLLLLHyperCP:public  EvtDecayAmp{
 
 public:
 
-  EvtbsToLLLLHyperCP() {} ;
+  EvtbsToLLLLHyperCP() : _calcamp(0) {} ;
   virtual ~EvtbsToLLLLHyperCP();
 
   virtual std::string getName() ;
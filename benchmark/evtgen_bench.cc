@@ -0,0 +1,547 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: evtgen_bench.cc
+//
+// Description: Decay throughput benchmarks for a fixed set of workloads:
+//              generic Upsilon(4S) decays from DECAY.DEC, D+ -> K- pi+ pi+
+//              with GENERIC_DALITZ, semileptonic B+ decays with ISGW2 and
+//              HQET2, B+ -> K*+ mu+ mu- with BTOSLLBALL, five body phase
+//              space and generic Upsilon(4S) decays converted to HepMC.
+//              The B workloads use B+, which does not mix, and keep the
+//              daughters simple, so that they time the model named.
+//
+//              Each workload gets its own generator with a fixed seed.
+//              After a warm-up, which also covers the probmax warm-up of
+//              the models, the events are generated in several repeats;
+//              every event is timed on its own. The report gives the
+//              events/s of the repeats (median, minimum and maximum and
+//              the spread between them), the percentiles of the time per
+//              event and, from one more pass with EvtDecayStats timing,
+//              the channels which take the most time.
+//
+//              Without the external generators (EVTGEN_EXTERNAL) the
+//              PYTHIA channels of DECAY.DEC are decayed by phase space, so
+//              numbers can only be compared between builds with the same
+//              external generator setting.
+//
+//              evtgen_bench --help lists the options.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//    Oct 2026            Added --ps-batch
+//
+//------------------------------------------------------------------------
+
+#include "EvtGen/EvtGen.hh"
+#include "EvtGenBase/EvtDecayBase.hh"
+#include "EvtGenBase/EvtDecayIncoherent.hh"
+#include "EvtGenBase/EvtDecayStats.hh"
+#include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtHepMCEvent.hh"
+#include "EvtGenBase/EvtMTRandomEngine.hh"
+#include "EvtGenBase/EvtPDL.hh"
+#include "EvtGenBase/EvtReportUtils.hh"
+#include "EvtGenBase/EvtParticle.hh"
+#include "EvtGenBase/EvtParticleFactory.hh"
+#include "EvtGenBase/EvtVector4R.hh"
+
+#ifdef EVTGEN_EXTERNAL
+#include "EvtGenExternal/EvtExternalGenList.hh"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+#ifndef EVTGEN_BENCH_DATA_DIR
+#define EVTGEN_BENCH_DATA_DIR "."
+#endif
+
+namespace {
+
+#ifndef EVTGEN_EXTERNAL
+  // Stands in for Pythia so that DECAY.DEC can be read
+  class EvtBenchPythia : public EvtDecayIncoherent {
+  public:
+    std::string getName() {return "PYTHIA";}
+    EvtDecayBase* clone() {return new EvtBenchPythia;}
+    void init() {}
+    void initProbMax() {noProbMax();}
+    void decay(EvtParticle* p) {p->initializePhaseSpace(getNDaug(), getDaugs());}
+  };
+#endif
+
+  struct Workload {
+    const char* name;
+    const char* description;
+    const char* parent;
+    // User decay file, @DALITZ@ stands for the Dalitz XML file; 0 for none
+    const char* userDecay;
+    bool hepMC;
+  };
+
+  const Workload workloads[] = {
+    {"generic", "Upsilon(4S), generic decays from DECAY.DEC",
+     "Upsilon(4S)", 0, false},
+    {"dalitz", "D+ -> K- pi+ pi+, GENERIC_DALITZ",
+     "D+",
+     "Decay D+\n"
+     "1.0 K- pi+ pi+ GENERIC_DALITZ @DALITZ@;\n"
+     "Enddecay\n"
+     "End\n", false},
+    {"semileptonic", "B+ -> anti-D(*)0 e+ nu_e, ISGW2 and HQET2",
+     "B+",
+     "Decay B+\n"
+     "0.25 anti-D*0 e+ nu_e HQET2 1.207 0.920 1.406 0.853;\n"
+     "0.25 anti-D0 e+ nu_e HQET2 1.185 1.081;\n"
+     "0.25 anti-D*0 e+ nu_e ISGW2;\n"
+     "0.25 anti-D0 e+ nu_e ISGW2;\n"
+     "Enddecay\n"
+     "Decay anti-D*0\n"
+     "1.0 anti-D0 pi0 VSS;\n"
+     "Enddecay\n"
+     "Decay anti-D0\n"
+     "Enddecay\n"
+     "Decay pi0\n"
+     "Enddecay\n"
+     "End\n", false},
+    {"btokstarll", "B+ -> K*+ mu+ mu-, BTOSLLBALL",
+     "B+",
+     "Decay B+\n"
+     "1.0 K*+ mu+ mu- BTOSLLBALL;\n"
+     "Enddecay\n"
+     "Decay K*+\n"
+     "1.0 K+ pi0 VSS;\n"
+     "Enddecay\n"
+     "Decay pi0\n"
+     "Enddecay\n"
+     "End\n", false},
+    {"phsp", "B+ -> 3pi+ 2pi-, PHSP",
+     "B+",
+     "Decay B+\n"
+     "1.0 pi+ pi+ pi+ pi- pi- PHSP;\n"
+     "Enddecay\n"
+     "End\n", false},
+    {"hepmc", "Upsilon(4S), generic decays converted to HepMC",
+     "Upsilon(4S)", 0, true}
+  };
+
+  const int nWorkloads = sizeof(workloads)/sizeof(workloads[0]);
+
+  struct Options {
+    int events;
+    int warmup;
+    int repeats;
+    int channels;
+    int phaseSpaceBatch;
+    std::string dataDir;
+    std::string decayFile;
+    std::string pdlFile;
+    std::string dalitzFile;
+    std::string jsonFile;
+    std::vector<std::string> only;
+  };
+
+  struct Channel {
+    std::string decay;
+    std::string model;
+    long calls;
+    double triesPerCall;
+    double nsPerCall;
+    double timeShare;
+  };
+
+  struct Result {
+    const Workload* workload;
+    int events;
+    std::vector<double> eventsPerSecond;
+    double medianRate;
+    double minRate;
+    double maxRate;
+    double relSpread;
+    double meanNs;
+    double p50Ns;
+    double p90Ns;
+    double p99Ns;
+    std::vector<Channel> channels;
+  };
+
+  // Nearest rank percentile of sorted values
+  double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    std::size_t rank = static_cast<std::size_t>(std::ceil(fraction*sorted.size()));
+    if (rank < 1) rank = 1;
+    if (rank > sorted.size()) rank = sorted.size();
+    return sorted[rank-1];
+  }
+
+  void resetRunStats(EvtGen& generator) {
+    EvtDecayTable* table = generator.getContext()->getDecayTable();
+    int nParticles = EvtPDL::entries();
+    for (int i=0; i<nParticles; i++) {
+      int nModes = table->getNModes(i);
+      for (int j=0; j<nModes; j++) {
+	EvtDecayBase* decay = table->getDecay(i, j);
+	if (decay) decay->resetRunStats();
+      }
+    }
+  }
+
+  class EventRunner {
+  public:
+    EventRunner(EvtGen& generator, const Workload& workload) :
+      _generator(generator), _hepMC(workload.hepMC) {
+      _id = EvtPDL::getId(workload.parent);
+      _pdgId = EvtPDL::getStdHep(_id);
+      _p4 = EvtVector4R(EvtPDL::getMass(_id), 0.0, 0.0, 0.0);
+    }
+    void run() {
+      if (_hepMC) {
+	EvtHepMCEvent* event = _generator.generateDecay(_pdgId, _p4, EvtVector4R(0.0, 0.0, 0.0, 0.0));
+	delete event;
+	return;
+      }
+      EvtParticle* parent = EvtParticleFactory::particleFactory(_id, _p4);
+      _generator.generateDecay(parent);
+      parent->deleteTree();
+    }
+  private:
+    EvtGen& _generator;
+    bool _hepMC;
+    EvtId _id;
+    int _pdgId;
+    EvtVector4R _p4;
+  };
+
+  bool byTime(const Channel& a, const Channel& b) {
+    return a.timeShare > b.timeShare;
+  }
+
+  std::string writeUserDecay(const Workload& workload, const Options& options) {
+
+    std::string text(workload.userDecay);
+    std::string::size_type pos = text.find("@DALITZ@");
+    if (pos != std::string::npos) text.replace(pos, 8, options.dalitzFile);
+
+    std::string fileName = std::string("evtgen_bench_")+workload.name+".dec";
+    std::ofstream output(fileName.c_str());
+    output << text;
+    if (!output) {
+      std::cerr << "Can not write " << fileName << std::endl;
+      std::exit(1);
+    }
+
+    return fileName;
+
+  }
+
+  Result runWorkload(const Workload& workload, const Options& options) {
+
+    Result result;
+    result.workload = &workload;
+    result.events = options.events;
+
+    EvtMTRandomEngine engine;
+
+    EvtAbsRadCorr* radCorrEngine(0);
+    std::list<EvtDecayBase*> extraModels;
+
+#ifdef EVTGEN_EXTERNAL
+    bool convertPythiaCodes(false);
+    bool useEvtGenRandom(true);
+    EvtExternalGenList genList(convertPythiaCodes, "", "gamma", useEvtGenRandom);
+    radCorrEngine = genList.getPhotosModel();
+    extraModels = genList.getListOfModels();
+#else
+    extraModels.push_back(new EvtBenchPythia);
+#endif
+
+    EvtGen generator(options.decayFile.c_str(), options.pdlFile.c_str(), &engine,
+		     radCorrEngine, &extraModels);
+
+    generator.getContext()->setPhaseSpaceBatchSize(options.phaseSpaceBatch);
+
+    if (workload.userDecay) {
+      std::string userFile = writeUserDecay(workload, options);
+      generator.readUDecay(userFile.c_str());
+      std::remove(userFile.c_str());
+    }
+
+    EventRunner runner(generator, workload);
+
+    for (int i=0; i<options.warmup; i++) runner.run();
+
+    std::vector<double> eventNs;
+    eventNs.reserve(static_cast<std::size_t>(options.events)*options.repeats);
+
+    for (int r=0; r<options.repeats; r++) {
+      double start = EvtReportUtils::wallTime();
+      for (int i=0; i<options.events; i++) {
+	double eventStart = EvtReportUtils::wallTime();
+	runner.run();
+	eventNs.push_back(1e9*(EvtReportUtils::wallTime()-eventStart));
+      }
+      result.eventsPerSecond.push_back(options.events/(EvtReportUtils::wallTime()-start));
+    }
+
+    std::vector<double> rates(result.eventsPerSecond);
+    std::sort(rates.begin(), rates.end());
+    result.medianRate = percentile(rates, 0.5);
+    result.minRate = rates.front();
+    result.maxRate = rates.back();
+
+    double mean(0.0), sumSq(0.0);
+    for (std::size_t i=0; i<rates.size(); i++) mean += rates[i];
+    mean /= rates.size();
+    for (std::size_t i=0; i<rates.size(); i++) sumSq += (rates[i]-mean)*(rates[i]-mean);
+    result.relSpread = rates.size() > 1 ? std::sqrt(sumSq/(rates.size()-1))/mean : 0.0;
+
+    std::sort(eventNs.begin(), eventNs.end());
+    double sumNs(0.0);
+    for (std::size_t i=0; i<eventNs.size(); i++) sumNs += eventNs[i];
+    result.meanNs = sumNs/eventNs.size();
+    result.p50Ns = percentile(eventNs, 0.50);
+    result.p90Ns = percentile(eventNs, 0.90);
+    result.p99Ns = percentile(eventNs, 0.99);
+
+    // One more pass with the clock in every decay() for the channel table;
+    // kept apart since the timing slows the cheap channels down.
+    if (options.channels > 0) {
+
+      resetRunStats(generator);
+      EvtDecayStats::setTiming(true);
+      for (int i=0; i<options.events; i++) runner.run();
+      EvtDecayStats::setTiming(false);
+
+      EvtDecayStats stats = generator.getDecayStats();
+      const std::vector<EvtDecayStats::Channel>& channels = stats.getChannels();
+
+      double total(0.0);
+      for (std::size_t i=0; i<channels.size(); i++) total += channels[i].stats.decaySeconds;
+
+      for (std::size_t i=0; i<channels.size(); i++) {
+	const EvtDecayBase::RunStats& run = channels[i].stats;
+	if (run.calls == 0) continue;
+	Channel channel;
+	channel.decay = channels[i].parent+" -> "+channels[i].daughters;
+	channel.model = channels[i].model;
+	channel.calls = run.calls;
+	channel.triesPerCall = static_cast<double>(run.tries)/run.calls;
+	channel.nsPerCall = 1e9*run.decaySeconds/run.calls;
+	channel.timeShare = total > 0.0 ? run.decaySeconds/total : 0.0;
+	result.channels.push_back(channel);
+      }
+
+      std::sort(result.channels.begin(), result.channels.end(), byTime);
+      if (result.channels.size() > static_cast<std::size_t>(options.channels)) {
+	result.channels.resize(options.channels);
+      }
+
+    }
+
+    return result;
+
+  }
+
+  void printResult(const Result& result) {
+
+    std::cout << std::fixed;
+    std::cout << "\n== " << result.workload->name << ": "
+	      << result.workload->description << "\n";
+    std::cout << "   events/s  median " << std::setprecision(1) << result.medianRate
+	      << "  min " << result.minRate << "  max " << result.maxRate
+	      << "  spread " << std::setprecision(2) << 100.0*result.relSpread << "%\n";
+    std::cout << "   ns/event  mean " << std::setprecision(0) << result.meanNs
+	      << "  p50 " << result.p50Ns << "  p90 " << result.p90Ns
+	      << "  p99 " << result.p99Ns << "\n";
+
+    if (result.channels.empty()) return;
+
+    std::cout << "   " << std::setw(10) << "calls" << std::setw(12) << "tries/call"
+	      << std::setw(12) << "ns/decay" << std::setw(8) << "time%" << "  channel\n";
+    for (std::size_t i=0; i<result.channels.size(); i++) {
+      const Channel& channel = result.channels[i];
+      std::cout << "   " << std::setw(10) << channel.calls
+		<< std::setw(12) << std::setprecision(2) << channel.triesPerCall
+		<< std::setw(12) << std::setprecision(0) << channel.nsPerCall
+		<< std::setw(8) << std::setprecision(1) << 100.0*channel.timeShare
+		<< "  " << channel.decay << " (" << channel.model << ")\n";
+    }
+
+  }
+
+  void writeJSON(const std::vector<Result>& results, const Options& options) {
+
+    std::ofstream output(options.jsonFile.c_str());
+    if (!output) {
+      std::cerr << "Can not write " << options.jsonFile << std::endl;
+      return;
+    }
+
+    output.precision(9);
+    output << "{\n  \"events\": " << options.events
+	   << ",\n  \"warmup\": " << options.warmup
+	   << ",\n  \"repeats\": " << options.repeats
+	   << ",\n  \"phaseSpaceBatch\": " << options.phaseSpaceBatch
+	   << ",\n  \"workloads\": [";
+
+    for (std::size_t w=0; w<results.size(); w++) {
+      const Result& result = results[w];
+      output << (w == 0 ? "\n" : ",\n")
+	     << "    {\"name\": " << EvtReportUtils::jsonString(result.workload->name)
+	     << ", \"description\": " << EvtReportUtils::jsonString(result.workload->description)
+	     << ",\n     \"eventsPerSecond\": {\"median\": " << result.medianRate
+	     << ", \"min\": " << result.minRate << ", \"max\": " << result.maxRate
+	     << ", \"relSpread\": " << result.relSpread << ", \"repeats\": [";
+      for (std::size_t r=0; r<result.eventsPerSecond.size(); r++) {
+	output << (r == 0 ? "" : ", ") << result.eventsPerSecond[r];
+      }
+      output << "]},\n     \"nsPerEvent\": {\"mean\": " << result.meanNs
+	     << ", \"p50\": " << result.p50Ns << ", \"p90\": " << result.p90Ns
+	     << ", \"p99\": " << result.p99Ns << "},\n     \"channels\": [";
+      for (std::size_t i=0; i<result.channels.size(); i++) {
+	const Channel& channel = result.channels[i];
+	output << (i == 0 ? "\n" : ",\n")
+	       << "       {\"decay\": " << EvtReportUtils::jsonString(channel.decay)
+	       << ", \"model\": " << EvtReportUtils::jsonString(channel.model)
+	       << ", \"calls\": " << channel.calls
+	       << ", \"triesPerCall\": " << channel.triesPerCall
+	       << ", \"nsPerDecay\": " << channel.nsPerCall
+	       << ", \"timeShare\": " << channel.timeShare << "}";
+      }
+      output << (result.channels.empty() ? "]}" : "\n     ]}");
+    }
+
+    output << "\n  ]\n}\n";
+
+  }
+
+  void usage() {
+    std::cout <<
+      "Usage: evtgen_bench [options]\n"
+      "  --events N     events per repeat (default 2000)\n"
+      "  --warmup N     untimed events before the repeats (default 1000)\n"
+      "  --repeats N    timed repeats (default 5)\n"
+      "  --channels N   most expensive channels to list, 0 for none (default 10)\n"
+      "  --ps-batch N   prefetch N phase space configurations at a time\n"
+      "                 (EvtGenKine::setBatchSize, default 0 for none)\n"
+      "  --only NAME    run only this workload; may be given several times\n"
+      "  --data DIR     directory with DECAY.DEC, evt.pdl and validation/\n"
+      "  --dec FILE     main decay file (default DIR/DECAY.DEC)\n"
+      "  --pdl FILE     particle property file (default DIR/evt.pdl)\n"
+      "  --json FILE    also write the results as JSON\n"
+      "Workloads:\n";
+    for (int i=0; i<nWorkloads; i++) {
+      std::cout << "  " << std::setw(14) << std::left << workloads[i].name
+		<< std::right << workloads[i].description << "\n";
+    }
+  }
+
+  int intArgument(int& i, int argc, char** argv) {
+    if (i+1 >= argc) {
+      std::cerr << argv[i] << " needs a value" << std::endl;
+      std::exit(1);
+    }
+    return std::atoi(argv[++i]);
+  }
+
+  std::string stringArgument(int& i, int argc, char** argv) {
+    if (i+1 >= argc) {
+      std::cerr << argv[i] << " needs a value" << std::endl;
+      std::exit(1);
+    }
+    return argv[++i];
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  Options options;
+  options.events = 2000;
+  options.warmup = 1000;
+  options.repeats = 5;
+  options.channels = 10;
+  options.phaseSpaceBatch = 0;
+  options.dataDir = EVTGEN_BENCH_DATA_DIR;
+
+  for (int i=1; i<argc; i++) {
+    std::string arg(argv[i]);
+    if (arg == "--events") options.events = intArgument(i, argc, argv);
+    else if (arg == "--warmup") options.warmup = intArgument(i, argc, argv);
+    else if (arg == "--repeats") options.repeats = intArgument(i, argc, argv);
+    else if (arg == "--channels") options.channels = intArgument(i, argc, argv);
+    else if (arg == "--ps-batch") options.phaseSpaceBatch = intArgument(i, argc, argv);
+    else if (arg == "--only") options.only.push_back(stringArgument(i, argc, argv));
+    else if (arg == "--data") options.dataDir = stringArgument(i, argc, argv);
+    else if (arg == "--dec") options.decayFile = stringArgument(i, argc, argv);
+    else if (arg == "--pdl") options.pdlFile = stringArgument(i, argc, argv);
+    else if (arg == "--json") options.jsonFile = stringArgument(i, argc, argv);
+    else if (arg == "--help" || arg == "-h") {
+      usage();
+      return 0;
+    } else {
+      std::cerr << "Unknown option " << arg << std::endl;
+      usage();
+      return 1;
+    }
+  }
+
+  if (options.events < 1 || options.repeats < 1 || options.warmup < 0) {
+    std::cerr << "Need at least one event and one repeat" << std::endl;
+    return 1;
+  }
+
+  if (options.decayFile.empty()) options.decayFile = options.dataDir+"/DECAY.DEC";
+  if (options.pdlFile.empty()) options.pdlFile = options.dataDir+"/evt.pdl";
+  options.dalitzFile = options.dataDir+"/validation/DalitzFiles/DalitzDecays.xml";
+
+  for (std::size_t i=0; i<options.only.size(); i++) {
+    bool known(false);
+    for (int w=0; w<nWorkloads; w++) {
+      if (options.only[i] == workloads[w].name) known = true;
+    }
+    if (!known) {
+      std::cerr << "Unknown workload " << options.only[i] << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+
+  for (int w=0; w<nWorkloads; w++) {
+    if (!options.only.empty() &&
+	std::find(options.only.begin(), options.only.end(),
+		  std::string(workloads[w].name)) == options.only.end()) continue;
+    results.push_back(runWorkload(workloads[w], options));
+  }
+
+  std::cout << "\nevtgen_bench: " << options.repeats << " x " << options.events
+	    << " events after " << options.warmup << " warm-up events";
+  if (options.phaseSpaceBatch > 1) {
+    std::cout << ", phase space batches of " << options.phaseSpaceBatch;
+  }
+  std::cout << "\n";
+  for (std::size_t i=0; i<results.size(); i++) printResult(results[i]);
+  std::cout << std::endl;
+
+  if (!options.jsonFile.empty()) writeJSON(results, options);
+
+  return 0;
+
+}
@@ -0,0 +1,559 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: evtgen_microbench.cc
+//
+// Description: Microbenchmarks of the EvtGenBase algebra used in the
+//              amplitudes: EvtComplex arithmetic, boosts and rotations of
+//              EvtVector4R, EvtVector4C and EvtTensor4C, the contractions
+//              and direct products of the tensors, EvtGammaMatrix acting on
+//              EvtDiracSpinor and the lepton currents.
+//
+//              Each kernel runs over a fixed set of pseudo random inputs,
+//              so that the compiler can not fold it away, and adds its
+//              results to a checksum. The number of operations per repeat
+//              is doubled until a repeat takes at least --min-time
+//              seconds; after one untimed repeat the median, minimum and
+//              spread of the ns/op of the repeats are reported. The
+//              "loop" kernel only reads the inputs and gives the overhead
+//              which is included in the other numbers.
+//
+//              The kernels do not need the decay tables or evt.pdl.
+//              evtgen_microbench --help lists the options.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+
+#include "EvtGenBase/EvtComplex.hh"
+#include "EvtGenBase/EvtDiracSpinor.hh"
+#include "EvtGenBase/EvtGammaMatrix.hh"
+#include "EvtGenBase/EvtReportUtils.hh"
+#include "EvtGenBase/EvtTensor4C.hh"
+#include "EvtGenBase/EvtVector3R.hh"
+#include "EvtGenBase/EvtVector4C.hh"
+#include "EvtGenBase/EvtVector4R.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // Power of two, small enough to stay in the L1 cache
+  const int nInputs = 64;
+  const int inputMask = nInputs-1;
+
+  struct Inputs {
+    double x[nInputs];
+    EvtComplex c1[nInputs];
+    EvtComplex c2[nInputs];
+    EvtVector4R p[nInputs];
+    EvtVector4R boost[nInputs];
+    EvtVector3R beta[nInputs];
+    double angles[nInputs][3];
+    EvtVector4C v1[nInputs];
+    EvtVector4C v2[nInputs];
+    EvtTensor4C t1[nInputs];
+    EvtTensor4C t2[nInputs];
+    EvtDiracSpinor u1[nInputs];
+    EvtDiracSpinor u2[nInputs];
+  };
+
+  // Checksum of all kernels, read at the end so that nothing is dropped
+  volatile double sink = 0.0;
+
+  // Fixed sequence, independent of EvtRandom and its engine
+  class Lcg {
+  public:
+    Lcg() : _state(12345u) {}
+    double flat(double low, double high) {
+      _state = 1664525u*_state+1013904223u;
+      return low+(high-low)*(_state>>8)/16777216.0;
+    }
+    EvtComplex complex() {
+      return EvtComplex(flat(-1.0, 1.0), flat(-1.0, 1.0));
+    }
+  private:
+    unsigned int _state;
+  };
+
+  void fillInputs(Inputs& in) {
+
+    Lcg lcg;
+
+    for (int i=0; i<nInputs; i++) {
+
+      in.x[i] = lcg.flat(0.5, 1.5);
+      in.c1[i] = lcg.complex();
+      in.c2[i] = EvtComplex(lcg.flat(0.5, 1.0), lcg.flat(-1.0, 1.0));
+
+      double mass = lcg.flat(0.1, 2.0);
+      EvtVector3R q(lcg.flat(-2.0, 2.0), lcg.flat(-2.0, 2.0), lcg.flat(-2.0, 2.0));
+      in.p[i] = EvtVector4R(std::sqrt(mass*mass+q.d3mag()*q.d3mag()), q.get(0), q.get(1), q.get(2));
+
+      double parentMass = lcg.flat(1.0, 6.0);
+      EvtVector3R b(lcg.flat(-3.0, 3.0), lcg.flat(-3.0, 3.0), lcg.flat(-3.0, 3.0));
+      double e = std::sqrt(parentMass*parentMass+b.d3mag()*b.d3mag());
+      in.boost[i] = EvtVector4R(e, b.get(0), b.get(1), b.get(2));
+      in.beta[i] = EvtVector3R(b.get(0)/e, b.get(1)/e, b.get(2)/e);
+
+      for (int k=0; k<3; k++) in.angles[i][k] = lcg.flat(0.0, 6.283185307);
+
+      for (int k=0; k<4; k++) {
+	in.v1[i].set(k, lcg.complex());
+	in.v2[i].set(k, lcg.complex());
+      }
+
+      for (int j=0; j<4; j++) {
+	for (int k=0; k<4; k++) {
+	  in.t1[i].set(j, k, lcg.complex());
+	  in.t2[i].set(j, k, lcg.complex());
+	}
+      }
+
+      in.u1[i].set(lcg.complex(), lcg.complex(), lcg.complex(), lcg.complex());
+      in.u2[i].set(lcg.complex(), lcg.complex(), lcg.complex(), lcg.complex());
+
+    }
+
+  }
+
+  // The kernels: n operations on the inputs, returning a checksum
+
+  double loopOverhead(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) sum += in.x[i & inputMask];
+    return sum;
+  }
+
+  double complexMultiply(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.c1[i & inputMask]*in.c2[i & inputMask];
+    return real(sum);
+  }
+
+  double complexDivide(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.c1[i & inputMask]/in.c2[i & inputMask];
+    return real(sum);
+  }
+
+  double complexExp(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += exp(in.c1[i & inputMask]);
+    return real(sum);
+  }
+
+  double complexAbs2(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) sum += abs2(in.c1[i & inputMask]+in.c2[i & inputMask]);
+    return sum;
+  }
+
+  double vector4RDot(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) sum += in.p[i & inputMask]*in.boost[i & inputMask];
+    return sum;
+  }
+
+  double vector4RBoostTo(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) sum += boostTo(in.p[i & inputMask], in.boost[i & inputMask]).get(0);
+    return sum;
+  }
+
+  double vector4RBoostTo3R(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) sum += boostTo(in.p[i & inputMask], in.beta[i & inputMask]).get(0);
+    return sum;
+  }
+
+  double vector4RApplyBoostTo(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) {
+      EvtVector4R p(in.p[i & inputMask]);
+      p.applyBoostTo(in.boost[i & inputMask]);
+      sum += p.get(0);
+    }
+    return sum;
+  }
+
+  double vector4RRotateEuler(const Inputs& in, long n) {
+    double sum(0.0);
+    for (long i=0; i<n; i++) {
+      const double* angles = in.angles[i & inputMask];
+      sum += rotateEuler(in.p[i & inputMask], angles[0], angles[1], angles[2]).get(1);
+    }
+    return sum;
+  }
+
+  double vector4CCont(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.v1[i & inputMask]*in.v2[i & inputMask];
+    return real(sum);
+  }
+
+  double vector4CBoostTo(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += boostTo(in.v1[i & inputMask], in.boost[i & inputMask]).get(0);
+    return real(sum);
+  }
+
+  double tensor4CDirectProd(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) {
+      sum += EvtGenFunctions::directProd(in.v1[i & inputMask], in.v2[i & inputMask]).get(1, 2);
+    }
+    return real(sum);
+  }
+
+  double tensor4CDirectProdR(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) {
+      sum += EvtGenFunctions::directProd(in.p[i & inputMask], in.boost[i & inputMask]).get(1, 2);
+    }
+    return real(sum);
+  }
+
+  double tensor4CCont1(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.t1[i & inputMask].cont1(in.v1[i & inputMask]).get(0);
+    return real(sum);
+  }
+
+  double tensor4CCont2(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.t1[i & inputMask].cont2(in.p[i & inputMask]).get(0);
+    return real(sum);
+  }
+
+  double tensor4CCont(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += cont(in.t1[i & inputMask], in.t2[i & inputMask]);
+    return real(sum);
+  }
+
+  double tensor4CCont22(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += cont22(in.t1[i & inputMask], in.t2[i & inputMask]).get(0, 0);
+    return real(sum);
+  }
+
+  double tensor4CDual(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += dual(in.t1[i & inputMask]).get(0, 1);
+    return real(sum);
+  }
+
+  double tensor4CBoostTo(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += boostTo(in.t1[i & inputMask], in.boost[i & inputMask]).get(0, 0);
+    return real(sum);
+  }
+
+  double tensor4CRotateEuler(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) {
+      const double* angles = in.angles[i & inputMask];
+      sum += rotateEuler(in.t1[i & inputMask], angles[0], angles[1], angles[2]).get(1, 2);
+    }
+    return real(sum);
+  }
+
+  double gammaTimesSpinor(const Inputs& in, long n) {
+    const EvtGammaMatrix& g = EvtGammaMatrix::va1();
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += (g*in.u1[i & inputMask]).get_spinor(0);
+    return real(sum);
+  }
+
+  double gammaTimesGamma(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) {
+      EvtGammaMatrix g = EvtGammaMatrix::g(i & 3)*EvtGammaMatrix::g5();
+      sum += (g*in.u1[i & inputMask]).get_spinor(0);
+    }
+    return real(sum);
+  }
+
+  double gammaSlash(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) {
+      sum += (EvtGenFunctions::slash(in.p[i & inputMask])*in.u1[i & inputMask]).get_spinor(0);
+    }
+    return real(sum);
+  }
+
+  double spinorProduct(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += in.u1[i & inputMask]*in.u2[i & inputMask];
+    return real(sum);
+  }
+
+  double spinorVACurrent(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += EvtLeptonVACurrent(in.u1[i & inputMask], in.u2[i & inputMask]).get(0);
+    return real(sum);
+  }
+
+  double spinorVCurrent(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += EvtLeptonVCurrent(in.u1[i & inputMask], in.u2[i & inputMask]).get(0);
+    return real(sum);
+  }
+
+  double spinorSCurrent(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += EvtLeptonSCurrent(in.u1[i & inputMask], in.u2[i & inputMask]);
+    return real(sum);
+  }
+
+  double spinorTCurrent(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += EvtLeptonTCurrent(in.u1[i & inputMask], in.u2[i & inputMask]).get(1, 2);
+    return real(sum);
+  }
+
+  double spinorBoostTo(const Inputs& in, long n) {
+    EvtComplex sum(0.0, 0.0);
+    for (long i=0; i<n; i++) sum += boostTo(in.u1[i & inputMask], in.boost[i & inputMask]).get_spinor(0);
+    return real(sum);
+  }
+
+  struct Kernel {
+    const char* name;
+    const char* description;
+    double (*run)(const Inputs& in, long n);
+  };
+
+  const Kernel kernels[] = {
+    {"loop", "read one double (loop overhead)", loopOverhead},
+    {"complex.mul", "EvtComplex * EvtComplex", complexMultiply},
+    {"complex.div", "EvtComplex / EvtComplex", complexDivide},
+    {"complex.exp", "exp(EvtComplex)", complexExp},
+    {"complex.abs2", "abs2(EvtComplex + EvtComplex)", complexAbs2},
+    {"vector4r.dot", "EvtVector4R * EvtVector4R", vector4RDot},
+    {"vector4r.boostTo", "boostTo(EvtVector4R, EvtVector4R)", vector4RBoostTo},
+    {"vector4r.boostTo3R", "boostTo(EvtVector4R, EvtVector3R)", vector4RBoostTo3R},
+    {"vector4r.applyBoostTo", "EvtVector4R::applyBoostTo(EvtVector4R)", vector4RApplyBoostTo},
+    {"vector4r.rotateEuler", "rotateEuler(EvtVector4R)", vector4RRotateEuler},
+    {"vector4c.cont", "EvtVector4C * EvtVector4C", vector4CCont},
+    {"vector4c.boostTo", "boostTo(EvtVector4C, EvtVector4R)", vector4CBoostTo},
+    {"tensor4c.directProd", "directProd(EvtVector4C, EvtVector4C)", tensor4CDirectProd},
+    {"tensor4c.directProdR", "directProd(EvtVector4R, EvtVector4R)", tensor4CDirectProdR},
+    {"tensor4c.cont1", "EvtTensor4C::cont1(EvtVector4C)", tensor4CCont1},
+    {"tensor4c.cont2", "EvtTensor4C::cont2(EvtVector4R)", tensor4CCont2},
+    {"tensor4c.cont", "cont(EvtTensor4C, EvtTensor4C)", tensor4CCont},
+    {"tensor4c.cont22", "cont22(EvtTensor4C, EvtTensor4C)", tensor4CCont22},
+    {"tensor4c.dual", "dual(EvtTensor4C)", tensor4CDual},
+    {"tensor4c.boostTo", "boostTo(EvtTensor4C, EvtVector4R)", tensor4CBoostTo},
+    {"tensor4c.rotateEuler", "rotateEuler(EvtTensor4C)", tensor4CRotateEuler},
+    {"gamma.spinor", "EvtGammaMatrix * EvtDiracSpinor", gammaTimesSpinor},
+    {"gamma.gamma", "(EvtGammaMatrix * EvtGammaMatrix) * EvtDiracSpinor", gammaTimesGamma},
+    {"gamma.slash", "slash(EvtVector4R) * EvtDiracSpinor", gammaSlash},
+    {"spinor.product", "EvtDiracSpinor * EvtDiracSpinor", spinorProduct},
+    {"spinor.VACurrent", "EvtLeptonVACurrent", spinorVACurrent},
+    {"spinor.VCurrent", "EvtLeptonVCurrent", spinorVCurrent},
+    {"spinor.SCurrent", "EvtLeptonSCurrent", spinorSCurrent},
+    {"spinor.TCurrent", "EvtLeptonTCurrent", spinorTCurrent},
+    {"spinor.boostTo", "boostTo(EvtDiracSpinor, EvtVector4R)", spinorBoostTo}
+  };
+
+  const int nKernels = sizeof(kernels)/sizeof(kernels[0]);
+
+  struct Options {
+    int repeats;
+    double minTime;
+    std::vector<std::string> only;
+    std::string jsonFile;
+  };
+
+  struct Result {
+    const Kernel* kernel;
+    long ops;
+    std::vector<double> nsPerOp;
+    double median;
+    double min;
+    double relSpread;
+  };
+
+  double timeKernel(const Kernel& kernel, const Inputs& in, long n) {
+    double start = EvtReportUtils::wallTime();
+    sink = sink+kernel.run(in, n);
+    return EvtReportUtils::wallTime()-start;
+  }
+
+  // A kernel is selected by its full name or by its group ("tensor4c")
+  bool selected(const Kernel& kernel, const Options& options) {
+    if (options.only.empty()) return true;
+    std::string name(kernel.name);
+    std::string group = name.substr(0, name.find('.'));
+    for (std::size_t i=0; i<options.only.size(); i++) {
+      if (options.only[i] == name || options.only[i] == group) return true;
+    }
+    return false;
+  }
+
+  Result runKernel(const Kernel& kernel, const Inputs& in, const Options& options) {
+
+    Result result;
+    result.kernel = &kernel;
+
+    long n = 1024;
+    while (timeKernel(kernel, in, n) < options.minTime && n < (1L << 40)) n *= 2;
+    result.ops = n;
+
+    for (int r=0; r<options.repeats; r++) {
+      result.nsPerOp.push_back(1e9*timeKernel(kernel, in, n)/n);
+    }
+
+    std::vector<double> sorted(result.nsPerOp);
+    std::sort(sorted.begin(), sorted.end());
+    result.median = sorted[sorted.size()/2];
+    result.min = sorted.front();
+    result.relSpread = result.median > 0.0 ? (sorted.back()-sorted.front())/result.median : 0.0;
+
+    return result;
+
+  }
+
+  void writeJSON(const std::vector<Result>& results, const Options& options) {
+
+    std::ofstream output(options.jsonFile.c_str());
+    if (!output) {
+      std::cerr << "Can not write " << options.jsonFile << std::endl;
+      return;
+    }
+
+    output.precision(6);
+    output << "{\n  \"repeats\": " << options.repeats
+	   << ",\n  \"minTime\": " << options.minTime
+	   << ",\n  \"kernels\": [";
+
+    for (std::size_t k=0; k<results.size(); k++) {
+      const Result& result = results[k];
+      output << (k == 0 ? "\n" : ",\n")
+	     << "    {\"name\": " << EvtReportUtils::jsonString(result.kernel->name)
+	     << ", \"description\": " << EvtReportUtils::jsonString(result.kernel->description)
+	     << ", \"ops\": " << result.ops
+	     << ", \"nsPerOp\": {\"median\": " << result.median
+	     << ", \"min\": " << result.min
+	     << ", \"relSpread\": " << result.relSpread << ", \"repeats\": [";
+      for (std::size_t r=0; r<result.nsPerOp.size(); r++) {
+	output << (r == 0 ? "" : ", ") << result.nsPerOp[r];
+      }
+      output << "]}}";
+    }
+
+    output << "\n  ]\n}\n";
+
+  }
+
+  void usage() {
+    std::cout <<
+      "Usage: evtgen_microbench [options]\n"
+      "  --repeats N     timed repeats per kernel (default 7)\n"
+      "  --min-time S    minimum seconds per repeat (default 0.05)\n"
+      "  --only NAME     run only this kernel or group of kernels (the part\n"
+      "                  of the name before the dot); may be given several times\n"
+      "  --json FILE     also write the results as JSON\n"
+      "Kernels:\n";
+    for (int i=0; i<nKernels; i++) {
+      std::cout << "  " << std::setw(24) << std::left << kernels[i].name
+		<< std::right << kernels[i].description << "\n";
+    }
+  }
+
+  std::string stringArgument(int& i, int argc, char** argv) {
+    if (i+1 >= argc) {
+      std::cerr << argv[i] << " needs a value" << std::endl;
+      std::exit(1);
+    }
+    return argv[++i];
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  Options options;
+  options.repeats = 7;
+  options.minTime = 0.05;
+
+  for (int i=1; i<argc; i++) {
+    std::string arg(argv[i]);
+    if (arg == "--repeats") options.repeats = std::atoi(stringArgument(i, argc, argv).c_str());
+    else if (arg == "--min-time") options.minTime = std::atof(stringArgument(i, argc, argv).c_str());
+    else if (arg == "--only") options.only.push_back(stringArgument(i, argc, argv));
+    else if (arg == "--json") options.jsonFile = stringArgument(i, argc, argv);
+    else if (arg == "--help" || arg == "-h") {
+      usage();
+      return 0;
+    } else {
+      std::cerr << "Unknown option " << arg << std::endl;
+      usage();
+      return 1;
+    }
+  }
+
+  if (options.repeats < 1 || options.minTime <= 0.0) {
+    std::cerr << "Need at least one repeat and a positive --min-time" << std::endl;
+    return 1;
+  }
+
+  for (std::size_t i=0; i<options.only.size(); i++) {
+    bool known(false);
+    for (int k=0; k<nKernels; k++) {
+      Options single;
+      single.only.push_back(options.only[i]);
+      if (selected(kernels[k], single)) known = true;
+    }
+    if (!known) {
+      std::cerr << "Unknown kernel " << options.only[i] << std::endl;
+      return 1;
+    }
+  }
+
+  Inputs* inputs = new Inputs;
+  fillInputs(*inputs);
+
+  std::cout << "evtgen_microbench: " << options.repeats << " repeats of at least "
+	    << options.minTime << " s per kernel\n\n";
+  std::cout << "  kernel                      ns/op     min  spread%  operation\n";
+
+  std::vector<Result> results;
+
+  for (int k=0; k<nKernels; k++) {
+    if (!selected(kernels[k], options)) continue;
+    Result result = runKernel(kernels[k], *inputs, options);
+    results.push_back(result);
+    std::cout << "  " << std::setw(24) << std::left << result.kernel->name << std::right
+	      << std::fixed << std::setprecision(2)
+	      << std::setw(9) << result.median
+	      << std::setw(8) << result.min
+	      << std::setw(9) << std::setprecision(1) << 100.0*result.relSpread
+	      << "  " << result.kernel->description << std::endl;
+  }
+
+  std::cout << "\n(checksum " << std::setprecision(3) << sink << ")" << std::endl;
+
+  if (!options.jsonFile.empty()) writeJSON(results, options);
+
+  delete inputs;
+
+  return 0;
+
+}
@@ -16,6 +16,12 @@
 //
 //    RYD     March 24, 1998        Module created
 //    JBack   June 2011             Added HepMC event interface
+//            Oct 2026              Generator state held in an EvtGenContext
+//            Oct 2026              Read and write the probmax cache
+//            Oct 2026              Precompiled decay table images
+//            Oct 2026              Startup profile
+//            Oct 2026              Run statistics of the decay channels
+//            Oct 2026              Workers clone the extra models
 //
 //------------------------------------------------------------------------
 // 
@@ -25,6 +31,8 @@
 #include "EvtGenBase/EvtVector4R.hh"
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtDecayBase.hh"
+#include "EvtGenBase/EvtDecayImage.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtRandom.hh"
@@ -37,6 +45,10 @@
 #include "EvtGenBase/EvtRadCorr.hh"
 #include "EvtGenBase/EvtCPUtil.hh"
 #include "EvtGenBase/EvtHepMCEvent.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
+#include "EvtGenBase/EvtDecayStats.hh"
+#include "EvtGenBase/EvtTaskPool.hh"
 
 #include "EvtGenModels/EvtNoRadCorr.hh"
 
@@ -44,6 +56,11 @@
 #include <fstream>
 #include <string>
 
+#ifdef EVTGEN_CPP11
+#include <condition_variable>
+#include <mutex>
+#endif
+
 using std::endl;
 using std::fstream;
 using std::ifstream;
@@ -56,9 +73,19 @@ EvtGen::~EvtGen(){
   //the destruction of objects that it depends on, e.g., EvtPDL.
 
   if (getenv("EVTINFO")){
+    EvtGenContext::Scope scope(_context);
     EvtDecayTable::getInstance()->printSummary();
   }
 
+  deleteWorkers();
+
+  delete _context;
+
+  std::list<EvtDecayBase*>::iterator it;
+  for (it=_ownedModels.begin();it!=_ownedModels.end();++it){
+    delete *it;
+  }
+
 }
 
 EvtGen::EvtGen(const char* const decayName,
@@ -66,14 +93,37 @@ EvtGen::EvtGen(const char* const decayName,
 	       EvtRandomEngine* randomEngine,
 	       EvtAbsRadCorr* isrEngine,
 	       const std::list<EvtDecayBase*>* extraModels,
-	       int mixingType, bool useXml){
+	       int mixingType, bool useXml) :
+  _decayName(decayName),
+  _pdtTableName(pdtTableName),
+  _isrEngine(isrEngine),
+  _useXml(useXml),
+  _runNumber(0),
+  _nextEvent(0)
+{
+
+  if (extraModels!=0) _extraModels = *extraModels;
 
 
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "Initializing EvtGen"<<endl;
 
+  // All of the generator state set up below goes into our own context,
+  // which stays bound to the constructing thread so that the static
+  // accessors keep working for code that drives a single generator.
+  // The switches set before the constructor are taken over from the
+  // context bound so far.
+  EvtGenContext* creator = EvtGenContext::current();
+  _context = new EvtGenContext();
+  _context->setLazyInit(creator->getLazyInit());
+  _context->setStartupProfileEnabled(creator->isStartupProfileEnabled());
+  _context->setDecayTiming(creator->isDecayTiming());
+  _context->setHelAmpCheck(creator->getHelAmpCheck());
+  EvtGenContext::setCurrent(_context);
+
+  EvtStartupProfile::Phase constructor("EvtGen::EvtGen");
+
   if (randomEngine==0){
-    static EvtSimpleRandomEngine defaultRandomEngine;
-    EvtRandom::setRandomEngine(&defaultRandomEngine);
+    _context->adoptRandomEngine(new EvtSimpleRandomEngine());
     EvtGenReport(EVTGEN_INFO,"EvtGen") <<"No random engine given in "
 			  <<"EvtGen::EvtGen constructor, "
 			  <<"will use default EvtSimpleRandomEngine."<<endl;
@@ -83,17 +133,37 @@ EvtGen::EvtGen(const char* const decayName,
   }
 
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "Storing known decay models"<<endl;
-  EvtModelReg dummy(extraModels);
+  {
+    EvtStartupProfile::Phase registration("model registration");
+    EvtModelReg dummy(extraModels);
+  }
 
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "Main decay file name  :"<<decayName<<endl;
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "PDT table file name   :"<<pdtTableName<<endl;
   
-  _pdl.readPDT(pdtTableName);
+  if (EvtDecayImage::isImage(decayName)) {
+
+    // Holds the particle properties as well
+    EvtStartupProfile::Phase image("decay image",decayName);
+    EvtDecayImage::read(decayName,false);
 
-  if(useXml) {
-    EvtDecayTable::getInstance()->readXMLDecayFile(decayName,false);
   } else {
-    EvtDecayTable::getInstance()->readDecayFile(decayName,false);
+
+    // The particle properties are shared by all generators in the process.
+    if (EvtPDL::entries()==0) {
+      _pdl.readPDT(pdtTableName);
+    } else {
+      EvtGenReport(EVTGEN_INFO,"EvtGen") << "Particle properties already loaded, "
+					 << "not reading "<<pdtTableName<<endl;
+    }
+
+    EvtStartupProfile::Phase decayFile("decay file",decayName);
+    if(useXml) {
+      EvtDecayTable::getInstance()->readXMLDecayFile(decayName,false);
+    } else {
+      EvtDecayTable::getInstance()->readDecayFile(decayName,false);
+    }
+
   }
 
   _mixingType = mixingType;
@@ -110,8 +180,7 @@ EvtGen::EvtGen(const char* const decayName,
 
     // Owing to the pure abstract interface, we still need to define a concrete 
     // implementation of a radiative correction engine. Use one which does nothing.
-    EvtAbsRadCorr* noRadCorr = new EvtNoRadCorr();
-    EvtRadCorr::setRadCorrEngine(noRadCorr);
+    _context->adoptRadCorrEngine(new EvtNoRadCorr());
 
   }
 
@@ -122,6 +191,16 @@ EvtGen::EvtGen(const char* const decayName,
 
 void EvtGen::readUDecay(const char* const uDecayName, bool useXml){
 
+  EvtGenContext::Scope scope(_context);
+
+  if (uDecayName[0] != 0) {
+    _userDecayFiles.push_back(std::make_pair(std::string(uDecayName), useXml));
+  }
+
+  for (size_t i=0;i<_workers.size();i++){
+    _workers[i]->readUDecay(uDecayName, useXml);
+  }
+
   ifstream indec;
 
   if ( uDecayName[0] == 0) {
@@ -130,6 +209,7 @@ void EvtGen::readUDecay(const char* const uDecayName, bool useXml){
   else{  
     indec.open(uDecayName);
     if (indec) {
+      EvtStartupProfile::Phase decayFile("user decay file",uDecayName);
       if(useXml) {
         EvtDecayTable::getInstance()->readXMLDecayFile(uDecayName,true);
       } else {
@@ -150,6 +230,8 @@ EvtHepMCEvent* EvtGen::generateDecay(int PDGId, EvtVector4R refFrameP4,
 				     EvtVector4R translation,
 				     EvtSpinDensity* spinDensity) {
 
+  EvtGenContext::Scope scope(_context);
+
   EvtParticle* theParticle(0);
 
   if (spinDensity == 0 ){
@@ -172,6 +254,8 @@ EvtHepMCEvent* EvtGen::generateDecay(int PDGId, EvtVector4R refFrameP4,
 
 void EvtGen::generateDecay(EvtParticle *p){
 
+  EvtGenContext::Scope scope(_context);
+
   int times=0;
   do{
     times+=1;
@@ -201,3 +285,247 @@ void EvtGen::generateDecay(EvtParticle *p){
   } while (times);
 
 }
+
+void EvtGen::deleteWorkers(){
+
+  for (size_t i=0;i<_workers.size();i++){
+    delete _workers[i];
+  }
+  _workers.clear();
+
+}
+
+void EvtGen::setWorkers(const std::vector<EvtRandomEngine*>& randomEngines,
+			const std::vector<EvtAbsRadCorr*>* isrEngines){
+
+  if (isrEngines!=0 && isrEngines->size()!=randomEngines.size()){
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Need one radiative correction engine "
+			   <<"per random engine in EvtGen::setWorkers."<<endl;
+    ::abort();
+  }
+
+#ifndef EVTGEN_CPP11
+  EvtGenReport(EVTGEN_WARNING,"EvtGen") << "Worker threads need c++11, "
+			   <<"generateDecays will run serially."<<endl;
+#endif
+
+  deleteWorkers();
+
+  // The worker constructors bind their own contexts; restore ours after.
+  EvtGenContext::Scope scope(_context);
+
+  for (size_t i=0;i<randomEngines.size();i++){
+
+    EvtAbsRadCorr* isrEngine = isrEngines!=0 ? (*isrEngines)[i] : _isrEngine;
+
+    // Commands in the decay files are stored in the model prototypes,
+    // so every worker registers its own clones of the extra models.
+    std::list<EvtDecayBase*> workerModels;
+    std::list<EvtDecayBase*>::const_iterator it;
+    for (it=_extraModels.begin();it!=_extraModels.end();++it){
+      workerModels.push_back((*it)->clone());
+    }
+
+    EvtGen* worker = new EvtGen(_decayName.c_str(), _pdtTableName.c_str(),
+				randomEngines[i], isrEngine, &workerModels,
+				_mixingType, _useXml);
+    worker->_ownedModels = workerModels;
+
+    for (size_t j=0;j<_userDecayFiles.size();j++){
+      worker->readUDecay(_userDecayFiles[j].first.c_str(),
+			 _userDecayFiles[j].second);
+    }
+
+    worker->getContext()->setRandomBufferSize(_context->getRandomBufferSize());
+    worker->getContext()->setPhaseSpaceBatchSize(_context->getPhaseSpaceBatchSize());
+    worker->getContext()->setLazyInit(_context->getLazyInit());
+    worker->getContext()->setStartupProfileEnabled(_context->isStartupProfileEnabled());
+    worker->getContext()->setDecayTiming(_context->isDecayTiming());
+    worker->getContext()->setHelAmpCheck(_context->getHelAmpCheck());
+    worker->getContext()->getProbMaxCache() = _context->getProbMaxCache();
+
+    _workers.push_back(worker);
+
+  }
+
+  EvtGenReport(EVTGEN_INFO,"EvtGen") << "Created "<<_workers.size()
+			<<" worker generators"<<endl;
+
+}
+
+bool EvtGen::writeDecayImage(const std::string& fileName){
+
+  EvtGenContext::Scope scope(_context);
+
+  return EvtDecayImage::write(fileName);
+
+}
+
+const EvtStartupProfile& EvtGen::getStartupProfile() const{
+
+  return _context->getStartupProfile();
+
+}
+
+bool EvtGen::readProbMaxCache(const std::string& fileName){
+
+  EvtProbMaxCache& cache = _context->getProbMaxCache();
+
+  if (!cache.read(fileName)) return false;
+
+  for (size_t i=0;i<_workers.size();i++){
+    _workers[i]->getContext()->getProbMaxCache() = cache;
+  }
+
+  return true;
+
+}
+
+bool EvtGen::writeProbMaxCache(const std::string& fileName){
+
+  EvtProbMaxCache cache(_context->getProbMaxCache());
+
+  cache.collect(_context->getDecayTable());
+
+  for (size_t i=0;i<_workers.size();i++){
+    cache.collect(_workers[i]->getContext()->getDecayTable());
+  }
+
+  return cache.write(fileName);
+
+}
+
+EvtDecayStats EvtGen::getDecayStats(){
+
+  EvtDecayStats stats;
+
+  stats.collect(_context->getDecayTable());
+
+  for (size_t i=0;i<_workers.size();i++){
+    stats.collect(_workers[i]->getContext()->getDecayTable());
+  }
+
+  return stats;
+
+}
+
+bool EvtGen::writeDecayStats(const std::string& fileName){
+
+  return getDecayStats().writeJSON(fileName);
+
+}
+
+namespace {
+
+  EvtParticle* makeParent(EvtId id, const EvtVector4R& p4,
+			  const EvtSpinDensity* spinDensity){
+
+    if (spinDensity==0) return EvtParticleFactory::particleFactory(id, p4);
+    return EvtParticleFactory::particleFactory(id, p4, *spinDensity);
+
+  }
+
+#ifdef EVTGEN_CPP11
+
+  // Makes one decay per task on the worker generators and hands the
+  // finished trees back to the thread which waits for them in order.
+  class EvtDecayTask : public EvtTaskPool::Task {
+
+  public:
+
+    EvtDecayTask(const std::vector<EvtGen*>& workers, EvtId id,
+		 const EvtVector4R* momenta, const EvtSpinDensity* spinDensity,
+		 int nEvents, uint32_t run, uint64_t firstEvent) :
+      _workers(workers), _id(id), _momenta(momenta),
+      _spinDensity(spinDensity), _results(nEvents, (EvtParticle*)0),
+      _run(run), _firstEvent(firstEvent) {}
+
+    void run(int iTask, int iWorker) {
+
+      EvtGen* worker = _workers[iWorker];
+      EvtGenContext::Scope scope(worker->getContext());
+      worker->getContext()->setRandomStream(_run, _firstEvent+iTask);
+
+      EvtParticle* p = makeParent(_id, _momenta[iTask], _spinDensity);
+      worker->generateDecay(p);
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      _results[iTask] = p;
+      _done.notify_all();
+
+    }
+
+    EvtParticle* waitFor(int iTask) {
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      while (_results[iTask]==0) _done.wait(lock);
+      return _results[iTask];
+
+    }
+
+  private:
+
+    const std::vector<EvtGen*>& _workers;
+    EvtId _id;
+    const EvtVector4R* _momenta;
+    const EvtSpinDensity* _spinDensity;
+
+    std::vector<EvtParticle*> _results;
+    uint32_t _run;
+    uint64_t _firstEvent;
+    std::mutex _mutex;
+    std::condition_variable _done;
+
+  };
+
+#endif
+
+}
+
+void EvtGen::setEventNumber(uint32_t run, uint64_t firstEvent){
+
+  _runNumber = run;
+  _nextEvent = firstEvent;
+
+}
+
+void EvtGen::generateDecays(int PDGId, const EvtVector4R* momenta, int nEvents,
+			    DecayCallback& callback,
+			    EvtSpinDensity* spinDensity){
+
+  EvtGenContext::Scope scope(_context);
+
+  EvtId id = EvtPDL::evtIdFromStdHep(PDGId);
+
+  uint64_t firstEvent = _nextEvent;
+  _nextEvent += nEvents;
+
+#ifdef EVTGEN_CPP11
+  if (!_workers.empty()) {
+
+    EvtDecayTask task(_workers, id, momenta, spinDensity, nEvents,
+		      _runNumber, firstEvent);
+    EvtTaskPool pool(_workers.size());
+    pool.start(task, nEvents);
+
+    for (int i=0;i<nEvents;i++){
+      EvtParticle* p = task.waitFor(i);
+      callback.decayDone(i, p);
+      p->deleteTree();
+    }
+
+    pool.wait();
+    return;
+
+  }
+#endif
+
+  for (int i=0;i<nEvents;i++){
+    _context->setRandomStream(_runNumber, firstEvent+i);
+    EvtParticle* p = makeParent(id, momenta[i], spinDensity);
+    generateDecay(p);
+    callback.decayDone(i, p);
+    p->deleteTree();
+  }
+
+}
@@ -0,0 +1,99 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtAliasTable
+//
+// Description: Walker alias table, see EvtAliasTable.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtAliasTable.hh"
+
+#include <cstddef>
+
+EvtAliasTable::EvtAliasTable(const std::vector<double>& weights) {
+
+  build(weights);
+
+}
+
+void EvtAliasTable::build(const std::vector<double>& weights) {
+
+  _prob.clear();
+  _alias.clear();
+
+  int n = weights.size();
+
+  double total(0.0);
+  int largest(-1);
+  for (int i=0; i<n; i++) {
+    if (weights[i] <= 0.0) continue;
+    total += weights[i];
+    if (largest < 0 || weights[i] > weights[largest]) largest = i;
+  }
+
+  if (total <= 0.0) return;
+
+  _prob.resize(n);
+  _alias.resize(n);
+
+  // Scale the weights to an average of one and pair each entry below
+  // one with an entry above it, which fills up the rest of its column.
+  std::vector<double> scaled(n);
+  std::vector<int> small;
+  std::vector<int> large;
+
+  for (int i=0; i<n; i++) {
+    scaled[i] = weights[i] > 0.0 ? weights[i]*n/total : 0.0;
+    _alias[i] = i;
+    if (scaled[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  while (!small.empty() && !large.empty()) {
+
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+
+    _prob[s] = scaled[s];
+    _alias[s] = l;
+
+    scaled[l] = (scaled[l]+scaled[s])-1.0;
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+
+  }
+
+  // What is left over is one up to rounding, except that an entry with
+  // zero weight must still never be picked.
+  for (std::size_t i=0; i<large.size(); i++) {
+    _prob[large[i]] = 1.0;
+  }
+  for (std::size_t i=0; i<small.size(); i++) {
+    int s = small[i];
+    if (weights[s] > 0.0) {
+      _prob[s] = 1.0;
+    } else {
+      _prob[s] = 0.0;
+      _alias[s] = largest;
+    }
+  }
+
+}
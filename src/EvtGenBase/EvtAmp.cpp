@@ -15,6 +15,8 @@
 // Modification history:
 //
 //    RYD     May 29, 1997         Module created
+//            Oct 2026             Contractions use strided kernels
+//                                 specialised on the number of states
 //
 //------------------------------------------------------------------------
 // 
@@ -32,6 +34,100 @@
 using std::endl;
 
 
+namespace {
+
+  // The amplitudes are stored with the first nontrivial index running
+  // fastest, so for the k:th index they form a block
+  // amp[in+nInner*(i+n*out)], where i<n runs over the states of index k
+  // and in<nInner, out<nOuter over the indices before and after it.
+  // N>0 fixes n at compile time, so that the loops over the states are
+  // unrolled for the common spins; N==0 takes any n up to maxDim.
+  // The sums are formed in the same order as the index loops they
+  // replace, so the results are unchanged.
+
+  const int maxDim = EvtSpinDensity::maxDim;
+
+  // result_i = sum_j rho(j,i) amp_j
+  template <int N>
+  void contractDensity(const EvtComplex* amp, const EvtSpinDensity& rho,
+		       EvtComplex* result, int nStates, int nInner, int nOuter){
+
+    const int n = N>0 ? N : nStates;
+    EvtComplex v[N>0 ? N : maxDim];
+
+    for (int out=0; out<nOuter; out++) {
+      const EvtComplex* a = amp + nInner*n*out;
+      EvtComplex* r = result + nInner*n*out;
+      for (int in=0; in<nInner; in++) {
+	for (int j=0; j<n; j++) v[j] = a[in+nInner*j];
+	for (int i=0; i<n; i++) {
+	  EvtComplex c(0.0);
+	  for (int j=0; j<n; j++) c += rho.get(j,i)*v[j];
+	  r[in+nInner*i] = c;
+	}
+      }
+    }
+
+  }
+
+  // rho(i,j) = sum over the other indices of amp1_i conj(amp2_j)
+  template <int N>
+  void densityMatrix(const EvtComplex* amp1, const EvtComplex* amp2,
+		     EvtSpinDensity& rho, int nStates, int nInner, int nOuter){
+
+    const int n = N>0 ? N : nStates;
+    const int dim = N>0 ? N : maxDim;
+    EvtComplex sum[dim][dim];
+    EvtComplex v1[dim];
+    EvtComplex v2[dim];
+
+    for (int out=0; out<nOuter; out++) {
+      const EvtComplex* a1 = amp1 + nInner*n*out;
+      const EvtComplex* a2 = amp2 + nInner*n*out;
+      for (int in=0; in<nInner; in++) {
+	for (int i=0; i<n; i++) {
+	  v1[i] = a1[in+nInner*i];
+	  v2[i] = conj(a2[in+nInner*i]);
+	}
+	for (int i=0; i<n; i++) {
+	  for (int j=0; j<n; j++) sum[i][j] += v1[i]*v2[j];
+	}
+      }
+    }
+
+    rho.setDim(n);
+    for (int i=0; i<n; i++) {
+      for (int j=0; j<n; j++) rho.set(i,j,sum[i][j]);
+    }
+
+  }
+
+  void contractDensity(const EvtComplex* amp, const EvtSpinDensity& rho,
+		       EvtComplex* result, int n, int nInner, int nOuter){
+
+    switch (n) {
+    case 2: contractDensity<2>(amp,rho,result,n,nInner,nOuter); break;
+    case 3: contractDensity<3>(amp,rho,result,n,nInner,nOuter); break;
+    case 4: contractDensity<4>(amp,rho,result,n,nInner,nOuter); break;
+    default: contractDensity<0>(amp,rho,result,n,nInner,nOuter); break;
+    }
+
+  }
+
+  void densityMatrix(const EvtComplex* amp1, const EvtComplex* amp2,
+		     EvtSpinDensity& rho, int n, int nInner, int nOuter){
+
+    switch (n) {
+    case 2: densityMatrix<2>(amp1,amp2,rho,n,nInner,nOuter); break;
+    case 3: densityMatrix<3>(amp1,amp2,rho,n,nInner,nOuter); break;
+    case 4: densityMatrix<4>(amp1,amp2,rho,n,nInner,nOuter); break;
+    default: densityMatrix<0>(amp1,amp2,rho,n,nInner,nOuter); break;
+    }
+
+  }
+
+}
+
 
 EvtAmp::EvtAmp(){
   _ndaug=0;
@@ -120,6 +216,16 @@ void EvtAmp::setNState(int parent_states,int *daug_states){
 
 }
 
+void EvtAmp::getStrides(int k,int& nInner,int& nOuter) const{
+
+  nInner=1;
+  for (int i=0;i<k;i++) nInner*=_nstate[i];
+
+  nOuter=1;
+  for (int i=k+1;i<_nontrivial;i++) nOuter*=_nstate[i];
+
+}
+
 void EvtAmp::setAmp(int *ind, const EvtComplex& a){
 
   int nstatepad = 1;
@@ -155,7 +261,7 @@ EvtSpinDensity EvtAmp::getSpinDensity(){
 
   EvtComplex temp;
 
-  int i,j,n;
+  int i,n;
 
   if (_pstates==1) {
 
@@ -186,29 +292,11 @@ EvtSpinDensity EvtAmp::getSpinDensity(){
 
   else{
 
-    for(i=0;i<_pstates;i++){
-      for(j=0;j<_pstates;j++){
-
-        temp = EvtComplex(0.0);
-
-	int kk;
-
-        int allloop = 1;
-        for (kk=0;kk<_ndaug; kk++ ) {
-	  allloop *= dstates[kk];
-	}
-        
-        for (kk=0; kk<allloop; kk++) {
-	  temp += _amp[_pstates*kk+i]*conj(_amp[_pstates*kk+j]);}
-
-	//        if (_nontrivial>3){
-	//EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can't handle so many states in EvtAmp!"<<endl;
-	//}
-        
-        rho.set(i,j,temp);
+    // The parent is the first nontrivial index
+    int nInner,nOuter;
+    getStrides(0,nInner,nOuter);
+    densityMatrix(_amp,_amp,rho,_pstates,nInner,nOuter);
 
-      }
-    }
     return rho; 
   }
 
@@ -284,7 +372,7 @@ EvtAmp EvtAmp::contract(int k,const EvtSpinDensity& rho){
 
   EvtAmp temp;
   
-  int i,j;
+  int i;
   temp._ndaug=_ndaug;
   temp._pstates=_pstates;
   temp._nontrivial=_nontrivial;
@@ -303,46 +391,12 @@ EvtAmp EvtAmp::contract(int k,const EvtSpinDensity& rho){
     temp._nstate[i]=_nstate[i];
   }
 
+  if (_nontrivial==0) return temp;
 
-  EvtComplex c;
-
-  int index[10];
-  for (i=0;i<10;i++) {
-     index[i] = 0;
-  }
-
-  int allloop = 1;
-  int indflag,ii;
-  for (i=0;i<_nontrivial;i++) {
-     allloop *= _nstate[i];
-  }
-
-  for ( i=0;i<allloop;i++) {
-
-     c = EvtComplex(0.0);
-     int tempint = index[k];
-     for (j=0;j<_nstate[k];j++) {
-       index[k] = j;
-       c+=rho.get(j,tempint)*getAmp(index);
-     }
-     index[k] = tempint;
-       
-     temp.setAmp(index,c);
-
-     indflag = 0;
-     for ( ii=0;ii<_nontrivial;ii++) {
-       if ( indflag == 0 ) {
-	 if ( index[ii] == (_nstate[ii]-1) ) {
-	   index[ii] = 0;
-	 }
-	 else {
-	   indflag = 1;
-	   index[ii] += 1;
-	 }
-       }
-     }
+  int nInner,nOuter;
+  getStrides(k,nInner,nOuter);
+  contractDensity(_amp,rho,temp._amp,_nstate[k],nInner,nOuter);
 
-  }
   return temp;
 
 }
@@ -350,64 +404,19 @@ EvtAmp EvtAmp::contract(int k,const EvtSpinDensity& rho){
 
 EvtSpinDensity EvtAmp::contract(int k,const EvtAmp& amp2){
 
-  int i,j,l;
-
-  EvtComplex temp;
   EvtSpinDensity rho;
 
-  rho.setDim(_nstate[k]);
-
-  int allloop = 1;
-  int indflag,ii;
-  for (i=0;i<_nontrivial;i++) {
-     allloop *= _nstate[i];
+  if (_nontrivial==0) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"Should not be here1 EvtAmp!"<<endl;
+    rho.setDim(1);
+    rho.set(0,0,EvtComplex(1.0,0.0)); 
+    return rho;
   }
 
-  int index[10];
-  int index1[10];
-  //  int l;
-  for(i=0;i<_nstate[k];i++){
-
-    for(j=0;j<_nstate[k];j++){
-      if (_nontrivial==0) {
-	EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"Should not be here1 EvtAmp!"<<endl;
-        rho.set(0,0,EvtComplex(1.0,0.0)); 
-        return rho;
-      }
-
-      for (ii=0;ii<10;ii++) {
-	index[ii] = 0;
-	index1[ii] = 0;
-      }
-      index[k] = i;
-      index1[k] = j;
-
-      temp = EvtComplex(0.0);
-
-      for ( l=0;l<int(allloop/_nstate[k]);l++) {
-
-	temp+=getAmp(index)*conj(amp2.getAmp(index1));
-	indflag = 0;
-	for ( ii=0;ii<_nontrivial;ii++) {
-          if ( ii!= k) {
-	    if ( indflag == 0 ) {
-	      if ( index[ii] == (_nstate[ii]-1) ) {
-		index[ii] = 0;
-		index1[ii] = 0;
-	      }
-	      else {
-		indflag = 1;
-		index[ii] += 1;
-		index1[ii] += 1;
-	      }
-	    }
-	  }
-	}
-      }
-      rho.set(i,j,temp);
-      
-    }
-  }
+  // amp2 has the same layout as this amplitude
+  int nInner,nOuter;
+  getStrides(k,nInner,nOuter);
+  densityMatrix(_amp,amp2._amp,rho,_nstate[k],nInner,nOuter);
 
   return rho;
 }
@@ -27,6 +27,7 @@
 #include "EvtGenBase/EvtScalarParticle.hh"
 #include "EvtGenBase/EvtRandom.hh"
 #include "EvtGenBase/EvtCPUtil.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtSymTable.hh"
@@ -47,13 +48,7 @@ EvtCPUtil::~EvtCPUtil() {
 
 EvtCPUtil* EvtCPUtil::getInstance() {
 
-  static EvtCPUtil* theCPUtil = 0;
-
-  if (theCPUtil == 0) {
-    theCPUtil = new EvtCPUtil(1);
-  }
-
-  return theCPUtil;
+  return EvtGenContext::current()->getCPUtil();
 
 }
 
@@ -160,7 +155,11 @@ void EvtCPUtil::OtherB( EvtParticle *p,double &t, EvtId &otherb, double probB0){
 void EvtCPUtil::OtherCoherentB( EvtParticle *p,double &t, EvtId &otherb, double probB0){
 
   //Can not call this recursively!!!
+#ifdef EVTGEN_CPP11
+  thread_local int entryCount=0;
+#else
   static int entryCount=0;
+#endif
   entryCount++;
 
   //added by Lange Jan4,2000
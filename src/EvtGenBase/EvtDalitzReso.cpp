@@ -810,8 +810,8 @@ EvtComplex EvtDalitzReso::Fvector( double s, int index )
 
   //This is not correct!
   //(1-ipK) != (1-iKp)
-  static EvtMatrix< EvtComplex > mat;
-  mat.setRange( 5 ); // Try to do in only the first time. DEFINE ALLOCATION IN CONSTRUCTOR.
+  EvtMatrix< EvtComplex > mat;
+  mat.setRange( 5 );
 
   for ( int row = 0; row < 5; row++ )
     for ( int col = 0; col < 5; col++ )
@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    DJL/RYD     August 11, 1998         Module created
+//                Oct 2026                Count and time the tries
 //
 //------------------------------------------------------------------------
 #include "EvtGenBase/EvtPatches.hh"
@@ -44,11 +45,13 @@ void EvtDecayAmp::makeDecay(EvtParticle* p, bool recursive){
 
   _amp2.init(p->getId(),getNDaug(),getDaugs());
 
+  startDecay();
+
   do{
 
     _daugsDecayedByParentModel=false;
     _weight = 1.0;
-    decay(p);
+    tryDecay(p);
 
     rho=_amp2.getSpinDensity();
 
@@ -124,6 +127,7 @@ void EvtDecayAmp::makeDecay(EvtParticle* p, bool recursive){
   }while(ntimes&&more);
 
   if (ntimes==0){
+    countExhausted();
     EvtGenReport(EVTGEN_DEBUG,"EvtGen") << "Tried accept/reject: 10000" 
 			   <<" times, and rejected all the times!"<<endl;
    
@@ -15,6 +15,10 @@
 // Modification history:
 //
 //    RYD     September 30, 1997         Module created
+//            Oct 2026                   Probmax from EvtProbMaxCache
+//            Oct 2026                   Optional lazy initialisation
+//            Oct 2026                   Startup profile of the model inits
+//            Oct 2026                   Run statistics, see EvtDecayStats
 //
 //------------------------------------------------------------------------
 //
@@ -29,9 +33,41 @@
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtSpinType.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtProbMaxCache.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
+#include "EvtGenBase/EvtDecayStats.hh"
+#include "EvtGenBase/EvtReportUtils.hh"
 #include <vector>
+
+#ifdef EVTGEN_CPP11
+#include <mutex>
+#endif
+
 using std::endl;
 using std::fstream;
+
+namespace {
+
+#ifdef EVTGEN_CPP11
+  // One lock for all deferred initialisations; recursive since the init
+  // of a model may look up (and so initialise) other models.
+  std::recursive_mutex& initMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+  }
+#endif
+
+}
+
+void EvtDecayBase::setLazyInit(bool lazy) {
+  EvtGenContext::current()->setLazyInit(lazy);
+}
+
+bool EvtDecayBase::getLazyInit() {
+  return EvtGenContext::current()->getLazyInit();
+}
+
 void EvtDecayBase::checkQ() {
   int i;
   int q=0;
@@ -73,7 +109,13 @@ double EvtDecayBase::getProbMax( double prob ) {
   if (prob>max_prob) max_prob=prob;
 
 
-  if ( defaultprobmax && ntimes_prob<=500 ) { 
+  //Start from the maximum of an earlier job if there is one
+  if ( defaultprobmax && ntimes_prob==0 && !_probMaxCached ) {
+    _probMaxCached =
+      EvtGenContext::current()->getProbMaxCache().get(getProbMaxKey(),probmax);
+  }
+
+  if ( defaultprobmax && !_probMaxCached && ntimes_prob<=500 ) { 
     //We are building up probmax with this iteration
      ntimes_prob += 1;
      if ( prob > probmax ) { probmax = prob;}
@@ -94,6 +136,7 @@ double EvtDecayBase::getProbMax( double prob ) {
     EvtGenReport(EVTGEN_INFO,"") << endl;
 
     if (defaultprobmax) probmax = prob;
+    _probMaxOverruns++;
 
   }
 
@@ -120,12 +163,45 @@ double EvtDecayBase::resetProbMax(double prob) {
   probmax = 0.0;
   defaultprobmax = 0;
   ntimes_prob = 0;
+  _probMaxCached = false;
   
   return prob;
 
 }
 
 
+std::string EvtDecayBase::getProbMaxKey() const {
+
+  std::string key(_modelname);
+  key += " ";
+  key += EvtPDL::name(_parent);
+  key += " ->";
+  for(int i=0;i<_ndaug;i++){
+    key += " ";
+    key += EvtPDL::name(_daug[i]);
+  }
+  key += " ;";
+  for(int i=0;i<_narg;i++){
+    key += " ";
+    key += _args[i];
+  }
+
+  return key;
+
+}
+
+
+bool EvtDecayBase::getLearnedProbMax(double& prob) const {
+
+  if ( !defaultprobmax ) return false;
+  if ( !_probMaxCached && ntimes_prob<500 ) return false;
+
+  prob = probmax;
+  return true;
+
+}
+
+
 std::string EvtDecayBase::commandName(){
   return std::string("");
 }
@@ -231,8 +307,48 @@ void EvtDecayBase::saveDecayInfo(EvtId ipar, int ndaug, EvtId *daug,
 
   _modelname=name;
 
-  this->init();
-  this->initProbMax();
+  _initialised=false;
+  _initStarted=false;
+
+  if (!EvtGenContext::current()->getLazyInit()) {
+    _initStarted=true;
+    initModel();
+    _initialised=true;
+  }
+
+}
+
+void EvtDecayBase::initDeferred() {
+
+#ifdef EVTGEN_CPP11
+  std::lock_guard<std::recursive_mutex> lock(initMutex());
+#endif
+
+  // Also returns if the init of this model is already running further up
+  // the stack of the same thread.
+  if (_initialised || _initStarted) return;
+
+  _initStarted=true;
+  initModel();
+  _initialised=true;
+
+}
+
+void EvtDecayBase::initModel() {
+
+  int i;
+
+  {
+    EvtStartupProfile::Phase phase("model init",_modelname);
+    if (phase.active()) phase.setLabel(getProbMaxKey());
+    this->init();
+  }
+
+  {
+    EvtStartupProfile::Phase phase("model initProbMax",_modelname);
+    if (phase.active()) phase.setLabel(getProbMaxKey());
+    this->initProbMax();
+  }
 
   if (_chkCharge){
     this->checkQ();
@@ -262,6 +378,12 @@ EvtDecayBase::EvtDecayBase() {
   defaultprobmax=1;
   ntimes_prob = 0;
   probmax = 0.0;
+  _probMaxCached = false;
+
+  // Models which never get a decay (the prototypes in EvtModel) have
+  // nothing to initialise.
+  _initialised = true;
+  _initStarted = true;
   
   _photos=0;
   _verbose=0;
@@ -282,6 +404,57 @@ EvtDecayBase::EvtDecayBase() {
   max_prob=0.0;
   sum_prob=0.0;
 
+  _calls=0;
+  _tries=0;
+  _exhausted=0;
+  _massTreeRetries=0;
+  _probMaxOverruns=0;
+  _decaySeconds=0.0;
+
+}
+
+void EvtDecayBase::tryDecay(EvtParticle* p) {
+
+  _tries++;
+
+  if (!EvtDecayStats::isTiming()) {
+    decay(p);
+    return;
+  }
+
+  // The daughters are decayed after the accept/reject, so this is the
+  // time of this channel alone.
+  double start=EvtReportUtils::wallTime();
+  decay(p);
+  _decaySeconds+=EvtReportUtils::wallTime()-start;
+
+}
+
+EvtDecayBase::RunStats EvtDecayBase::getRunStats() const {
+
+  RunStats stats;
+  stats.calls=_calls;
+  stats.tries=_tries;
+  stats.exhausted=_exhausted;
+  stats.massTreeRetries=_massTreeRetries;
+  stats.probMaxOverruns=_probMaxOverruns;
+  stats.decaySeconds=_decaySeconds;
+  stats.probMax=probmax;
+  stats.maxProb=max_prob;
+  stats.sumProb=sum_prob;
+  return stats;
+
+}
+
+void EvtDecayBase::resetRunStats() {
+
+  _calls=0;
+  _tries=0;
+  _exhausted=0;
+  _massTreeRetries=0;
+  _probMaxOverruns=0;
+  _decaySeconds=0.0;
+
 }
 
 
@@ -0,0 +1,651 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtDecayImage
+//
+// Description: Precompiled decay table, see EvtDecayImage.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtDecayImage.hh"
+#include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtDecayBase.hh"
+#include "EvtGenBase/EvtExtGeneratorCommandsTable.hh"
+#include "EvtGenBase/EvtModel.hh"
+#include "EvtGenBase/EvtPDL.hh"
+#include "EvtGenBase/EvtRadCorr.hh"
+#include "EvtGenBase/EvtReport.hh"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define EVTDECAYIMAGE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::endl;
+
+namespace {
+
+  // The file is a Header followed by the sections below, in this order,
+  // each starting on a multiple of 8 bytes, and then the string data.
+
+  const char imageMagic[8] = {'E','v','t','G','e','n','D','T'};
+  const uint32_t imageVersion = 1;
+  const uint32_t imageByteOrder = 0x01020304;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t nPdtEntries;
+    uint32_t nChanges;
+    uint32_t nEntries;
+    uint32_t nLists;
+    uint32_t nModes;
+    uint32_t nDaughters;
+    uint32_t nArgs;
+    uint32_t nCommands;
+    uint32_t nExtCommands;
+    uint32_t nExtFields;
+    uint32_t radCorr;
+    uint32_t pad;
+    uint64_t stringSize;
+    uint64_t fileSize;
+  };
+
+  struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct PdtRecord {
+    StringRef name;
+    int32_t stdhep;
+    int32_t lundkc;
+    int32_t chg3;
+    int32_t spin2;
+    double mass;
+    double width;
+    double maxWidth;
+    double ctau;
+  };
+
+  struct ChangeRecord {
+    int32_t type;
+    int32_t entry[3];
+    int32_t value;
+    int32_t pad;
+    double number;
+    StringRef name;
+  };
+
+  struct ListRecord {
+    int32_t entry;
+    uint32_t firstMode;
+    uint32_t nModes;
+    uint32_t pad;
+    double rawBrfrSum;
+  };
+
+  struct ModeRecord {
+    StringRef model;
+    uint32_t firstDaughter;
+    uint32_t nDaughters;
+    uint32_t firstArg;
+    uint32_t nArgs;
+    uint32_t flags;
+    uint32_t pad;
+    double brfr;
+    double brfrSum;
+    double massMin;
+  };
+
+  struct CommandRecord {
+    StringRef command;
+    StringRef config;
+  };
+
+  struct ExtCommandRecord {
+    StringRef generator;
+    uint32_t firstField;
+    uint32_t nFields;
+  };
+
+  struct ExtFieldRecord {
+    StringRef key;
+    StringRef value;
+  };
+
+  enum {PHOTOS=1, VERBOSE=2, SUMMARY=4};
+  enum {ALWAYSRADCORR=1, NEVERRADCORR=2};
+
+  uint64_t padded(uint64_t size) {return (size+7)&~uint64_t(7);}
+
+  // Offsets of the sections, from the counts in the header
+  struct Layout {
+
+    uint64_t pdt, changes, lists, modes, daughters, args;
+    uint64_t commands, extCommands, extFields, strings, end;
+
+    Layout(const Header& h) {
+      pdt = padded(sizeof(Header));
+      changes = pdt + padded(uint64_t(h.nPdtEntries)*sizeof(PdtRecord));
+      lists = changes + padded(uint64_t(h.nChanges)*sizeof(ChangeRecord));
+      modes = lists + padded(uint64_t(h.nLists)*sizeof(ListRecord));
+      daughters = modes + padded(uint64_t(h.nModes)*sizeof(ModeRecord));
+      args = daughters + padded(uint64_t(h.nDaughters)*sizeof(int32_t));
+      commands = args + padded(uint64_t(h.nArgs)*sizeof(StringRef));
+      extCommands = commands + padded(uint64_t(h.nCommands)*sizeof(CommandRecord));
+      extFields = extCommands + padded(uint64_t(h.nExtCommands)*sizeof(ExtCommandRecord));
+      strings = extFields + padded(uint64_t(h.nExtFields)*sizeof(ExtFieldRecord));
+      end = strings + h.stringSize;
+    }
+
+  };
+
+  class EvtImageWriter {
+
+  public:
+
+    StringRef add(const std::string& s) {
+      StringRef ref;
+      ref.offset = _strings.size();
+      ref.length = s.size();
+      _strings += s;
+      return ref;
+    }
+
+    std::vector<PdtRecord> pdt;
+    std::vector<ChangeRecord> changes;
+    std::vector<ListRecord> lists;
+    std::vector<ModeRecord> modes;
+    std::vector<int32_t> daughters;
+    std::vector<StringRef> args;
+    std::vector<CommandRecord> commands;
+    std::vector<ExtCommandRecord> extCommands;
+    std::vector<ExtFieldRecord> extFields;
+
+    bool write(const std::string& fileName, Header& header) {
+
+      header.nPdtEntries = pdt.size();
+      header.nChanges = changes.size();
+      header.nLists = lists.size();
+      header.nModes = modes.size();
+      header.nDaughters = daughters.size();
+      header.nArgs = args.size();
+      header.nCommands = commands.size();
+      header.nExtCommands = extCommands.size();
+      header.nExtFields = extFields.size();
+      header.stringSize = _strings.size();
+
+      Layout layout(header);
+      header.fileSize = layout.end;
+
+      std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!out) return false;
+
+      out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+      section(out, layout.pdt, pdt);
+      section(out, layout.changes, changes);
+      section(out, layout.lists, lists);
+      section(out, layout.modes, modes);
+      section(out, layout.daughters, daughters);
+      section(out, layout.args, args);
+      section(out, layout.commands, commands);
+      section(out, layout.extCommands, extCommands);
+      section(out, layout.extFields, extFields);
+      padTo(out, layout.strings);
+      out.write(_strings.data(), _strings.size());
+
+      return out.good();
+
+    }
+
+  private:
+
+    void padTo(std::ofstream& out, uint64_t offset) {
+      static const char zeros[8] = {0,0,0,0,0,0,0,0};
+      uint64_t position = out.tellp();
+      if (offset > position) out.write(zeros, offset-position);
+    }
+
+    template <class T>
+    void section(std::ofstream& out, uint64_t offset, const std::vector<T>& records) {
+      padTo(out, offset);
+      if (!records.empty()) {
+	out.write(reinterpret_cast<const char*>(&records[0]), records.size()*sizeof(T));
+      }
+    }
+
+    std::string _strings;
+
+  };
+
+  // Read-only view of an image file, mapped into memory where possible
+  class EvtImageFile {
+
+  public:
+
+    EvtImageFile(const std::string& fileName) : _data(0), _size(0), _mapped(false) {
+
+#ifdef EVTDECAYIMAGE_MMAP
+      int fd = ::open(fileName.c_str(), O_RDONLY);
+      if (fd < 0) return;
+      struct stat info;
+      if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+	void* data = ::mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data != MAP_FAILED) {
+	  _data = static_cast<const char*>(data);
+	  _size = info.st_size;
+	  _mapped = true;
+	}
+      }
+      ::close(fd);
+      if (_mapped) return;
+#endif
+
+      std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+      if (!in) return;
+      in.seekg(0, std::ios::end);
+      std::streamoff size = in.tellg();
+      in.seekg(0, std::ios::beg);
+      if (size <= 0) return;
+      _buffer.resize((size+7)/8);
+      in.read(reinterpret_cast<char*>(&_buffer[0]), size);
+      if (!in) return;
+      _data = reinterpret_cast<const char*>(&_buffer[0]);
+      _size = size;
+
+    }
+
+    ~EvtImageFile() {
+#ifdef EVTDECAYIMAGE_MMAP
+      if (_mapped) ::munmap(const_cast<char*>(_data), _size);
+#endif
+    }
+
+    const char* data() const {return _data;}
+    uint64_t size() const {return _size;}
+
+  private:
+
+    EvtImageFile(const EvtImageFile&);
+    EvtImageFile& operator=(const EvtImageFile&);
+
+    const char* _data;
+    uint64_t _size;
+    bool _mapped;
+    std::vector<uint64_t> _buffer;
+
+  };
+
+  void badImage(const std::string& fileName, const char* reason) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Decay image " << fileName
+					<< " can not be used: " << reason << endl;
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution!" << endl;
+    ::abort();
+  }
+
+  bool goodHeader(const char* data, uint64_t size) {
+    if (size < sizeof(Header)) return false;
+    const Header* header = reinterpret_cast<const Header*>(data);
+    return memcmp(header->magic, imageMagic, sizeof(imageMagic)) == 0;
+  }
+
+}
+
+bool EvtDecayImage::write(const std::string& fileName) {
+
+  EvtImageWriter writer;
+
+  const std::vector<EvtPDL::PdtEntry>& pdtEntries = EvtPDL::getPdtEntries();
+  for (size_t i=0; i<pdtEntries.size(); i++) {
+    const EvtPDL::PdtEntry& entry = pdtEntries[i];
+    PdtRecord record;
+    record.name = writer.add(entry.name);
+    record.stdhep = entry.stdhep;
+    record.lundkc = entry.lundkc;
+    record.chg3 = entry.chg3;
+    record.spin2 = entry.spin2;
+    record.mass = entry.mass;
+    record.width = entry.width;
+    record.maxWidth = entry.maxWidth;
+    record.ctau = entry.ctau;
+    writer.pdt.push_back(record);
+  }
+
+  const std::vector<EvtPDL::Change>& changes = EvtPDL::getChanges();
+  for (size_t i=0; i<changes.size(); i++) {
+    const EvtPDL::Change& change = changes[i];
+    ChangeRecord record;
+    record.type = change.type;
+    for (int j=0; j<3; j++) record.entry[j] = change.entry[j];
+    record.value = change.value;
+    record.pad = 0;
+    record.number = change.number;
+    record.name = writer.add(change.name);
+    writer.changes.push_back(record);
+  }
+
+  EvtDecayTable* decayTable = EvtDecayTable::getInstance();
+  std::vector<EvtParticleDecayList>& lists = decayTable->_decaytable;
+
+  for (size_t i=0; i<lists.size(); i++) {
+
+    EvtParticleDecayList& list = lists[i];
+    if (list.getNMode() == 0) continue;
+
+    ListRecord listRecord;
+    listRecord.entry = i;
+    listRecord.firstMode = writer.modes.size();
+    listRecord.nModes = list.getNMode();
+    listRecord.pad = 0;
+    listRecord.rawBrfrSum = list.getRawBrfrSum();
+    writer.lists.push_back(listRecord);
+
+    for (int j=0; j<list.getNMode(); j++) {
+
+      EvtParticleDecay& decay = list.getDecay(j);
+      EvtDecayBase* model = decay.getDecayModel();
+
+      ModeRecord record;
+      record.model = writer.add(model->getModelName());
+      record.firstDaughter = writer.daughters.size();
+      record.nDaughters = model->getNDaug();
+      for (int k=0; k<model->getNDaug(); k++) {
+	writer.daughters.push_back(model->getDaug(k).getAlias());
+      }
+      record.firstArg = writer.args.size();
+      record.nArgs = model->getNArg();
+      for (int k=0; k<model->getNArg(); k++) {
+	writer.args.push_back(writer.add(model->getArgStr(k)));
+      }
+      record.flags = 0;
+      if (model->getPHOTOS()) record.flags |= PHOTOS;
+      if (model->verbose()) record.flags |= VERBOSE;
+      if (model->summary()) record.flags |= SUMMARY;
+      record.pad = 0;
+      record.brfr = model->getBranchingFraction();
+      record.brfrSum = decay.getBrfrSum();
+      record.massMin = decay.getMassMin();
+      writer.modes.push_back(record);
+
+    }
+
+  }
+
+  const std::vector<std::pair<std::string,std::string> >& commands =
+    EvtModel::instance().getStoredCommands();
+  for (size_t i=0; i<commands.size(); i++) {
+    CommandRecord record;
+    record.command = writer.add(commands[i].first);
+    record.config = writer.add(commands[i].second);
+    writer.commands.push_back(record);
+  }
+
+  const GlobalCommandMap& extCommands =
+    EvtExtGeneratorCommandsTable::getInstance()->getAllCommands();
+  GlobalCommandMap::const_iterator iGen;
+  for (iGen = extCommands.begin(); iGen != extCommands.end(); ++iGen) {
+    for (size_t i=0; i<iGen->second.size(); i++) {
+      const Command& command = iGen->second[i];
+      ExtCommandRecord record;
+      record.generator = writer.add(iGen->first);
+      record.firstField = writer.extFields.size();
+      record.nFields = command.size();
+      Command::const_iterator iField;
+      for (iField = command.begin(); iField != command.end(); ++iField) {
+	ExtFieldRecord field;
+	field.key = writer.add(iField->first);
+	field.value = writer.add(iField->second);
+	writer.extFields.push_back(field);
+      }
+      writer.extCommands.push_back(record);
+    }
+  }
+
+  Header header;
+  memset(&header, 0, sizeof(Header));
+  memcpy(header.magic, imageMagic, sizeof(imageMagic));
+  header.version = imageVersion;
+  header.byteOrder = imageByteOrder;
+  header.nEntries = EvtPDL::entries();
+  if (EvtRadCorr::alwaysRadCorr()) header.radCorr |= ALWAYSRADCORR;
+  if (EvtRadCorr::neverRadCorr()) header.radCorr |= NEVERRADCORR;
+
+  if (!writer.write(fileName, header)) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Could not write decay image "
+					<< fileName << endl;
+    return false;
+  }
+
+  EvtGenReport(EVTGEN_INFO,"EvtGen") << "Wrote decay image " << fileName
+				     << " with " << header.nEntries << " particles and "
+				     << header.nModes << " decay modes" << endl;
+
+  return true;
+
+}
+
+bool EvtDecayImage::isImage(const std::string& fileName) {
+
+  std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!in) return false;
+
+  char magic[sizeof(imageMagic)];
+  in.read(magic, sizeof(magic));
+
+  return in && memcmp(magic, imageMagic, sizeof(imageMagic)) == 0;
+
+}
+
+void EvtDecayImage::read(const std::string& fileName, bool verbose) {
+
+  EvtImageFile file(fileName);
+
+  const char* data = file.data();
+  if (data == 0) badImage(fileName, "could not read the file");
+  if (!goodHeader(data, file.size())) badImage(fileName, "not a decay image");
+
+  const Header& header = *reinterpret_cast<const Header*>(data);
+  if (header.version != imageVersion) badImage(fileName, "unsupported version");
+  if (header.byteOrder != imageByteOrder) badImage(fileName, "written with another byte order");
+
+  Layout layout(header);
+  if (header.fileSize != file.size() || layout.end != file.size()) {
+    badImage(fileName, "truncated or damaged file");
+  }
+
+  const PdtRecord* pdt = reinterpret_cast<const PdtRecord*>(data+layout.pdt);
+  const ChangeRecord* changes = reinterpret_cast<const ChangeRecord*>(data+layout.changes);
+  const ListRecord* lists = reinterpret_cast<const ListRecord*>(data+layout.lists);
+  const ModeRecord* modes = reinterpret_cast<const ModeRecord*>(data+layout.modes);
+  const int32_t* daughters = reinterpret_cast<const int32_t*>(data+layout.daughters);
+  const StringRef* args = reinterpret_cast<const StringRef*>(data+layout.args);
+  const CommandRecord* commands = reinterpret_cast<const CommandRecord*>(data+layout.commands);
+  const ExtCommandRecord* extCommands = reinterpret_cast<const ExtCommandRecord*>(data+layout.extCommands);
+  const ExtFieldRecord* extFields = reinterpret_cast<const ExtFieldRecord*>(data+layout.extFields);
+  const char* strings = data+layout.strings;
+
+  // Every reference into the strings and the other sections is checked
+  // before it is used.
+  struct Strings {
+    const char* data;
+    uint64_t size;
+    const std::string* fileName;
+    std::string operator()(const StringRef& ref) const {
+      if (uint64_t(ref.offset)+ref.length > size) badImage(*fileName, "bad string reference");
+      return std::string(data+ref.offset, ref.length);
+    }
+  } str = {strings, header.stringSize, &fileName};
+
+  if (verbose) {
+    EvtGenReport(EVTGEN_INFO,"EvtGen") << "Reading decay image " << fileName << endl;
+  }
+
+  // Particle properties
+  if (EvtPDL::entries() == 0) {
+
+    for (uint32_t i=0; i<header.nPdtEntries; i++) {
+      EvtPDL::PdtEntry entry;
+      entry.name = str(pdt[i].name);
+      entry.stdhep = pdt[i].stdhep;
+      entry.mass = pdt[i].mass;
+      entry.width = pdt[i].width;
+      entry.maxWidth = pdt[i].maxWidth;
+      entry.chg3 = pdt[i].chg3;
+      entry.spin2 = pdt[i].spin2;
+      entry.ctau = pdt[i].ctau;
+      entry.lundkc = pdt[i].lundkc;
+      EvtPDL::addPdtEntry(entry);
+    }
+
+    for (uint32_t i=0; i<header.nChanges; i++) {
+      EvtPDL::Change change;
+      change.type = changes[i].type;
+      for (int j=0; j<3; j++) {
+	change.entry[j] = changes[i].entry[j];
+	if (change.entry[j] >= static_cast<int>(EvtPDL::entries())) {
+	  badImage(fileName, "bad particle reference");
+	}
+      }
+      change.value = changes[i].value;
+      change.number = changes[i].number;
+      change.name = str(changes[i].name);
+      EvtPDL::applyChange(change);
+    }
+
+  } else {
+
+    // Loaded before, by another generator
+    bool same = EvtPDL::entries() == header.nEntries;
+    for (uint32_t i=0; same && i<header.nPdtEntries; i++) {
+      same = EvtPDL::name(EvtPDL::getEntry(i)) == str(pdt[i].name);
+    }
+    if (!same) badImage(fileName, "the particle properties loaded already are different");
+
+  }
+
+  if (EvtPDL::entries() != header.nEntries) badImage(fileName, "inconsistent particle list");
+
+  // Global settings
+  if (header.radCorr & ALWAYSRADCORR) {
+    EvtRadCorr::setAlwaysRadCorr();
+  } else if (header.radCorr & NEVERRADCORR) {
+    EvtRadCorr::setNeverRadCorr();
+  } else {
+    EvtRadCorr::setNormalRadCorr();
+  }
+
+  EvtModel& modelList = EvtModel::instance();
+
+  for (uint32_t i=0; i<header.nCommands; i++) {
+    std::string command = str(commands[i].command);
+    if (!modelList.isCommand(command)) badImage(fileName, "unknown model command");
+    modelList.storeCommand(command, str(commands[i].config));
+  }
+
+  EvtExtGeneratorCommandsTable* extGenCommands = EvtExtGeneratorCommandsTable::getInstance();
+
+  for (uint32_t i=0; i<header.nExtCommands; i++) {
+    const ExtCommandRecord& record = extCommands[i];
+    if (uint64_t(record.firstField)+record.nFields > header.nExtFields) {
+      badImage(fileName, "bad command reference");
+    }
+    Command command;
+    for (uint32_t j=0; j<record.nFields; j++) {
+      const ExtFieldRecord& field = extFields[record.firstField+j];
+      command[str(field.key)] = str(field.value);
+    }
+    extGenCommands->addCommand(str(record.generator), command);
+  }
+
+  // Decay table
+  EvtDecayTable* decayTable = EvtDecayTable::getInstance();
+  std::vector<EvtParticleDecayList>& table = decayTable->_decaytable;
+  if (table.size() < EvtPDL::entries()) table.resize(EvtPDL::entries());
+
+  std::vector<EvtId> daughterIds;
+  std::vector<std::string> argStrings;
+
+  for (uint32_t i=0; i<header.nLists; i++) {
+
+    const ListRecord& listRecord = lists[i];
+    if (listRecord.entry < 0 || listRecord.entry >= static_cast<int>(header.nEntries) ||
+	uint64_t(listRecord.firstMode)+listRecord.nModes > header.nModes) {
+      badImage(fileName, "bad decay list");
+    }
+
+    EvtParticleDecayList& list = table[listRecord.entry];
+    if (list.getNMode() != 0) list.removeDecay();
+
+    EvtId parent = EvtPDL::getEntry(listRecord.entry);
+
+    for (uint32_t j=0; j<listRecord.nModes; j++) {
+
+      const ModeRecord& record = modes[listRecord.firstMode+j];
+      if (uint64_t(record.firstDaughter)+record.nDaughters > header.nDaughters ||
+	  uint64_t(record.firstArg)+record.nArgs > header.nArgs) {
+	badImage(fileName, "bad decay mode");
+      }
+
+      std::string modelName = str(record.model);
+      EvtDecayBase* model = modelList.getFcn(modelName);
+      if (model == 0) badImage(fileName, "unknown model");
+
+      if (record.flags & PHOTOS) model->setPHOTOS();
+      if (record.flags & VERBOSE) model->setVerbose();
+      if (record.flags & SUMMARY) model->setSummary();
+
+      daughterIds.clear();
+      for (uint32_t k=0; k<record.nDaughters; k++) {
+	int32_t entry = daughters[record.firstDaughter+k];
+	if (entry < 0 || entry >= static_cast<int>(header.nEntries)) {
+	  badImage(fileName, "bad particle reference");
+	}
+	daughterIds.push_back(EvtPDL::getEntry(entry));
+      }
+
+      argStrings.clear();
+      for (uint32_t k=0; k<record.nArgs; k++) {
+	argStrings.push_back(str(args[record.firstArg+k]));
+      }
+
+      model->saveDecayInfo(parent, daughterIds.size(),
+			   daughterIds.empty() ? 0 : &daughterIds[0],
+			   argStrings.size(), argStrings, modelName, record.brfr);
+
+      list.addMode(model, record.brfrSum, record.massMin);
+
+    }
+
+    list.setRawBrfrSum(listRecord.rawBrfrSum);
+
+  }
+
+  if (verbose) {
+    EvtGenReport(EVTGEN_INFO,"EvtGen") << "Read " << header.nEntries << " particles and "
+				       << header.nModes << " decay modes from "
+				       << fileName << endl;
+  }
+
+}
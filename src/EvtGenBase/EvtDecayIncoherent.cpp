@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    DJL/RYD     August 11, 1998         Module created
+//                Oct 2026                Count and time the tries
 //
 //------------------------------------------------------------------------
 #include "EvtGenBase/EvtPatches.hh"
@@ -37,7 +38,8 @@ void EvtDecayIncoherent::makeDecay(EvtParticle* p, bool recursive){
 
   _daugsDecayedByParentModel=false;
 
-  decay(p);
+  startDecay();
+  tryDecay(p);
   p->setDecayProb(1.0);
 
   EvtSpinDensity rho;
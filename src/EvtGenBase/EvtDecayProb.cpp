@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    DJL/RYD     August 11, 1998         Module created
+//                Oct 2026                Count and time the tries
 //
 //------------------------------------------------------------------------
 #include "EvtGenBase/EvtPatches.hh"
@@ -34,11 +35,13 @@ void EvtDecayProb::makeDecay(EvtParticle* p, bool recursive){
 
   double dummy;
 
+  startDecay();
+
   do{
     _weight=1.0;
     _daugsDecayedByParentModel=false;
 
-    decay(p);
+    tryDecay(p);
 
     ntimes--;
     
@@ -50,6 +53,7 @@ void EvtDecayProb::makeDecay(EvtParticle* p, bool recursive){
   }while(ntimes&&(_prob<dummy));
 
   if (ntimes==0){
+    countExhausted();
     EvtGenReport(EVTGEN_DEBUG,"EvtGen") << "Tried accept/reject:10000"
 			   <<" times, and rejected all the times!"<<endl;
     EvtGenReport(EVTGEN_DEBUG,"EvtGen") << "Is therefore accepting the last event!"<<endl;
@@ -0,0 +1,215 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtDecayStats
+//
+// Description: Run statistics of the decay channels, see EvtDecayStats.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtDecayStats.hh"
+#include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtPDL.hh"
+#include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtReportUtils.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using std::endl;
+
+namespace {
+
+  // Most expensive first
+  class ByCost {
+  public:
+    ByCost(const std::vector<EvtDecayStats::Channel>& channels, bool byTime) :
+      _channels(channels), _byTime(byTime) {}
+    bool operator()(std::size_t a, std::size_t b) const {
+      const EvtDecayBase::RunStats& sa = _channels[a].stats;
+      const EvtDecayBase::RunStats& sb = _channels[b].stats;
+      if (_byTime && sa.decaySeconds != sb.decaySeconds) {
+	return sa.decaySeconds > sb.decaySeconds;
+      }
+      if (sa.tries != sb.tries) return sa.tries > sb.tries;
+      return a < b;
+    }
+  private:
+    const std::vector<EvtDecayStats::Channel>& _channels;
+    bool _byTime;
+  };
+
+}
+
+void EvtDecayStats::setTiming(bool timing) {
+  EvtGenContext::current()->setDecayTiming(timing);
+}
+
+bool EvtDecayStats::isTiming() {
+  return EvtGenContext::current()->isDecayTiming();
+}
+
+void EvtDecayStats::collect(EvtDecayTable* decayTable) {
+
+  if (!decayTable) return;
+
+  int nParticles = EvtPDL::entries();
+
+  for (int i=0; i<nParticles; i++) {
+
+    int nModes = decayTable->getNModes(i);
+
+    for (int j=0; j<nModes; j++) {
+
+      EvtDecayBase* decay = decayTable->getDecay(i, j);
+      if (!decay) continue;
+
+      EvtDecayBase::RunStats stats = decay->getRunStats();
+      if (stats.calls == 0 && stats.massTreeRetries == 0) continue;
+
+      std::string key = decay->getProbMaxKey();
+      std::map<std::string,std::size_t>::iterator found = _index.find(key);
+
+      if (found == _index.end()) {
+	Channel channel;
+	channel.key = key;
+	channel.parent = EvtPDL::name(decay->getParentId());
+	channel.model = decay->getModelName();
+	for (int k=0; k<decay->getNDaug(); k++) {
+	  if (k > 0) channel.daughters += " ";
+	  channel.daughters += EvtPDL::name(decay->getDaug(k));
+	}
+	channel.branchingFraction = decay->getBranchingFraction();
+	channel.stats = stats;
+	_index[key] = _channels.size();
+	_channels.push_back(channel);
+	continue;
+      }
+
+      EvtDecayBase::RunStats& sum = _channels[found->second].stats;
+      sum.calls += stats.calls;
+      sum.tries += stats.tries;
+      sum.exhausted += stats.exhausted;
+      sum.massTreeRetries += stats.massTreeRetries;
+      sum.probMaxOverruns += stats.probMaxOverruns;
+      sum.decaySeconds += stats.decaySeconds;
+      sum.probMax = std::max(sum.probMax, stats.probMax);
+      sum.maxProb = std::max(sum.maxProb, stats.maxProb);
+      sum.sumProb += stats.sumProb;
+
+    }
+
+  }
+
+}
+
+std::vector<std::size_t> EvtDecayStats::sorted() const {
+
+  bool byTime(false);
+  for (std::size_t i=0; i<_channels.size(); i++) {
+    if (_channels[i].stats.decaySeconds > 0.0) byTime = true;
+  }
+
+  std::vector<std::size_t> order(_channels.size());
+  for (std::size_t i=0; i<order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(), ByCost(_channels, byTime));
+
+  return order;
+
+}
+
+void EvtDecayStats::print(std::ostream& output, int maxLines) const {
+
+  std::ios::fmtflags flags = output.flags();
+  std::streamsize precision = output.precision();
+
+  std::vector<std::size_t> order = sorted();
+  std::size_t nLines = order.size();
+  if (maxLines > 0 && static_cast<std::size_t>(maxLines) < nLines) nLines = maxLines;
+
+  output << "      calls      tries  exhausted  mass tree  overruns    seconds  decay" << endl;
+  output << std::fixed;
+
+  for (std::size_t i=0; i<nLines; i++) {
+    const Channel& channel = _channels[order[i]];
+    const EvtDecayBase::RunStats& stats = channel.stats;
+    output << std::setw(11) << stats.calls
+	   << std::setw(11) << stats.tries
+	   << std::setw(11) << stats.exhausted
+	   << std::setw(11) << stats.massTreeRetries
+	   << std::setw(10) << stats.probMaxOverruns
+	   << std::setw(11) << std::setprecision(4) << stats.decaySeconds
+	   << "  " << channel.parent << " -> " << channel.daughters
+	   << " (" << channel.model << ")" << endl;
+  }
+
+  output.flags(flags);
+  output.precision(precision);
+
+}
+
+void EvtDecayStats::writeJSON(std::ostream& output) const {
+
+  std::streamsize precision = output.precision();
+  output.precision(9);
+
+  std::vector<std::size_t> order = sorted();
+
+  output << "{\n  \"timing\": " << (isTiming() ? "true" : "false")
+	 << ",\n  \"channels\": [";
+
+  for (std::size_t i=0; i<order.size(); i++) {
+    const Channel& channel = _channels[order[i]];
+    const EvtDecayBase::RunStats& stats = channel.stats;
+    output << (i == 0 ? "\n" : ",\n")
+	   << "    {\"parent\": " << EvtReportUtils::jsonString(channel.parent)
+	   << ", \"daughters\": " << EvtReportUtils::jsonString(channel.daughters)
+	   << ", \"model\": " << EvtReportUtils::jsonString(channel.model)
+	   << ", \"key\": " << EvtReportUtils::jsonString(channel.key)
+	   << ", \"branchingFraction\": " << channel.branchingFraction
+	   << ", \"calls\": " << stats.calls
+	   << ", \"tries\": " << stats.tries
+	   << ", \"exhausted\": " << stats.exhausted
+	   << ", \"massTreeRetries\": " << stats.massTreeRetries
+	   << ", \"probMaxOverruns\": " << stats.probMaxOverruns
+	   << ", \"decaySeconds\": " << stats.decaySeconds
+	   << ", \"probMax\": " << stats.probMax
+	   << ", \"maxProb\": " << stats.maxProb
+	   << ", \"sumProb\": " << stats.sumProb << "}";
+  }
+
+  output << "\n  ]\n}\n";
+
+  output.precision(precision);
+
+}
+
+bool EvtDecayStats::writeJSON(const std::string& fileName) const {
+
+  std::ofstream output(fileName.c_str());
+
+  if (!output) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can not write decay statistics "
+					<< fileName << endl;
+    return false;
+  }
+
+  writeJSON(output);
+
+  return output.good();
+
+}
@@ -30,6 +30,7 @@
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtRandom.hh"
 #include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtSymTable.hh"
 #include "EvtGenBase/EvtDecayBase.hh"
@@ -55,13 +56,7 @@ EvtDecayTable::~EvtDecayTable() {
 
 EvtDecayTable* EvtDecayTable::getInstance() {
 
-  static EvtDecayTable* theDecayTable = 0;
-
-  if (theDecayTable == 0) {
-    theDecayTable = new EvtDecayTable();
-  }
-
-  return theDecayTable;
+  return EvtGenContext::current()->getDecayTable();
 
 }
 
@@ -17,12 +17,16 @@
 // Modification history:
 //
 //    fkw        February 2, 2001     changes to satisfy KCC
+//               Oct 2026   Tabulated d-functions, flat amplitude storage
+//                          and optional consistency check
 //    RYD       September 7, 2000       Module created
 //
 //------------------------------------------------------------------------
 // 
 #include "EvtGenBase/EvtPatches.hh"
 #include <stdlib.h>
+#include <math.h>
+#include <assert.h>
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtVector4C.hh"
@@ -30,57 +34,29 @@
 #include "EvtGenBase/EvtEvalHelAmp.hh"
 #include "EvtGenBase/EvtId.hh"
 #include "EvtGenBase/EvtConst.hh"
-#include "EvtGenBase/EvtdFunction.hh"
+#include "EvtGenBase/EvtSpinDensity.hh"
 #include "EvtGenBase/EvtAmp.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 using std::endl;
 
-
-EvtEvalHelAmp::~EvtEvalHelAmp() {
-
-  //deallocate memory
-  delete [] _lambdaA2;
-  delete [] _lambdaB2;
-  delete [] _lambdaC2;
-
-  int ia,ib,ic;
-  for(ib=0;ib<_nB;ib++){
-    delete [] _HBC[ib];
+namespace {
+  double factorial(int n) {
+    double f=1.0;
+    for(int k=2;k<=n;k++) f*=k;
+    return f;
   }
+}
 
-  delete [] _HBC;
-
-
-  for(ia=0;ia<_nA;ia++){
-    delete [] _RA[ia];
-  }
-  delete [] _RA;
-
-  for(ib=0;ib<_nB;ib++){
-    delete [] _RB[ib];
-  }
-  delete [] _RB;
-
-  for(ic=0;ic<_nC;ic++){
-    delete [] _RC[ic];
-  }
-  delete [] _RC;
+void EvtEvalHelAmp::setConsistencyCheck(bool check) {
+  EvtGenContext::current()->setHelAmpCheck(check);
+}
 
- 
-  for(ia=0;ia<_nA;ia++){
-    for(ib=0;ib<_nB;ib++){
-      delete [] _amp[ia][ib];
-      delete [] _amp1[ia][ib];
-      delete [] _amp3[ia][ib];
-    }
-    delete [] _amp[ia];
-    delete [] _amp1[ia];
-    delete [] _amp3[ia];
-  }
+bool EvtEvalHelAmp::getConsistencyCheck() {
+  return EvtGenContext::current()->getHelAmpCheck();
+}
 
-  delete [] _amp;
-  delete [] _amp1;
-  delete [] _amp3;
 
+EvtEvalHelAmp::~EvtEvalHelAmp() {
 }
 
 
@@ -104,62 +80,152 @@ EvtEvalHelAmp::EvtEvalHelAmp(EvtId idA,
   _JB2=EvtSpinType::getSpin2(typeB);
   _JC2=EvtSpinType::getSpin2(typeC);
 
+  //the rotation of a scalar is the identity
+  _rotA=(typeA!=EvtSpinType::SCALAR);
+  _rotB=(typeB!=EvtSpinType::SCALAR);
+  _rotC=(typeC!=EvtSpinType::SCALAR);
 
   //allocate memory
-  _lambdaA2=new int[_nA];
-  _lambdaB2=new int[_nB];
-  _lambdaC2=new int[_nC];
+  _lambdaA2.resize(_nA);
+  _lambdaB2.resize(_nB);
+  _lambdaC2.resize(_nC);
 
-  _HBC=new EvtComplexPtr[_nB];
-  int ia,ib,ic;
-  for(ib=0;ib<_nB;ib++){
-    _HBC[ib]=new EvtComplex[_nC];
-  }
+  _HBC.resize(_nB*_nC);
 
+  _RA.assign(_nA*_nA,EvtComplex(1.0,0.0));
+  _RB.assign(_nB*_nB,EvtComplex(1.0,0.0));
+  _RC.assign(_nC*_nC,EvtComplex(1.0,0.0));
 
-  _RA=new EvtComplexPtr[_nA];
-  for(ia=0;ia<_nA;ia++){
-    _RA[ia]=new EvtComplex[_nA];
-  }
-  _RB=new EvtComplexPtr[_nB];
+  _amp.resize(_nA*_nB*_nC);
+  _ampTmp.resize(_nA*_nB*_nC);
+
+  //find the allowed helicities (actually 2*times the helicity!)
+
+  fillHelicity(&_lambdaA2[0],_nA,_JA2,idA);
+  fillHelicity(&_lambdaB2[0],_nB,_JB2,idB);
+  fillHelicity(&_lambdaC2[0],_nC,_JC2,idC);
+
+  int ib,ic;
   for(ib=0;ib<_nB;ib++){
-    _RB[ib]=new EvtComplex[_nB];
-  }
-  _RC=new EvtComplexPtr[_nC];
-  for(ic=0;ic<_nC;ic++){
-    _RC[ic]=new EvtComplex[_nC];
+    for(ic=0;ic<_nC;ic++){
+      _HBC[ib*_nC+ic]=HBC[ib][ic];
+    }
   }
-  
-  _amp=new EvtComplexPtrPtr[_nA];
-  _amp1=new EvtComplexPtrPtr[_nA];
-  _amp3=new EvtComplexPtrPtr[_nA];
+
+  setUpDFunctions();
+
+}
+
+
+void EvtEvalHelAmp::setUpDFunctions(){
+
+  //The d-functions only depend on lambdaA and lambdaB-lambdaC, and
+  //the phases on lambdaA-lambdaB+lambdaC, so each distinct one is
+  //set up once here and evaluated once per event. The coefficients
+  //are those of EvtdFunction::d, including its symmetry relations.
+
+  _dFirst.assign(1,0);
+  _dCoef.clear();
+  _dPowC.clear();
+  _dPowS.clear();
+  _dIndex.assign(_nA*_nB*_nC,-1);
+  _phase2.clear();
+  _phaseIndex.assign(_nA*_nB*_nC,0);
+
+  std::vector<int> dM1,dM2;
+
+  int ia,ib,ic;
   for(ia=0;ia<_nA;ia++){
-    _amp[ia]=new EvtComplexPtr[_nB];
-    _amp1[ia]=new EvtComplexPtr[_nB];
-    _amp3[ia]=new EvtComplexPtr[_nB];
     for(ib=0;ib<_nB;ib++){
-      _amp[ia][ib]=new EvtComplex[_nC];
-      _amp1[ia][ib]=new EvtComplex[_nC];
-      _amp3[ia][ib]=new EvtComplex[_nC];
-    }
-  }
+      for(ic=0;ic<_nC;ic++){
 
-  //find the allowed helicities (actually 2*times the helicity!)
+	int i=index(ia,ib,ic);
+
+	int e2=_lambdaA2[ia]-_lambdaB2[ib]+_lambdaC2[ic];
+	size_t ip=0;
+	while(ip<_phase2.size()&&_phase2[ip]!=e2) ip++;
+	if (ip==_phase2.size()) _phase2.push_back(e2);
+	_phaseIndex[i]=ip;
+
+	int m1=_lambdaA2[ia];
+	int m2=_lambdaB2[ib]-_lambdaC2[ic];
+	if (abs(m2)>_JA2) continue;
+
+	size_t id=0;
+	while(id<dM1.size()&&(dM1[id]!=m1||dM2[id]!=m2)) id++;
+	_dIndex[i]=id;
+	if (id<dM1.size()) continue;
+
+	dM1.push_back(m1);
+	dM2.push_back(m2);
+
+	int signp=1;
+	//make |m2|>|m1|
+	if (abs(m2)<abs(m1)) {
+	  int tmp=m1;
+	  m1=m2;
+	  m2=tmp;
+	  if ((m1-m2)%4!=0) signp=-signp;
+	}
+	//make m2 non-negative
+	if (m2<0) {
+	  m1=-m1;
+	  m2=-m2;
+	  if ((m1-m2)%4!=0) signp=-signp;
+	}
 
-  fillHelicity(_lambdaA2,_nA,_JA2,idA);
-  fillHelicity(_lambdaB2,_nB,_JB2,idB);
-  fillHelicity(_lambdaC2,_nC,_JC2,idC);
+	int j=_JA2;
+	int kmin=m2-m1;
+	int kmax=j-m1;
+	assert(kmin<=kmax);
+
+	double norm=sqrt(factorial((j+m2)/2)*factorial((j-m2)/2)
+			 *factorial((j+m1)/2)*factorial((j-m1)/2));
+
+	for(int k=kmin;k<=kmax;k+=2){
+	  int sign=signp;
+	  if ((k-m2+m1)%4!=0) sign=-sign;
+	  _dCoef.push_back(sign*norm/
+			   (factorial((j+m2-k)/2)*factorial(k/2)*
+			    factorial((j-m1-k)/2)*factorial((k-m2+m1)/2)));
+	  _dPowC.push_back((2*j-2*k+m2-m1)/2);
+	  _dPowS.push_back((2*k-m2+m1)/2);
+	}
+	_dFirst.push_back(_dCoef.size());
 
-  for(ib=0;ib<_nB;ib++){
-    for(ic=0;ic<_nC;ic++){
-      _HBC[ib][ic]=HBC[ib][ic];
+      }
     }
   }
+
+  _dValue.resize(dM1.size());
+  _phase.resize(_phase2.size());
+  _powC.resize(_JA2+1);
+  _powS.resize(_JA2+1);
+
 }
 
 
+void EvtEvalHelAmp::evalDFunctions(double theta){
 
+  double c2=cos(0.5*theta);
+  double s2=sin(0.5*theta);
 
+  _powC[0]=1.0;
+  _powS[0]=1.0;
+  for(int k=1;k<=_JA2;k++){
+    _powC[k]=_powC[k-1]*c2;
+    _powS[k]=_powS[k-1]*s2;
+  }
+
+  for(size_t i=0;i<_dValue.size();i++){
+    double d=0.0;
+    for(int k=_dFirst[i];k<_dFirst[i+1];k++){
+      d+=_dCoef[k]*_powC[_dPowC[k]]*_powS[_dPowS[k]];
+    }
+    _dValue[i]=d;
+  }
+
+}
 
 
 double EvtEvalHelAmp::probMax(){
@@ -176,16 +242,15 @@ double EvtEvalHelAmp::probMax(){
 
   for(itheta=-10;itheta<=10;itheta++){
     theta=acos(0.099999*itheta);
+    evalDFunctions(theta);
     for(ia=0;ia<_nA;ia++){
       double prob=0.0;
       for(ib=0;ib<_nB;ib++){
 	for(ic=0;ic<_nC;ic++){
-	  _amp[ia][ib][ic]=0.0;
-	  if (abs(_lambdaB2[ib]-_lambdaC2[ic])<=_JA2) {
-	    _amp[ia][ib][ic]=c*_HBC[ib][ic]*
-	      EvtdFunction::d(_JA2,_lambdaA2[ia],
-			      _lambdaB2[ib]-_lambdaC2[ic],theta);
-	    prob+=real(_amp[ia][ib][ic]*conj(_amp[ia][ib][ic]));
+	  int id=_dIndex[index(ia,ib,ic)];
+	  if (id>=0) {
+	    EvtComplex a=c*_HBC[ib*_nC+ic]*_dValue[id];
+	    prob+=real(a*conj(a));
 	  }
 	}
       }
@@ -213,69 +278,90 @@ void EvtEvalHelAmp::evalAmp( EvtParticle *p, EvtAmp& amp){
 
   double c=sqrt((_JA2+1)/(4*EvtConst::pi));
 
-  int ia,ib,ic;
+  evalDFunctions(theta);
 
-  double prob1=0.0;
+  size_t i;
+  for(i=0;i<_phase.size();i++){
+    _phase[i]=exp(EvtComplex(0.0,phi*0.5*_phase2[i]));
+  }
+
+  int ia,ib,ic;
 
   for(ia=0;ia<_nA;ia++){
     for(ib=0;ib<_nB;ib++){
       for(ic=0;ic<_nC;ic++){
-	_amp[ia][ib][ic]=0.0;
-	if (abs(_lambdaB2[ib]-_lambdaC2[ic])<=_JA2) {
-	  double dfun=EvtdFunction::d(_JA2,_lambdaA2[ia],
-				      _lambdaB2[ib]-_lambdaC2[ic],theta);
-
-	  _amp[ia][ib][ic]=c*_HBC[ib][ic]*
-	    exp(EvtComplex(0.0,phi*0.5*(_lambdaA2[ia]-_lambdaB2[ib]+
-	  				_lambdaC2[ic])))*dfun;
+	int k=index(ia,ib,ic);
+	int id=_dIndex[k];
+	if (id>=0) {
+	  _amp[k]=c*_HBC[ib*_nC+ic]*_phase[_phaseIndex[k]]*_dValue[id];
+	}
+	else{
+	  _amp[k]=0.0;
 	}
-	prob1+=real(_amp[ia][ib][ic]*conj(_amp[ia][ib][ic]));
       }
     }
   }
 
+  bool consistencyCheck=getConsistencyCheck();
+
+  double prob1=0.0;
+  if (consistencyCheck) {
+    for(i=0;i<_amp.size();i++){
+      prob1+=real(_amp[i]*conj(_amp[i]));
+    }
+  }
+
   setUpRotationMatrices(p,theta,phi);
 
   applyRotationMatrices();
 
-  double prob2=0.0;
+  if (consistencyCheck) {
+    double prob2=0.0;
+    for(i=0;i<_amp.size();i++){
+      prob2+=real(_amp[i]*conj(_amp[i]));
+    }
+    if (fabs(prob1-prob2)>0.000001*prob1){
+      EvtGenReport(EVTGEN_INFO,"EvtGen") << "prob1,prob2:"<<prob1<<" "<<prob2<<endl;
+      ::abort();
+    }
+  }
 
   for(ia=0;ia<_nA;ia++){
     for(ib=0;ib<_nB;ib++){
       for(ic=0;ic<_nC;ic++){
-	prob2+=real(_amp[ia][ib][ic]*conj(_amp[ia][ib][ic]));
+	const EvtComplex& a=_amp[index(ia,ib,ic)];
 	if (_nA==1){
 	  if (_nB==1){
 	    if (_nC==1){
-	      amp.vertex(_amp[ia][ib][ic]);
+	      amp.vertex(a);
 	    }
 	    else{
-	      amp.vertex(ic,_amp[ia][ib][ic]);
+	      amp.vertex(ic,a);
 	    }
 	  }
 	  else{
 	    if (_nC==1){
-	      amp.vertex(ib,_amp[ia][ib][ic]);
+	      amp.vertex(ib,a);
 	    }
 	    else{
-	      amp.vertex(ib,ic,_amp[ia][ib][ic]);
+	      amp.vertex(ib,ic,a);
 	    }
 	  }
 	}else{
 	  if (_nB==1){
 	    if (_nC==1){
-	      amp.vertex(ia,_amp[ia][ib][ic]);
+	      amp.vertex(ia,a);
 	    }
 	    else{
-	      amp.vertex(ia,ic,_amp[ia][ib][ic]);
+	      amp.vertex(ia,ic,a);
 	    }
 	  }
 	  else{
 	    if (_nC==1){
-	      amp.vertex(ia,ib,_amp[ia][ib][ic]);
+	      amp.vertex(ia,ib,a);
 	    }
 	    else{
-	      amp.vertex(ia,ib,ic,_amp[ia][ib][ic]);
+	      amp.vertex(ia,ib,ic,a);
 	    }
 	  }
 	}
@@ -283,11 +369,6 @@ void EvtEvalHelAmp::evalAmp( EvtParticle *p, EvtAmp& amp){
     }
   }
 
-  if (fabs(prob1-prob2)>0.000001*prob1){
-    EvtGenReport(EVTGEN_INFO,"EvtGen") << "prob1,prob2:"<<prob1<<" "<<prob2<<endl;
-    ::abort();
-  }
-    
   return ;
 
 }
@@ -330,161 +411,117 @@ void EvtEvalHelAmp::fillHelicity(int* lambda2,int n,int J2, EvtId id){
 
 void EvtEvalHelAmp::setUpRotationMatrices(EvtParticle* p,double theta, double phi){
 
-  switch(_JA2){
+  if (_JA2>8||_JB2>8||_JC2>8) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Spin2="<<_JA2<<","<<_JB2<<","<<_JC2
+					<<" not supported!"<<endl;
+    ::abort();
+  }
 
-  case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8:
+  int i,j,n;
 
-    {
+  if (_rotA) {
 
-      EvtSpinDensity R=p->rotateToHelicityBasis();
+    EvtSpinDensity R=p->rotateToHelicityBasis();
 
-      
-      int i,j,n;
-      
-      n=R.getDim();
-      
-      assert(n==_nA);
-	
-      
-      for(i=0;i<n;i++){
-	for(j=0;j<n;j++){
-	  _RA[i][j]=R.get(i,j);
-	}
-      }
+    n=R.getDim();
 
-    }
+    assert(n==_nA);
 
-    break;
+    for(i=0;i<n;i++){
+      for(j=0;j<n;j++){
+	_RA[i*n+j]=R.get(i,j);
+      }
+    }
 
-  default:
-    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Spin2(_JA2)="<<_JA2<<" not supported!"<<endl;
-    ::abort();
   }
-  
-  
-  switch(_JB2){
 
+  if (_rotB) {
 
-  case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8:
+    EvtSpinDensity R=p->getDaug(0)->rotateToHelicityBasis(phi,theta,-phi);
 
-    {
-      
-      int i,j,n;
+    n=R.getDim();
 
-      EvtSpinDensity R=p->getDaug(0)->rotateToHelicityBasis(phi,theta,-phi);
-      
-      n=R.getDim();
-      
-      assert(n==_nB);
-	
-      for(i=0;i<n;i++){
-	for(j=0;j<n;j++){
-	  _RB[i][j]=conj(R.get(i,j));
-	}
-      }
+    assert(n==_nB);
 
+    for(i=0;i<n;i++){
+      for(j=0;j<n;j++){
+	_RB[i*n+j]=conj(R.get(i,j));
+      }
     }
 
-    break;
-
-  default:
-    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Spin2(_JB2)="<<_JB2<<" not supported!"<<endl;
-    ::abort();
   }
-  
-  switch(_JC2){
 
-  case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7: case 8:
+  if (_rotC) {
 
-    {
+    EvtSpinDensity R=p->getDaug(1)->rotateToHelicityBasis(phi,EvtConst::pi+theta,phi-EvtConst::pi);
 
-      int i,j,n;
+    n=R.getDim();
 
-      EvtSpinDensity R=p->getDaug(1)->rotateToHelicityBasis(phi,EvtConst::pi+theta,phi-EvtConst::pi);
-            
-      n=R.getDim();
+    assert(n==_nC);
 
-      assert(n==_nC);
-
-      for(i=0;i<n;i++){
-	for(j=0;j<n;j++){
-	  _RC[i][j]=conj(R.get(i,j));
-	}
+    for(i=0;i<n;i++){
+      for(j=0;j<n;j++){
+	_RC[i*n+j]=conj(R.get(i,j));
       }
-
     }
 
-    break;
-
-  default:
-    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Spin2(_JC2)="<<_JC2<<" not supported!"<<endl;
-    ::abort();
   }
-  
-  
 
 }
 
 
 void EvtEvalHelAmp::applyRotationMatrices(){
 
+  //Each rotation reads _amp and writes _ampTmp, which are then
+  //swapped. The rotation of a scalar is the identity and is skipped.
+
   int ia,ib,ic,i;
   
   EvtComplex temp;
 
-
-
-  for(ia=0;ia<_nA;ia++){
-    for(ib=0;ib<_nB;ib++){
-      for(ic=0;ic<_nC;ic++){
-	temp=0;
-	for(i=0;i<_nC;i++){
-	  temp+=_RC[i][ic]*_amp[ia][ib][i];
+  if (_rotC) {
+    for(ia=0;ia<_nA;ia++){
+      for(ib=0;ib<_nB;ib++){
+	for(ic=0;ic<_nC;ic++){
+	  temp=0;
+	  for(i=0;i<_nC;i++){
+	    temp+=_RC[i*_nC+ic]*_amp[index(ia,ib,i)];
+	  }
+	  _ampTmp[index(ia,ib,ic)]=temp;
 	}
-	_amp1[ia][ib][ic]=temp;
       }
     }
+    _amp.swap(_ampTmp);
   }
 
-
-
-  for(ia=0;ia<_nA;ia++){
-    for(ic=0;ic<_nC;ic++){
-      for(ib=0;ib<_nB;ib++){
-  	temp=0;
-  	for(i=0;i<_nB;i++){
-  	  temp+=_RB[i][ib]*_amp1[ia][i][ic];
-  	}
-  	_amp3[ia][ib][ic]=temp;
+  if (_rotB) {
+    for(ia=0;ia<_nA;ia++){
+      for(ic=0;ic<_nC;ic++){
+	for(ib=0;ib<_nB;ib++){
+	  temp=0;
+	  for(i=0;i<_nB;i++){
+	    temp+=_RB[i*_nB+ib]*_amp[index(ia,i,ic)];
+	  }
+	  _ampTmp[index(ia,ib,ic)]=temp;
+	}
       }
     }
+    _amp.swap(_ampTmp);
   }
-  
-
 
-  for(ib=0;ib<_nB;ib++){
-    for(ic=0;ic<_nC;ic++){
-      for(ia=0;ia<_nA;ia++){
-	temp=0;
-	for(i=0;i<_nA;i++){
-	  temp+=_RA[i][ia]*_amp3[i][ib][ic];
+  if (_rotA) {
+    for(ib=0;ib<_nB;ib++){
+      for(ic=0;ic<_nC;ic++){
+	for(ia=0;ia<_nA;ia++){
+	  temp=0;
+	  for(i=0;i<_nA;i++){
+	    temp+=_RA[i*_nA+ia]*_amp[index(i,ib,ic)];
+	  }
+	  _ampTmp[index(ia,ib,ic)]=temp;
 	}
-	_amp[ia][ib][ic]=temp;
       }
     }
+    _amp.swap(_ampTmp);
   }
 
-
 }
-
-
-
-
-
-
-
-
-
-
-
-
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------
 
 #include "EvtGenBase/EvtExtGeneratorCommandsTable.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 
 EvtExtGeneratorCommandsTable::EvtExtGeneratorCommandsTable() {
   _commandMap.clear();
@@ -29,12 +30,6 @@ EvtExtGeneratorCommandsTable::~EvtExtGeneratorCommandsTable() {
 
 EvtExtGeneratorCommandsTable* EvtExtGeneratorCommandsTable::getInstance() {
 
-  static EvtExtGeneratorCommandsTable* theCommandMap = 0;
-
-  if (theCommandMap == 0) {
-    theCommandMap = new EvtExtGeneratorCommandsTable();
-  }
-
-  return theCommandMap;
+  return EvtGenContext::current()->getExtGenCommands();
 
 }
@@ -0,0 +1,62 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtFileReplacer
+//
+// Description: Replaces a file in one step, see EvtFileReplacer.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtFileReplacer.hh"
+
+#include <sstream>
+#include <stdio.h>
+#include <unistd.h>
+
+EvtFileReplacer::EvtFileReplacer(const std::string& fileName) :
+  _fileName(fileName),
+  _committed(false)
+{
+
+  // Unique among the processes, and among the replacers of this process
+  std::ostringstream tmpName;
+  tmpName << fileName << ".tmp." << getpid() << "." << this;
+  _tmpName = tmpName.str();
+
+  _output.open(_tmpName.c_str());
+
+}
+
+EvtFileReplacer::~EvtFileReplacer() {
+
+  if (_committed) return;
+
+  if (_output.is_open()) _output.close();
+  remove(_tmpName.c_str());
+
+}
+
+bool EvtFileReplacer::commit() {
+
+  if (_committed || !_output.is_open()) return false;
+
+  _output.close();
+  if (!_output) return false;
+
+  if (rename(_tmpName.c_str(), _fileName.c_str()) != 0) return false;
+
+  _committed = true;
+  return true;
+
+}
@@ -679,9 +679,33 @@ const EvtGammaMatrix& EvtGammaMatrix::sigmaLower(unsigned int mu, unsigned int n
             }
         }
     }
+    hasBeenCalled = true;
     return sigma[mu][nu];    
 }
 
+namespace {
+
+  // The constant matrices above are filled on first use. Do that while
+  // the library is loaded, so that generators running on several threads
+  // (see EvtGenContext) never race on their initialisation.
+  struct EvtGammaMatrixInit {
+    EvtGammaMatrixInit() {
+      for (int i=0; i<4; ++i) EvtGammaMatrix::g(i);
+      EvtGammaMatrix::g5();
+      EvtGammaMatrix::id();
+      EvtGammaMatrix::va0(); EvtGammaMatrix::va1();
+      EvtGammaMatrix::va2(); EvtGammaMatrix::va3();
+      EvtGammaMatrix::v0(); EvtGammaMatrix::v1();
+      EvtGammaMatrix::v2(); EvtGammaMatrix::v3();
+      EvtGammaMatrix::sigmaUpper(0,0);
+      EvtGammaMatrix::sigmaLower(0,0);
+    }
+  };
+
+  const EvtGammaMatrixInit gammaMatrixInit;
+
+}
+
 
 EvtGammaMatrix EvtGenFunctions::slash(const EvtVector4C& p)
 {
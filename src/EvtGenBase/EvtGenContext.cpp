@@ -0,0 +1,186 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtGenContext
+//
+// Description: State of one generation stream, see EvtGenContext.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//    Oct 2026            Added the buffer of random numbers
+//    Oct 2026            Added the particle memory pool
+//    Oct 2026            Added the phase space batch
+//    Oct 2026            Added the lazy initialisation switch
+//    Oct 2026            Added the startup profile switch
+//    Oct 2026            Added the decay timing switch
+//    Oct 2026            Added the helicity amplitude check switch
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtModel.hh"
+#include "EvtGenBase/EvtCPUtil.hh"
+#include "EvtGenBase/EvtExtGeneratorCommandsTable.hh"
+#include "EvtGenBase/EvtRandomEngine.hh"
+#include "EvtGenBase/EvtAbsRadCorr.hh"
+#include "EvtGenBase/EvtParticlePool.hh"
+#include "EvtGenBase/EvtReport.hh"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+#ifdef EVTGEN_CPP11
+  thread_local EvtGenContext* boundContext = 0;
+#else
+  EvtGenContext* boundContext = 0;
+#endif
+
+  EvtGenContext* defaultContext() {
+    // Never deleted, as for the singletons this replaces; the default
+    // context may still be used during static destruction.
+    static EvtGenContext* theDefaultContext = new EvtGenContext();
+    return theDefaultContext;
+  }
+
+}
+
+EvtGenContext::EvtGenContext() :
+  _decayTable(new EvtDecayTable()),
+  _modelList(new EvtModel()),
+  _cpUtil(new EvtCPUtil(1)),
+  _extGenCommands(new EvtExtGeneratorCommandsTable()),
+  _particlePool(new EvtParticlePool()),
+  _startupProfileEnabled(false),
+  _decayTiming(false),
+  _helAmpCheck(false),
+  _phaseSpaceBatchSize(0),
+  _lazyInit(false),
+  _randomEngine(0),
+  _ownedRandomEngine(0),
+  _randomBufferSize(0),
+  _randomPosition(0),
+  _randomFilled(0),
+  _radCorrEngine(0),
+  _ownedRadCorrEngine(0),
+  _alwaysRadCorr(false),
+  _neverRadCorr(false),
+  _rejectFlag(0)
+{
+
+  _incoherentMixing.doB0Mixing = false;
+  _incoherentMixing.doBsMixing = false;
+  _incoherentMixing.enableFlip = false;
+  _incoherentMixing.dGammad = 0.;
+  _incoherentMixing.deltamd = 0.502e12;
+  // dGamma_s corresponds to DeltaGamma / Gamma = 10 %
+  _incoherentMixing.dGammas = 6.852e10;
+  _incoherentMixing.deltams = 20.e12;
+
+}
+
+EvtGenContext::~EvtGenContext() {
+
+  if (boundContext == this) boundContext = 0;
+
+  delete _decayTable;
+  delete _modelList;
+  delete _cpUtil;
+  delete _extGenCommands;
+  delete _ownedRandomEngine;
+  delete _ownedRadCorrEngine;
+  _particlePool->destroy();
+
+}
+
+EvtGenContext* EvtGenContext::current() {
+
+  if (boundContext != 0) return boundContext;
+  return defaultContext();
+
+}
+
+void EvtGenContext::setCurrent(EvtGenContext* context) {
+
+  boundContext = context;
+
+}
+
+void EvtGenContext::adoptRandomEngine(EvtRandomEngine* randomEngine) {
+
+  if (_ownedRandomEngine != randomEngine) delete _ownedRandomEngine;
+  _ownedRandomEngine = randomEngine;
+  setRandomEngine(randomEngine);
+
+}
+
+void EvtGenContext::setRandomBufferSize(int n) {
+
+  // The numbers already buffered are still handed out first, so that the
+  // sequence seen by EvtRandom is not affected; refillRandom uses the new
+  // size once they are gone.
+  _randomBufferSize = n > 0 ? n : 0;
+
+}
+
+bool EvtGenContext::setRandomStream(uint32_t run, uint64_t event) {
+
+  clearRandomBuffer();
+  _phaseSpaceBatch.clear();
+  if (_randomEngine == 0) return false;
+  return _randomEngine->setStream(run, event);
+
+}
+
+double EvtGenContext::refillRandom() {
+
+  if (_randomEngine == 0) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") <<"No random engine available in "
+				       <<"EvtRandom::random()."<<std::endl;
+    ::abort();
+  }
+
+  _randomPosition = 0;
+  _randomFilled = 0;
+
+  if (_randomBufferSize <= 1) return _randomEngine->random();
+
+  if ((int)_randomBuffer.size() != _randomBufferSize) _randomBuffer.resize(_randomBufferSize);
+  _randomEngine->randomArray(&_randomBuffer[0], _randomBufferSize);
+  _randomPosition = 1;
+  _randomFilled = _randomBufferSize;
+  return _randomBuffer[0];
+
+}
+
+void EvtGenContext::adoptRadCorrEngine(EvtAbsRadCorr* radCorrEngine) {
+
+  if (_ownedRadCorrEngine != radCorrEngine) delete _ownedRadCorrEngine;
+  _ownedRadCorrEngine = radCorrEngine;
+  _radCorrEngine = radCorrEngine;
+
+}
+
+EvtGenContext::Scope::Scope(EvtGenContext* context) :
+  _previous(boundContext)
+{
+
+  boundContext = context;
+
+}
+
+EvtGenContext::Scope::~Scope() {
+
+  boundContext = _previous;
+
+}
@@ -16,6 +16,8 @@
 // Modification history:
 //
 //    DJL/RYD     September 25, 1996         Module created
+//                Oct 2026                   Added PhaseSpaceBatch and the
+//                                           prefetching in PhaseSpace
 //
 //------------------------------------------------------------------------
 //
@@ -26,7 +28,10 @@
 #include "EvtGenBase/EvtVector4R.hh"
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtConst.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtPhaseSpaceBatch.hh"
 #include <math.h>
+#include <vector>
 using std::endl;
 
 
@@ -41,6 +46,61 @@ double EvtPawt(double a,double b,double c)
   return sqrt(temp)/(2.0*a);
 }
 
+namespace {
+
+  // Maximum weight of N body phase space before the mass factors,
+  // for 0 to 15 daughters
+  const int maxPhaseSpaceDaug = 15;
+  const double phaseSpaceWtMaxStart[maxPhaseSpaceDaug+1] = {
+    0.0, 1.0/16.0, 1.0/150.0, 1.0/2.0, 1.0/5.0, 1.0/15.0,
+    1.0/15.0, 1.0/15.0, 1.0/15.0, 1.0/15.0, 1.0/15.0,
+    1.0/15.0, 1.0/15.0, 1.0/15.0, 1.0/15.0, 1.0/15.0
+  };
+
+  double phaseSpaceWtMax(int ndaug, const double mass[], double mp) {
+
+    double wtmax=0.0;
+    if (ndaug>=1 && ndaug<=maxPhaseSpaceDaug) {
+      wtmax=phaseSpaceWtMaxStart[ndaug];
+    } else {
+      EvtGenReport(EVTGEN_ERROR,"EvtGen") << "too many daughters for phase space..." << ndaug << " "<< mp <<endl;;
+    }
+
+    double psum=0.0;
+    for(int i=1;i<ndaug+1;i++){
+      psum=psum+mass[i-1];
+    }
+
+    double pmax=mp-psum+mass[ndaug-1];
+    double pmin=0.0;
+
+    for(int ilr=2;ilr<ndaug+1;ilr++){
+      int il=ndaug+1-ilr;
+      pmax=pmax+mass[il-1];
+      pmin=pmin+mass[il+1-1];
+      wtmax=wtmax*EvtPawt(pmax,pmin,mass[il-1]);
+    }
+
+    return wtmax;
+
+  }
+
+  // EvtPawt without the branch, so that loops over a batch vectorise
+  inline double batchPawt(double a,double b,double c) {
+    double temp=(a*a-(b+c)*(b+c))*(a*a-(b-c)*(b-c));
+    return sqrt(temp>0.0 ? temp : 0.0)/(2.0*a);
+  }
+
+}
+
+void EvtGenKine::setBatchSize(int n) {
+  EvtGenContext::current()->setPhaseSpaceBatchSize(n);
+}
+
+int EvtGenKine::getBatchSize() {
+  return EvtGenContext::current()->getPhaseSpaceBatchSize();
+}
+
 
 double EvtGenKine::PhaseSpace( int ndaug, double mass[30], EvtVector4R p4[30], 
 			       double mp )
@@ -53,6 +113,25 @@ double EvtGenKine::PhaseSpace( int ndaug, double mass[30], EvtVector4R p4[30],
 
   double energy, p3, alpha, beta;
 
+  EvtGenContext* context = EvtGenContext::current();
+  int batchSize = context->getPhaseSpaceBatchSize();
+
+  if ( batchSize > 1 && ndaug >= 2 && ndaug <= maxPhaseSpaceDaug ) {
+    EvtPhaseSpaceBatch& batch = context->getPhaseSpaceBatch();
+    if ( batch.matches( ndaug, mass, mp ) ) {
+      if ( batch.remaining() == 0 ) {
+	// Start small and double while the batches get used up, so that
+	// little is thrown away when the masses change after a few tries
+	int size = batch.size() > 0 ? 2*batch.size() : 4;
+	PhaseSpaceBatch( ndaug, mass, mp, size < batchSize ? size : batchSize, batch );
+      }
+      batch.next( p4 );
+      return 1.0;
+    }
+    // Only prefetch once the same kinematics are asked for again
+    batch.setKinematics( ndaug, mass, mp );
+  }
+
   if ( ndaug == 1 ) {
      p4[0].set(mass[0],0.0,0.0,0.0);
      return 1.0;
@@ -91,7 +170,7 @@ double EvtGenKine::PhaseSpace( int ndaug, double mass[30], EvtVector4R p4[30],
   if ( ndaug != 2 ) {
 
     double wtmax=0.0;
-    double pm[5][30],pmin,pmax,psum,rnd[30];
+    double pm[5][30],psum,rnd[30];
     double ran,wt,pa,costh,sinth,phi,p[4][30],be[4],bep,temp;
     int i,il,ilr,i1,il1u,il1,il2r,ilu;
     int il2=0;
@@ -114,68 +193,7 @@ double EvtGenKine::PhaseSpace( int ndaug, double mass[30], EvtVector4R p4[30],
 
      pm[4][ndaug-1]=mass[ndaug-1];
 
-     switch (ndaug) {
-
-     case 1:
-       wtmax=1.0/16.0;
-       break;
-     case 2:
-       wtmax=1.0/150.0;
-       break;
-     case 3:
-       wtmax=1.0/2.0;
-       break;
-     case 4:
-       wtmax=1.0/5.0;
-       break;
-     case 5:
-       wtmax=1.0/15.0;
-       break;
-     case 6:
-       wtmax=1.0/15.0;
-       break;
-     case 7:
-       wtmax=1.0/15.0;
-       break;
-     case 8:
-       wtmax=1.0/15.0;
-       break;
-     case 9:
-       wtmax=1.0/15.0;
-       break;
-     case 10:
-       wtmax=1.0/15.0;
-       break;
-     case 11:
-       wtmax=1.0/15.0;
-       break;
-     case 12:
-       wtmax=1.0/15.0;
-       break;
-     case 13:
-       wtmax=1.0/15.0;
-       break;
-     case 14:
-       wtmax=1.0/15.0;
-       break;
-     case 15:
-       wtmax=1.0/15.0;
-       break;
-     default:
-       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "too many daughters for phase space..." << ndaug << " "<< mp <<endl;;
-       break;
-     }
-
-     pmax=mp-psum+mass[ndaug-1];
-
-     pmin=0.0;
-
-     for(ilr=2;ilr<ndaug+1;ilr++){
-       il=ndaug+1-ilr;
-       pmax=pmax+mass[il-1];
-       pmin=pmin+mass[il+1-1];
-       wtmax=wtmax*EvtPawt(pmax,pmin,mass[il-1]);
-     }
+     wtmax=phaseSpaceWtMax(ndaug,mass,mp);
 
      do{
 
@@ -260,6 +278,239 @@ double EvtGenKine::PhaseSpace( int ndaug, double mass[30], EvtVector4R p4[30],
 }
 
 
+int EvtGenKine::PhaseSpaceBatch( int ndaug, const double mass[], double mp,
+				 int nEvents, EvtPhaseSpaceBatch& batch )
+
+//  N body phase space for a batch of events, following PhaseSpace.
+//  The random numbers are drawn first for a whole step; the loops
+//  over the events which follow do not depend on each other.
+
+{
+
+  if ( ndaug < 1 || nEvents < 1 ) {
+    batch.resize( 0, 0 );
+    return 0;
+  }
+
+  batch.resize( ndaug, nEvents );
+
+  const int n = nEvents;
+  int i, k;
+
+  if ( ndaug == 1 ) {
+    double* e = batch.e(0);
+    double* px = batch.px(0);
+    double* py = batch.py(0);
+    double* pz = batch.pz(0);
+    for ( k=0; k<n; k++ ) {
+      e[k]=mass[0]; px[k]=0.0; py[k]=0.0; pz[k]=0.0;
+    }
+    return n;
+  }
+
+  std::vector<double> costh( n ), phi( n );
+
+  if ( ndaug == 2 ) {
+
+    double energy = ( mp*mp + mass[0]*mass[0] -
+		      mass[1]*mass[1] ) / ( 2.0 * mp );
+    double p3 = 0.0;
+    if (energy > mass[0]) {
+      p3 = sqrt( energy*energy - mass[0]*mass[0] );
+    }
+
+    for ( k=0; k<n; k++ ) {
+      phi[k] = EvtRandom::Flat( EvtConst::twoPi );
+      costh[k] = EvtRandom::Flat( -1.0, 1.0 );
+    }
+
+    double* e0 = batch.e(0);
+    double* x0 = batch.px(0);
+    double* y0 = batch.py(0);
+    double* z0 = batch.pz(0);
+    double* e1 = batch.e(1);
+    double* x1 = batch.px(1);
+    double* y1 = batch.py(1);
+    double* z1 = batch.pz(1);
+
+    for ( k=0; k<n; k++ ) {
+      double sinth = sqrt( 1.0 - costh[k]*costh[k] );
+      double x = p3*sinth*cos( phi[k] );
+      double y = p3*sinth*sin( phi[k] );
+      double z = p3*costh[k];
+      e0[k] = energy; x0[k] = x; y0[k] = y; z0[k] = z;
+      e1[k] = mp - energy; x1[k] = -x; y1[k] = -y; z1[k] = -z;
+    }
+
+    return n;
+  }
+
+  double wtmax = phaseSpaceWtMax( ndaug, mass, mp );
+
+  double psum = 0.0;
+  for ( i=0; i<ndaug; i++ ) psum += mass[i];
+
+  // Invariant masses of the systems of daughters i..ndaug-1, pm4[i*n+k]
+  // for the accepted events and cand[i*nTry+k] for those of a try
+  std::vector<double> pm4( ndaug*n ), cand, rnd, wt;
+  std::vector<double> sorted( ndaug );
+
+  int accepted = 0;
+  int tried = 0;
+  bool tooLarge = false;
+
+  while ( accepted < n ) {
+
+    // Enough candidates for the missing events at the acceptance so far
+    const int maxTry = 256;
+    double nTryWanted = n - accepted;
+    if ( accepted > 0 ) nTryWanted *= 1.1*tried/accepted;
+    else if ( tried > 0 ) nTryWanted = 2.0*tried;
+    const int nTry = nTryWanted < maxTry ? (int)nTryWanted+1 : maxTry;
+
+    if ( (int)wt.size() < nTry ) {
+      cand.resize( ndaug*nTry );
+      rnd.resize( ndaug*nTry );
+      wt.resize( nTry );
+    }
+
+    // Sorted random numbers 1 = r_0 >= r_1 >= ... >= r_{ndaug-1} = 0
+    for ( k=0; k<nTry; k++ ) {
+      sorted[0] = 1.0;
+      for ( int il1=1; il1<ndaug-1; il1++ ) {
+	double ran = EvtRandom::Flat();
+	int il2 = il1;
+	while ( ran > sorted[il2-1] ) {
+	  sorted[il2] = sorted[il2-1];
+	  il2--;
+	}
+	sorted[il2] = ran;
+      }
+      sorted[ndaug-1] = 0.0;
+      for ( i=0; i<ndaug; i++ ) rnd[i*nTry+k] = sorted[i];
+    }
+
+    // Masses of the subsystems and the weight
+    double* mLast = &cand[(ndaug-1)*nTry];
+    for ( k=0; k<nTry; k++ ) {
+      mLast[k] = mass[ndaug-1];
+      wt[k] = 1.0;
+    }
+    for ( i=ndaug-2; i>=0; i-- ) {
+      double* m = &cand[i*nTry];
+      const double* mNext = &cand[(i+1)*nTry];
+      const double* r = &rnd[i*nTry];
+      const double* rNext = &rnd[(i+1)*nTry];
+      for ( k=0; k<nTry; k++ ) {
+	m[k] = mNext[k] + mass[i] + ( r[k] - rNext[k] )*( mp - psum );
+	wt[k] *= batchPawt( m[k], mNext[k], mass[i] );
+      }
+    }
+
+    // Keep the accepted ones
+    for ( k=0; k<nTry && accepted<n; k++ ) {
+      tried++;
+      if ( wt[k] > wtmax ) tooLarge = true;
+      if ( wt[k] < EvtRandom::Flat( wtmax ) ) continue;
+      for ( i=0; i<ndaug; i++ ) pm4[i*n+accepted] = cand[i*nTry+k];
+      accepted++;
+    }
+
+  }
+
+  if ( tooLarge ) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "wtmax to small in EvtPhaseSpace with "
+				      << ndaug <<" daughters"<<endl;;
+  }
+
+  // Decay each subsystem into daughter i and the system i+1..ndaug-1.
+  // Daughter i goes to the batch, the rest to pmx.
+  std::vector<double> pme( ndaug*n ), pmx( ndaug*n ), pmy( ndaug*n ), pmz( ndaug*n );
+
+  for ( i=0; i<ndaug-1; i++ ) {
+
+    for ( k=0; k<n; k++ ) {
+      costh[k] = EvtRandom::Flat( -1.0, 1.0 );
+      phi[k] = EvtRandom::Flat( EvtConst::twoPi );
+    }
+
+    const double* m = &pm4[i*n];
+    const double* mNext = &pm4[(i+1)*n];
+    double* e = batch.e(i);
+    double* px = batch.px(i);
+    double* py = batch.py(i);
+    double* pz = batch.pz(i);
+    double* ne = &pme[(i+1)*n];
+    double* nx = &pmx[(i+1)*n];
+    double* ny = &pmy[(i+1)*n];
+    double* nz = &pmz[(i+1)*n];
+
+    for ( k=0; k<n; k++ ) {
+      double pa = batchPawt( m[k], mNext[k], mass[i] );
+      double sinth = sqrt( 1.0 - costh[k]*costh[k] );
+      px[k] = pa*sinth*cos( phi[k] );
+      py[k] = pa*sinth*sin( phi[k] );
+      pz[k] = pa*costh[k];
+      e[k] = sqrt( pa*pa + mass[i]*mass[i] );
+      nx[k] = -px[k];
+      ny[k] = -py[k];
+      nz[k] = -pz[k];
+      ne[k] = sqrt( pa*pa + mNext[k]*mNext[k] );
+    }
+
+  }
+
+  // The last daughter is what is left of the last subsystem
+  {
+    const double* ne = &pme[(ndaug-1)*n];
+    const double* nx = &pmx[(ndaug-1)*n];
+    const double* ny = &pmy[(ndaug-1)*n];
+    const double* nz = &pmz[(ndaug-1)*n];
+    double* e = batch.e(ndaug-1);
+    double* px = batch.px(ndaug-1);
+    double* py = batch.py(ndaug-1);
+    double* pz = batch.pz(ndaug-1);
+    for ( k=0; k<n; k++ ) {
+      e[k] = ne[k]; px[k] = nx[k]; py[k] = ny[k]; pz[k] = nz[k];
+    }
+  }
+
+  // Boost the daughters of each subsystem to the frame of the one above,
+  // from the innermost one out. The outermost system is the parent at rest.
+  for ( i=ndaug-2; i>=1; i-- ) {
+
+    const double* m = &pm4[i*n];
+    const double* be0 = &pme[i*n];
+    const double* be1 = &pmx[i*n];
+    const double* be2 = &pmy[i*n];
+    const double* be3 = &pmz[i*n];
+
+    for ( int d=i; d<ndaug; d++ ) {
+      double* e = batch.e(d);
+      double* px = batch.px(d);
+      double* py = batch.py(d);
+      double* pz = batch.pz(d);
+      for ( k=0; k<n; k++ ) {
+	double b0 = be0[k]/m[k];
+	double b1 = be1[k]/m[k];
+	double b2 = be2[k]/m[k];
+	double b3 = be3[k]/m[k];
+	double bep = b1*px[k] + b2*py[k] + b3*pz[k] + b0*e[k];
+	double temp = ( e[k] + bep )/( b0 + 1.0 );
+	px[k] += temp*b1;
+	py[k] += temp*b2;
+	pz[k] += temp*b3;
+	e[k] = bep;
+      }
+    }
+
+  }
+
+  return n;
+
+}
+
+
 double EvtGenKine::PhaseSpacePole(double M, double m1, double m2, double m3, 
 				  double a,EvtVector4R p4[10])
 
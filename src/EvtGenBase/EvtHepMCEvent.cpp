@@ -15,6 +15,8 @@
 // Modification history:
 //
 //    John Back       June 2011            Module created
+//                    Oct 2026             Lab frame values cached once
+//                                         for the whole tree
 //
 //------------------------------------------------------------------------
 
@@ -62,6 +64,9 @@ void EvtHepMCEvent::constructEvent(EvtParticle* baseParticle, EvtVector4R& trans
   _theEvent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
   _translation = translation;
 
+  // One pass for the lab momenta and vertices used by addVertex
+  baseParticle->cacheLabKinematics();
+
   // Use the recursive function addVertex to add a vertex with incoming/outgoing
   // particles. Adds a new vertex for any EvtParticles with decay daughters.
   // All particles are in the rest frame of the base particle ("lab frame").
@@ -8,6 +8,7 @@
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtId.hh"
 #include "EvtGenBase/EvtRandom.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 
 //-----------------------------------------------------------------------------
 // Implementation file for class : EvtIncoherentMixing
@@ -16,27 +17,26 @@
 //-----------------------------------------------------------------------------
 
 
-bool EvtIncoherentMixing::_doB0Mixing = false ;
-bool EvtIncoherentMixing::_doBsMixing = false ;
-bool EvtIncoherentMixing::_enableFlip = false ;
-double EvtIncoherentMixing::_dGammad = 0. ;
-double EvtIncoherentMixing::_deltamd = 0.502e12 ;
-// dGamma_s corresponds to DeltaGamma / Gamma = 10 %
-double EvtIncoherentMixing::_dGammas = 6.852e10 ;
-double EvtIncoherentMixing::_deltams = 20.e12 ;
+// The mixing parameters are held by the generator context bound to the
+// calling thread (see EvtGenContext).
+namespace {
+  EvtGenContext::IncoherentMixing& params() {
+    return EvtGenContext::current()->getIncoherentMixing() ;
+  }
+}
 
 //=============================================================================
 // Standard constructor, initializes variables
 //=============================================================================
 EvtIncoherentMixing::EvtIncoherentMixing(  ) {
-  _doB0Mixing = false ;
-  _doBsMixing = false ;
-  _dGammad = 0. ;
+  params().doB0Mixing = false ;
+  params().doBsMixing = false ;
+  params().dGammad = 0. ;
   // dGammas corresponds to DeltaGamma / Gamma = 10 %
-  _dGammas = 6.852e10 ;
-  _deltamd = 0.502e12 ;
-  _deltams = 20.e12 ;
-  _enableFlip = false ;
+  params().dGammas = 6.852e10 ;
+  params().deltamd = 0.502e12 ;
+  params().deltams = 20.e12 ;
+  params().enableFlip = false ;
 }
 //=============================================================================
 EvtIncoherentMixing::~EvtIncoherentMixing( ) 
@@ -236,29 +236,29 @@ void EvtIncoherentMixing::OtherB( EvtParticle * p ,
 
 
 // activate or desactivate the Bs mixing
-void EvtIncoherentMixing::setB0Mixing()   { _doB0Mixing = true ; }
-void EvtIncoherentMixing::unsetB0Mixing() { _doB0Mixing = false ; } 
+void EvtIncoherentMixing::setB0Mixing()   { params().doB0Mixing = true ; }
+void EvtIncoherentMixing::unsetB0Mixing() { params().doB0Mixing = false ; } 
 
 // activate or desactivate the B0 mixing
-void EvtIncoherentMixing::setBsMixing()   { _doBsMixing = true ; } 
-void EvtIncoherentMixing::unsetBsMixing() { _doBsMixing = false ; } 
+void EvtIncoherentMixing::setBsMixing()   { params().doBsMixing = true ; } 
+void EvtIncoherentMixing::unsetBsMixing() { params().doBsMixing = false ; } 
 
 // is mixing activated ? 
-bool EvtIncoherentMixing::doB0Mixing()  { return _doB0Mixing ; }
-bool EvtIncoherentMixing::doBsMixing()  { return _doBsMixing ; }
+bool EvtIncoherentMixing::doB0Mixing()  { return params().doB0Mixing ; }
+bool EvtIncoherentMixing::doBsMixing()  { return params().doBsMixing ; }
 
 // set values for the mixing
-void EvtIncoherentMixing::setdGammad( double value )  { _dGammad = value ; } 
-void EvtIncoherentMixing::setdeltamd( double value )  { _deltamd = value ; } 
-void EvtIncoherentMixing::setdGammas( double value )  { _dGammas = value ; } 
-void EvtIncoherentMixing::setdeltams( double value )  { _deltams = value ; } 
+void EvtIncoherentMixing::setdGammad( double value )  { params().dGammad = value ; } 
+void EvtIncoherentMixing::setdeltamd( double value )  { params().deltamd = value ; } 
+void EvtIncoherentMixing::setdGammas( double value )  { params().dGammas = value ; } 
+void EvtIncoherentMixing::setdeltams( double value )  { params().deltams = value ; } 
 
 // get parameters for mixing
-double EvtIncoherentMixing::getdGammad() { return _dGammad ; } 
-double EvtIncoherentMixing::getdeltamd() { return _deltamd ; }
-double EvtIncoherentMixing::getdGammas() { return _dGammas ; } 
-double EvtIncoherentMixing::getdeltams() { return _deltams ; }
+double EvtIncoherentMixing::getdGammad() { return params().dGammad ; } 
+double EvtIncoherentMixing::getdeltamd() { return params().deltamd ; }
+double EvtIncoherentMixing::getdGammas() { return params().dGammas ; } 
+double EvtIncoherentMixing::getdeltams() { return params().deltams ; }
 
-bool EvtIncoherentMixing::flipIsEnabled() { return _enableFlip ; } 
-void EvtIncoherentMixing::enableFlip() { _enableFlip = true ; } 
-void EvtIncoherentMixing::disableFlip() { _enableFlip = false ; } 
+bool EvtIncoherentMixing::flipIsEnabled() { return params().enableFlip ; } 
+void EvtIncoherentMixing::enableFlip() { params().enableFlip = true ; } 
+void EvtIncoherentMixing::disableFlip() { params().enableFlip = false ; } 
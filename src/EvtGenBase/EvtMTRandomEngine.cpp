@@ -16,6 +16,7 @@
 // Modification history:
 //
 //    John Back       Aug 2015            Module created
+//                    Oct 2026            Added randomArray
 //
 //------------------------------------------------------------------------
 //
@@ -42,4 +43,10 @@ double EvtMTRandomEngine::random() {
 
 }
 
+void EvtMTRandomEngine::randomArray(double* values, int n) {
+
+    for (int i=0; i<n; i++) values[i] = distribution_(engine_);
+
+}
+
 #endif
@@ -15,6 +15,9 @@
 // Modification history:
 //
 //    RYD     September 25, 1996         Module created
+//            Oct 2026                   Keep the stored commands
+//            Oct 2026                   Startup profile phase
+//            Oct 2026                   Delete the owned prototypes
 //
 //------------------------------------------------------------------------
 // 
@@ -28,20 +31,37 @@
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtRandom.hh"
 #include "EvtGenBase/EvtModel.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtDecayBase.hh"
 #include "EvtGenBase/EvtParticleDecayList.hh"
 #include "EvtGenBase/EvtParser.hh"
 #include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
 #include <string>
 using std::fstream;
 
-EvtModel* EvtModel::_instance=0;
-
 EvtModel::EvtModel() {
 
 }
 
+EvtModel::~EvtModel() {
+
+  //The prototypes never see init(), so their destructors must not
+  //assume that it has been called. Extra models handed to EvtGen
+  //remain owned by the caller.
+  for (size_t i=0;i<_ownedPrototypes.size();i++){
+    delete _ownedPrototypes[i];
+  }
+
+}
+
+EvtModel& EvtModel::instance() {
+
+  return EvtGenContext::current()->getModelList();
+
+}
+
 EvtDecayBase* EvtModel::getFcn(std::string model_name){
 
   EvtDecayBase *model=0;
@@ -55,12 +75,15 @@ EvtDecayBase* EvtModel::getFcn(std::string model_name){
     return 0;
   }
 
+  EvtStartupProfile::Phase phase("model construction",model_name);
   return model->clone();
 
 }
 
 
-void EvtModel::registerModel(EvtDecayBase* prototype){
+void EvtModel::registerModel(EvtDecayBase* prototype, bool owned){
+
+  if (owned) _ownedPrototypes.push_back(prototype);
 
   std::string modelName= prototype->getName();
 
@@ -104,6 +127,8 @@ void EvtModel::storeCommand(std::string cmd,std::string cnfgstr){
 
   model->command(cnfgstr);
 
+  _storedCommands.push_back(std::make_pair(cmd,cnfgstr));
+
 }
 
 
@@ -15,6 +15,11 @@
 // Modification history:
 //
 //    DJL/RYD     September 25, 1996         Module created
+//                Oct 2026                   Hash indices for the StdHep
+//                                           and LundKC codes
+//                Oct 2026                   Keep the PDT entries and the
+//                                           changes made to them
+//                Oct 2026                   Startup profile phase
 //
 //------------------------------------------------------------------------
 // 
@@ -29,12 +34,42 @@
 #include "EvtGenBase/EvtId.hh"
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
+
+#ifdef EVTGEN_CPP11
+#include <unordered_map>
+#endif
+
 using std::endl;
 using std::fstream;
 using std::ifstream;
 
 static int first=1;
 
+namespace {
+
+#ifdef EVTGEN_CPP11
+  typedef std::unordered_map<int,int> EvtCodeIndex;
+#else
+  typedef std::map<int,int> EvtCodeIndex;
+#endif
+
+  // Particle list entry by StdHep and LundKC code. Only the first entry
+  // with a given code is kept, which is what the linear searches these
+  // replace used to find; aliases come after their particle and so never
+  // replace it.
+  EvtCodeIndex& stdHepIndex() {
+    static EvtCodeIndex s_stdHepIndex;
+    return s_stdHepIndex;
+  }
+
+  EvtCodeIndex& lundKCIndex() {
+    static EvtCodeIndex s_lundKCIndex;
+    return s_lundKCIndex;
+  }
+
+}
+
 unsigned int EvtPDL::_firstAlias;
 int EvtPDL::_nentries;
 
@@ -62,6 +97,7 @@ void EvtPDL::read(const char* fname)
 
 void EvtPDL::readPDT(const std::string fname){
 
+  EvtStartupProfile::Phase phase("EvtPDL::readPDT",fname);
 
   ifstream indec;
   
@@ -79,7 +115,6 @@ void EvtPDL::readPDT(const std::string fname){
   int    spin2;
   double ctau;
   int    lundkc;
-  EvtId i;
 
   if (!indec) {
     EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Could not open:"<<fname.c_str()<<"EvtPDL"<<endl;
@@ -121,55 +156,18 @@ void EvtPDL::readPDT(const std::string fname){
         indec >> lundkc;
 
 
-        i=EvtId(_nentries,_nentries);
-
-	EvtPartProp tmp;
-
-	tmp.setSpinType(EvtSpinType::SCALAR);
-	
-	
-	if (spin2==0) tmp.setSpinType(EvtSpinType::SCALAR);
-	if (spin2==1) tmp.setSpinType(EvtSpinType::DIRAC);
-	if (spin2==2) tmp.setSpinType(EvtSpinType::VECTOR);
-	if (spin2==3) tmp.setSpinType(EvtSpinType::RARITASCHWINGER);
-	if (spin2==4) tmp.setSpinType(EvtSpinType::TENSOR);
-	if (spin2==5) tmp.setSpinType(EvtSpinType::SPIN5HALF);
-	if (spin2==6) tmp.setSpinType(EvtSpinType::SPIN3);
-	if (spin2==7) tmp.setSpinType(EvtSpinType::SPIN7HALF);
-	if (spin2==8) tmp.setSpinType(EvtSpinType::SPIN4);
-	if (spin2==2 && mass < 0.0001 ) tmp.setSpinType(EvtSpinType::PHOTON);
-	if (spin2==1 && mass < 0.0001 ) tmp.setSpinType(EvtSpinType::NEUTRINO);
-	
-	
-	if (!strcmp(pname,"string")){
-	  tmp.setSpinType(EvtSpinType::STRING);
-	}
-	
-	if (!strcmp(pname,"vpho")){
-	  tmp.setSpinType(EvtSpinType::VECTOR);
-	}
-	
-	
-	tmp.setId(i);
-	tmp.setIdChgConj(EvtId(-1,-1));
-	tmp.setStdHep(stdhepid);
-	tmp.setLundKC(lundkc);
-	tmp.setName(pname);
-        if (_particleNameLookup.find(std::string(pname))!=
-	    _particleNameLookup.end()) {
-	    EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"The particle name:"<<pname<<" is already defined."<<endl;
-	    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution.";
-	    ::abort();
-	}
-	_particleNameLookup[std::string(pname)]=_nentries;
-	tmp.setctau(ctau);
-	tmp.setChg3(chg3);
-	
-	tmp.initLineShape(mass,pwidth,pmaxwidth);
-
+        PdtEntry pdtEntry;
+        pdtEntry.name=pname;
+        pdtEntry.stdhep=stdhepid;
+        pdtEntry.mass=mass;
+        pdtEntry.width=pwidth;
+        pdtEntry.maxWidth=pmaxwidth;
+        pdtEntry.chg3=chg3;
+        pdtEntry.spin2=spin2;
+        pdtEntry.ctau=ctau;
+        pdtEntry.lundkc=lundkc;
 
-	partlist().push_back(tmp);
-	_nentries++;
+        addPdtEntry(pdtEntry);
 
       }
 
@@ -192,6 +190,127 @@ void EvtPDL::readPDT(const std::string fname){
 }
 
 
+void EvtPDL::addPdtEntry(const PdtEntry& pdtEntry){
+
+  const std::string& pname=pdtEntry.name;
+  int spin2=pdtEntry.spin2;
+  double mass=pdtEntry.mass;
+
+  EvtId i=EvtId(_nentries,_nentries);
+
+  EvtPartProp tmp;
+
+  tmp.setSpinType(EvtSpinType::SCALAR);
+
+
+  if (spin2==0) tmp.setSpinType(EvtSpinType::SCALAR);
+  if (spin2==1) tmp.setSpinType(EvtSpinType::DIRAC);
+  if (spin2==2) tmp.setSpinType(EvtSpinType::VECTOR);
+  if (spin2==3) tmp.setSpinType(EvtSpinType::RARITASCHWINGER);
+  if (spin2==4) tmp.setSpinType(EvtSpinType::TENSOR);
+  if (spin2==5) tmp.setSpinType(EvtSpinType::SPIN5HALF);
+  if (spin2==6) tmp.setSpinType(EvtSpinType::SPIN3);
+  if (spin2==7) tmp.setSpinType(EvtSpinType::SPIN7HALF);
+  if (spin2==8) tmp.setSpinType(EvtSpinType::SPIN4);
+  if (spin2==2 && mass < 0.0001 ) tmp.setSpinType(EvtSpinType::PHOTON);
+  if (spin2==1 && mass < 0.0001 ) tmp.setSpinType(EvtSpinType::NEUTRINO);
+
+
+  if (pname=="string"){
+    tmp.setSpinType(EvtSpinType::STRING);
+  }
+
+  if (pname=="vpho"){
+    tmp.setSpinType(EvtSpinType::VECTOR);
+  }
+
+
+  tmp.setId(i);
+  tmp.setIdChgConj(EvtId(-1,-1));
+  tmp.setStdHep(pdtEntry.stdhep);
+  tmp.setLundKC(pdtEntry.lundkc);
+  tmp.setName(pname);
+  if (_particleNameLookup.find(pname)!=
+      _particleNameLookup.end()) {
+      EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"The particle name:"<<pname<<" is already defined."<<endl;
+      EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution.";
+      ::abort();
+  }
+  _particleNameLookup[pname]=_nentries;
+  tmp.setctau(pdtEntry.ctau);
+  tmp.setChg3(pdtEntry.chg3);
+
+  tmp.initLineShape(mass,pdtEntry.width,pdtEntry.maxWidth);
+
+
+  partlist().push_back(tmp);
+  pdtEntries().push_back(pdtEntry);
+  indexCodes(_nentries);
+  _nentries++;
+
+}
+
+void EvtPDL::addChange(int type, EvtId i, EvtId j, EvtId k, int value,
+		       double number, const std::string& name){
+
+  Change change;
+  change.type=type;
+  change.entry[0]=i.getAlias();
+  change.entry[1]=j.getAlias();
+  change.entry[2]=k.getAlias();
+  change.value=value;
+  change.number=number;
+  change.name=name;
+
+  //Each further generator reads the user decay files again. A change
+  //of the same property of the same particles replaces the earlier one
+  //and moves to the end, so the journal keeps one entry per property.
+  std::vector<Change>& list=changes();
+  for (size_t n=0;n<list.size();n++){
+    const Change& old=list[n];
+    if (old.type==type && old.entry[0]==change.entry[0] &&
+	old.entry[1]==change.entry[1] && old.entry[2]==change.entry[2] &&
+	(type!=Change::ALIAS || old.name==name)) {
+      list.erase(list.begin()+n);
+      break;
+    }
+  }
+
+  list.push_back(change);
+
+}
+
+void EvtPDL::applyChange(const Change& change){
+
+  EvtId id[3];
+  for (int i=0;i<3;i++){
+    if (change.entry[i]>=0) id[i]=getEntry(change.entry[i]);
+  }
+
+  std::string name(change.name);
+
+  switch (change.type){
+  case Change::ALIAS: alias(id[0],name); break;
+  case Change::ALIASCHGCONJ: aliasChgConj(id[0],id[1]); break;
+  case Change::MASS: reSetMass(id[0],change.number); break;
+  case Change::WIDTH: reSetWidth(id[0],change.number); break;
+  case Change::MASSMIN: reSetMassMin(id[0],change.number); break;
+  case Change::MASSMAX: reSetMassMax(id[0],change.number); break;
+  case Change::BLATT: reSetBlatt(id[0],change.number); break;
+  case Change::BLATTBIRTH: reSetBlattBirth(id[0],change.number); break;
+  case Change::BIRTHFACTOR: includeBirthFactor(id[0],change.value!=0); break;
+  case Change::DECAYFACTOR: includeDecayFactor(id[0],change.value!=0); break;
+  case Change::LINESHAPE: changeLS(id[0],name); break;
+  case Change::PWDECAY: setPWForDecay(id[0],change.value,id[1],id[2]); break;
+  case Change::PWBIRTH: setPWForBirthL(id[0],change.value,id[1],id[2]); break;
+  default:
+    EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"Unknown particle property change "
+				      <<change.type<<endl;
+    ::abort();
+  }
+
+}
+
 void EvtPDL::aliasChgConj(EvtId a,EvtId abar){
 
   if (EvtPDL::chargeConj(EvtId(a.getId(),a.getId()))!=
@@ -206,6 +325,7 @@ void EvtPDL::aliasChgConj(EvtId a,EvtId abar){
 
   partlist()[a.getAlias()].setIdChgConj(abar);
   partlist()[abar.getAlias()].setIdChgConj(a);
+  addChange(Change::ALIASCHGCONJ,a,abar);
 
 }
 
@@ -236,11 +356,12 @@ EvtId EvtPDL::chargeConj(EvtId id){
 
   }
 
-  for (size_t i=0;i<partlist().size();i++){
-    if (partlist()[i].getStdHep()==-partlist()[id.getId()].getStdHep()){
-      partlist()[id.getId()].setIdChgConj(partlist()[i].getId());
-      return partlist()[i].getId();
-    }
+  EvtCodeIndex::const_iterator it=
+    stdHepIndex().find(-partlist()[id.getId()].getStdHep());
+  if (it!=stdHepIndex().end()){
+    EvtId idConj=partlist()[it->second].getId();
+    partlist()[id.getId()].setIdChgConj(idConj);
+    return idConj;
   }
   
   partlist()[id.getId()].setIdChgConj(id);
@@ -250,19 +371,34 @@ EvtId EvtPDL::chargeConj(EvtId id){
 
 EvtId EvtPDL::evtIdFromStdHep(int stdhep){
 
-  for (size_t i=0;i<partlist().size();i++){
-    if (partlist()[i].getStdHep()==stdhep)
-      return partlist()[i].getId();
-  }
-  
-  return EvtId(-1,-1);
+  EvtCodeIndex::const_iterator it=stdHepIndex().find(stdhep);
+  if (it==stdHepIndex().end()) return EvtId(-1,-1);
+
+  return partlist()[it->second].getId();
   
 }
 
+void EvtPDL::indexCodes(int entry){
+
+  // insert leaves an existing entry for the same code in place
+  stdHepIndex().insert(std::make_pair(partlist()[entry].getStdHep(),entry));
+  lundKCIndex().insert(std::make_pair(partlist()[entry].getLundKC(),entry));
+
+}
+
 
 
 void EvtPDL::alias(EvtId num,const std::string& newname){
-  
+
+  //A further generator reading the same decay file defines
+  //the same aliases again; keep using the existing entry.
+  std::map<std::string,int>::iterator it=_particleNameLookup.find(newname);
+  if ( it!=_particleNameLookup.end() &&
+       it->second>=static_cast<int>(_firstAlias) &&
+       partlist()[it->second].getId().getId()==num.getId() ) {
+    return;
+  }
+
   if ( _firstAlias < partlist().size() ) {
     for(size_t i=_firstAlias;i<partlist().size();i--){
       if (newname==partlist()[i].getName()){
@@ -288,6 +424,8 @@ void EvtPDL::alias(EvtId num,const std::string& newname){
   partlist()[entry].setId(EvtId(num.getId(),entry));
   //Lange - Dec7, 2003. Unset the charge conjugate.
   partlist()[entry].setIdChgConj(EvtId(-1,-1));
+  indexCodes(entry);
+  addChange(Change::ALIAS,num,EvtId(-1,-1),EvtId(-1,-1),0,0.0,newname);
 
 }
 
@@ -308,14 +446,10 @@ void EvtPDL::setUpConstsPdt(){
 // Function to get EvtId from LundKC ( == Pythia Hep Code , KF ) 
 EvtId EvtPDL::evtIdFromLundKC(int pythiaId){
 
-  unsigned int i;
+  EvtCodeIndex::const_iterator it=lundKCIndex().find(pythiaId);
+  if (it==lundKCIndex().end()) return EvtId(-1,-1);
 
-  for (i=0;i<partlist().size();i++){
-    if (partlist()[i].getLundKC()==pythiaId)
-      return partlist()[i].getId();
-  }
-  
-  return EvtId(-1,-1);
+  return partlist()[it->second].getId();
   
 }
  
@@ -389,44 +523,55 @@ EvtId EvtPDL::getEntry(int i) {
 
 void EvtPDL::reSetMass(EvtId i, double mass) {
   partlist()[i.getId()].reSetMass(mass);
+  addChange(Change::MASS,i,EvtId(-1,-1),EvtId(-1,-1),0,mass);
 }
 
 void EvtPDL::reSetWidth(EvtId i, double width) { 
   partlist()[i.getId()].reSetWidth(width);
+  addChange(Change::WIDTH,i,EvtId(-1,-1),EvtId(-1,-1),0,width);
 }
 
 void EvtPDL::reSetMassMin(EvtId i, double mass) { 
   partlist()[i.getId()].reSetMassMin(mass);
+  addChange(Change::MASSMIN,i,EvtId(-1,-1),EvtId(-1,-1),0,mass);
 }
 
 void EvtPDL::reSetMassMax(EvtId i,double mass) { 
   partlist()[i.getId()].reSetMassMax(mass);
+  addChange(Change::MASSMAX,i,EvtId(-1,-1),EvtId(-1,-1),0,mass);
 }
 
 void EvtPDL::reSetBlatt(EvtId i,double blatt) {
   partlist()[i.getId()].reSetBlatt(blatt);
+  addChange(Change::BLATT,i,EvtId(-1,-1),EvtId(-1,-1),0,blatt);
 }
 
 void EvtPDL::reSetBlattBirth(EvtId i,double blatt) {
   partlist()[i.getId()].reSetBlattBirth(blatt);
+  addChange(Change::BLATTBIRTH,i,EvtId(-1,-1),EvtId(-1,-1),0,blatt);
 }
 
 void EvtPDL::includeBirthFactor(EvtId i,bool yesno) {
   partlist()[i.getId()].includeBirthFactor(yesno);
+  addChange(Change::BIRTHFACTOR,i,EvtId(-1,-1),EvtId(-1,-1),yesno);
 }
 
 void EvtPDL::includeDecayFactor(EvtId i,bool yesno) {
   partlist()[i.getId()].includeDecayFactor(yesno);
+  addChange(Change::DECAYFACTOR,i,EvtId(-1,-1),EvtId(-1,-1),yesno);
 }
 
 void EvtPDL::changeLS(EvtId i, std::string &newLS ) { 
   partlist()[i.getId()].newLineShape(newLS);
+  addChange(Change::LINESHAPE,i,EvtId(-1,-1),EvtId(-1,-1),0,0.0,newLS);
 }
 
 void EvtPDL::setPWForDecay(EvtId i, int spin, EvtId d1, EvtId d2) {  
   partlist()[i.getId()].setPWForDecay(spin,d1,d2);
+  addChange(Change::PWDECAY,i,d1,d2,spin);
 }
 
 void EvtPDL::setPWForBirthL(EvtId i, int spin, EvtId par, EvtId othD) {  
   partlist()[i.getId()].setPWForBirthL(spin,par,othD);
+  addChange(Change::PWBIRTH,i,par,othD,spin);
 }
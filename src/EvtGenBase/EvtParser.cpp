@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    RYD     Febuary 11, 1998        Module created
+//            Oct 2026                Startup profile phase
 //
 //------------------------------------------------------------------------
 // 
@@ -25,6 +26,7 @@
 #include <string.h>
 #include "EvtGenBase/EvtParser.hh"
 #include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtStartupProfile.hh"
 using namespace std;
 
 #define MAXBUF 1024
@@ -63,6 +65,9 @@ int EvtParser::getLineofToken(int i){
 }
 
 int EvtParser::read(const std::string filename){
+
+  EvtStartupProfile::Phase phase("EvtParser::read",filename);
+
   ifstream fin;
   
   fin.open(filename.c_str());
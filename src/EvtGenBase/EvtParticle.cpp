@@ -15,6 +15,11 @@
 // Modification history:
 //
 //    DJL/RYD     September 25, 1996         Module created
+//                Oct 2026                   Allocate particles from the
+//                                           EvtParticlePool of the context
+//                Oct 2026                   Count the mass tree retries
+//                Oct 2026                   Cache of the lab frame momenta
+//                                           and vertices of a tree
 //
 //------------------------------------------------------------------------
 // 
@@ -23,6 +28,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <assert.h>
 #include <sys/stat.h>
 #include "EvtGenBase/EvtParticle.hh"
 #include "EvtGenBase/EvtId.hh"
@@ -46,15 +52,94 @@
 #include "EvtGenBase/EvtParticleFactory.hh"
 #include "EvtGenBase/EvtIdSet.hh"
 #include "EvtGenBase/EvtStatus.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtParticlePool.hh"
+
+#ifdef EVTGEN_CPP11
+#include <atomic>
+#endif
 
 using std::endl;
 
+namespace {
+
+  // Incremented by every change of a particle on this thread. A thread
+  // moves to its own multiple of 2^40 when it first caches lab values, so
+  // that a value cached on one thread is never taken as valid on another;
+  // _labVersion is 0 or at least 2^40, and never equals the count of a
+  // thread which has not cached. The initial value is a constant, so the
+  // thread_local needs no initialisation check when it is read.
+  const uint64_t threadVersionStep = uint64_t(1) << 40;
+#ifdef EVTGEN_CPP11
+  std::atomic<uint64_t> lastThreadVersion(0);
+  thread_local uint64_t treeVersion = 1;
+#else
+  uint64_t treeVersion = 1;
+#endif
+
+  // Lorentz transformation from a rest frame to the lab frame
+  void setIdentity(double frame[4][4]) {
+    for (int i=0; i<4; i++) {
+      for (int j=0; j<4; j++) frame[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+  }
+
+  // frame = frame * (the boost of EvtVector4R::applyBoostTo(p4))
+  void appendBoost(double frame[4][4], const EvtVector4R& p4) {
+
+    double e=p4.get(0);
+    double b[3] = {p4.get(1)/e, p4.get(2)/e, p4.get(3)/e};
+    double b2=b[0]*b[0]+b[1]*b[1]+b[2]*b[2];
+
+    if (!(b2 > 0.0 && b2 < 1.0)) return;
+
+    double gamma=1.0/sqrt(1.0-b2);
+    double gb2=(gamma-1.0)/b2;
+
+    double boost[4][4];
+    boost[0][0]=gamma;
+    for (int i=0; i<3; i++) {
+      boost[0][i+1]=gamma*b[i];
+      boost[i+1][0]=gamma*b[i];
+      for (int j=0; j<3; j++) boost[i+1][j+1]=gb2*b[i]*b[j]+(i == j ? 1.0 : 0.0);
+    }
+
+    for (int i=0; i<4; i++) {
+      double row[4];
+      for (int j=0; j<4; j++) {
+	row[j]=frame[i][0]*boost[0][j]+frame[i][1]*boost[1][j]+
+	  frame[i][2]*boost[2][j]+frame[i][3]*boost[3][j];
+      }
+      for (int j=0; j<4; j++) frame[i][j]=row[j];
+    }
+
+  }
+
+  EvtVector4R transform(const double frame[4][4], const EvtVector4R& p4) {
+    double v[4];
+    for (int i=0; i<4; i++) {
+      v[i]=frame[i][0]*p4.get(0)+frame[i][1]*p4.get(1)+
+	frame[i][2]*p4.get(2)+frame[i][3]*p4.get(3);
+    }
+    return EvtVector4R(v[0],v[1],v[2],v[3]);
+  }
+
+}
+
 
 
 EvtParticle::~EvtParticle() {
   delete _decayProb;
 }
 
+void* EvtParticle::operator new(std::size_t size) {
+  return EvtGenContext::current()->getParticlePool()->allocate(size);
+}
+
+void EvtParticle::operator delete(void* p) {
+  EvtParticlePool::release(p);
+}
+
 EvtParticle::EvtParticle() {
    _ndaug=0;
    _parent=0;
@@ -66,6 +151,7 @@ EvtParticle::EvtParticle() {
    _validP4=false;
    _isDecayed=false;
    _decayProb=0;
+   _labVersion=0;
    _intAttributes.clear();
    _dblAttributes.clear();
    //   _mix=false;
@@ -88,11 +174,13 @@ EvtParticle *EvtParticle::getParent() const { return _parent;}
 
 void EvtParticle::setLifetime(double tau){
   _t=tau;
+  treeChanged();
 }
 
 void EvtParticle::setLifetime(){
   if (_genlifetime){
     _t=-log(EvtRandom::Flat())*EvtPDL::getctau(getId());
+    treeChanged();
   }
 }
 
@@ -105,6 +193,14 @@ void EvtParticle::addDaug(EvtParticle *node) {
   node->_daug[node->_ndaug++]=this;
   _ndaug=0;
   _parent=node; 
+  treeChanged();
+}
+
+void EvtParticle::treeChanged() {
+  // Changing a particle only drops the values cached on this thread
+  assert(_labVersion < threadVersionStep ||
+	 _labVersion/threadVersionStep == treeVersion/threadVersionStep);
+  treeVersion++;
 }
 
 
@@ -503,6 +599,12 @@ bool EvtParticle::generateMassTree() {
     }
   }
 
+  // The retries go to the statistics of the channel finally taken
+  if (counter > 1) {
+    EvtDecayBase* decayer = EvtDecayTable::getInstance()->getDecayFunc(p);
+    if (decayer) decayer->addMassTreeRetries(counter-1);
+  }
+
   return isOK;
 
 }
@@ -549,6 +651,7 @@ void EvtParticle::deleteDaughters(bool keepChannel){
   if ( !keepChannel) _channel=-10;
   _first=1;
   _isInit=false;
+  treeChanged();
 }
 
 void EvtParticle::deleteTree(){
@@ -695,6 +798,8 @@ EvtRaritaSchwinger EvtParticle::spRS(int i) const {
 
 
 EvtVector4R EvtParticle::getP4Lab() const {
+  if (_labVersion == treeVersion) return _p4Lab;
+
   EvtVector4R temp,mom;
   const EvtParticle *ptemp;
   
@@ -734,6 +839,8 @@ EvtVector4R EvtParticle::getP4Restframe() const {
 
 EvtVector4R EvtParticle::get4Pos() const {
 
+  if (_labVersion == treeVersion) return _pos;
+
   EvtVector4R temp,mom;
   EvtParticle *ptemp;
   
@@ -754,6 +861,56 @@ EvtVector4R EvtParticle::get4Pos() const {
   return temp;
 }
 
+void EvtParticle::cacheLabKinematics() {
+
+  // The frame of the parent, composed from the root down
+  std::vector<const EvtParticle*> ancestors;
+  for (const EvtParticle* p=_parent; p!=0; p=p->_parent) ancestors.push_back(p);
+
+  double frame[4][4];
+  setIdentity(frame);
+  for (size_t i=ancestors.size(); i>0; i--) appendBoost(frame, ancestors[i-1]->_p);
+
+  EvtVector4R pos = get4Pos();
+
+  if (treeVersion < threadVersionStep) {
+#ifdef EVTGEN_CPP11
+    treeVersion = (++lastThreadVersion)*threadVersionStep;
+#else
+    treeVersion = threadVersionStep;
+#endif
+  }
+
+  cacheLabKinematicsRec(frame, pos, treeVersion);
+
+}
+
+void EvtParticle::cacheLabKinematicsRec(const double parentFrame[4][4],
+					const EvtVector4R& pos, uint64_t version) {
+
+  // The composed transformation rather than the lab momentum is handed
+  // down, as successive boosts differ from the boost to the lab frame
+  // by a rotation.
+  _p4Lab = transform(parentFrame, _p);
+  _pos = pos;
+  _labVersion = version;
+
+  if (_ndaug == 0) return;
+
+  double frame[4][4];
+  for (int i=0; i<4; i++) {
+    for (int j=0; j<4; j++) frame[i][j] = parentFrame[i][j];
+  }
+  appendBoost(frame, _p);
+
+  EvtVector4R decayPos = pos+(_t/mass())*_p4Lab;
+
+  for (size_t i=0; i<_ndaug; i++) {
+    _daug[i]->cacheLabKinematicsRec(frame, decayPos, version);
+  }
+
+}
+
 
 EvtParticle * EvtParticle::nextIter(EvtParticle *rootOfTree) {
 
@@ -788,6 +945,8 @@ EvtParticle * EvtParticle::nextIter(EvtParticle *rootOfTree) {
 void EvtParticle::makeStdHep(EvtStdHep& stdhep,EvtSecondary& secondary,
 			     EvtId *list_of_stable){
 
+  cacheLabKinematics();
+
   //first add particle to the stdhep list;
   stdhep.createParticle(getP4Lab(),get4Pos(),-1,-1,
 			EvtPDL::getStdHep(getId()));
@@ -821,6 +980,8 @@ void EvtParticle::makeStdHep(EvtStdHep& stdhep,EvtSecondary& secondary,
 
 void EvtParticle::makeStdHep(EvtStdHep& stdhep){
 
+  cacheLabKinematics();
+
   //first add particle to the stdhep list;
   stdhep.createParticle(getP4Lab(),get4Pos(),-1,-1,
 			EvtPDL::getStdHep(getId()));
@@ -1036,8 +1197,8 @@ double EvtParticle::initializePhaseSpace(
   //lange
   //  this->makeDaughters(numdaughter,daughters);
 
-  static EvtVector4R p4[100];
-  static double mass[100];
+  EvtVector4R p4[100];
+  double mass[100];
 
   m_b = this->mass();
 
@@ -15,6 +15,10 @@
 // Modification history:
 //
 //    RYD     April 5, 1997         Module created
+//            Oct 2026              Channels are picked from alias
+//                                  tables per threshold mass
+//            Oct 2026              Lazily initialised models are
+//                                  initialised when picked
 //
 //------------------------------------------------------------------------
 //
@@ -30,10 +34,16 @@
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtPDL.hh"
 #include "EvtGenBase/EvtStatus.hh"
+#include "EvtGenBase/EvtAliasTable.hh"
+#include "EvtGenBase/EvtDecayBase.hh"
+
+#include <algorithm>
+
 using std::endl;
 using std::fstream;
 
 EvtParticleDecayList::EvtParticleDecayList(const EvtParticleDecayList &o) {
+  _channelTablesBuilt=false;
   _nmode=o._nmode;
   _rawbrfrsum=o._rawbrfrsum;
   _decaylist=new EvtParticleDecayPtr[_nmode];
@@ -77,6 +87,8 @@ EvtParticleDecayList::EvtParticleDecayList(const EvtParticleDecayList &o) {
 
 EvtParticleDecayList::~EvtParticleDecayList(){
 
+  clearChannelTables();
+
   int i;
   for(i=0;i<_nmode;i++){
     delete _decaylist[i];
@@ -96,6 +108,8 @@ void EvtParticleDecayList::printSummary(){
 
 void EvtParticleDecayList::removeDecay(){
   
+  clearChannelTables();
+
   int i;
   for(i=0;i<_nmode;i++){
     delete _decaylist[i];
@@ -124,6 +138,15 @@ EvtDecayBase* EvtParticleDecayList::getDecayModel(int imode) {
 
 EvtDecayBase* EvtParticleDecayList::getDecayModel(EvtParticle *p){
 
+  EvtDecayBase* theModel=pickDecayModel(p);
+  if (theModel != 0) theModel->ensureInit();
+
+  return theModel;
+
+}
+
+EvtDecayBase* EvtParticleDecayList::pickDecayModel(EvtParticle *p){
+
   if (p->getNDaug()!=0) {
     assert(p->getChannel()>=0);
     return getDecay(p->getChannel()).getDecayModel();
@@ -150,78 +173,107 @@ EvtDecayBase* EvtParticleDecayList::getDecayModel(EvtParticle *p){
     ::abort();
   }
 
-  int j;
+  // Picking from the branching fractions of the open channels only gives
+  // the same distribution as picking from all of them and trying again
+  // until the channel is open.
+  const EvtAliasTable* table=getChannelTable(p);
 
-  for (j=0;j<10000000;j++){
+  if (!table->empty()) {
+    int i=table->pick(EvtRandom::Flat());
+    p->setChannel(i);
+    return getDecay(i).getDecayModel(); 
+  }
 
-    double u=EvtRandom::Flat();
+  //No kinematically allowed channel with a non-zero branching fraction,
+  //the particle will not be decayed!
 
-    int i;
-    bool breakL=false;
-    for (i=0;i<getNMode();i++) {
-
-      if ( breakL ) continue;
-      if (u<getDecay(i).getBrfrSum()) {
-	breakL=true;
-	//special case for decay of on particel to another
-	// e.g. K0->K0S
-
-	if (getDecay(i).getDecayModel()->getNDaug()==1 ) {
-	  p->setChannel(i);
-	  return getDecay(i).getDecayModel(); 
-	} 
-
-	if ( p->hasValidP4() ) {
-	  if (getDecay(i).getMassMin() < p->mass() ) {
-	    p->setChannel(i);
-	    return getDecay(i).getDecayModel(); 
-	  }
-	}
-	else{
-	    //Lange apr29-2002 - dont know the mass yet
-	    p->setChannel(i);
-	    return getDecay(i).getDecayModel(); 
-	}
+  EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Could not decay:"
+			 <<EvtPDL::name(p->getId()).c_str()
+			 <<" with mass:"<<p->mass()
+			 <<" will throw event away! "<<endl;
+  
+  EvtStatus::setRejectFlag();
+  return 0;
+
+}
+
+
+const EvtAliasTable* EvtParticleDecayList::getChannelTable(EvtParticle* p){
+
+  int i;
+
+  if (!_channelTablesBuilt) {
+
+    // Decays of one particle to another (e.g. K0->K0S) are always open
+    _channelThreshold.assign(_nmode,-1);
+    _thresholds.clear();
+    for (i=0;i<_nmode;i++) {
+      if (getDecay(i).getDecayModel()->getNDaug()!=1) {
+	_thresholds.push_back(getDecay(i).getMassMin());
+      }
+    }
+    std::sort(_thresholds.begin(),_thresholds.end());
+    _thresholds.erase(std::unique(_thresholds.begin(),_thresholds.end()),
+		      _thresholds.end());
+
+    for (i=0;i<_nmode;i++) {
+      if (getDecay(i).getDecayModel()->getNDaug()!=1) {
+	_channelThreshold[i]=std::lower_bound(_thresholds.begin(),
+					      _thresholds.end(),
+					      getDecay(i).getMassMin())
+	  -_thresholds.begin();
       }
     }
+
+    _channelTables.assign(_thresholds.size()+1,(EvtAliasTable*)0);
+    _channelTablesBuilt=true;
+
   }
 
-  //Ok, we tried 10000000 times above to pick a decay channel that is
-  //kinematically allowed! Now we give up and search all channels!
-  //if that fails, the particle will not be decayed!
-  
-  EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Tried 10000000 times to generate decay of "
-                         << EvtPDL::name(p->getId())<< " with mass="<<p->mass()<<endl;
-  EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will take first kinematically allowed decay in the decay table" 
-			 <<endl;
+  // A channel is open if its minimum mass is below the parent mass; as
+  // long as the mass is not known yet, all channels are taken as open.
+  size_t interval=_thresholds.size();
+  if ( p->hasValidP4() ) {
+    interval=std::lower_bound(_thresholds.begin(),_thresholds.end(),
+			      p->mass())-_thresholds.begin();
+  }
 
-  int i;
+  if (_channelTables[interval]==0) {
 
-  //Need to check that we don't use modes with 0 branching fractions.
-  double previousBrSum=0.0;
-  for (i=0;i<getNMode();i++) {
-      if(getDecay(i).getBrfrSum()!=previousBrSum){
-	  if ( getDecay(i).getMassMin() < p->mass() ) {
-	      p->setChannel(i);
-	      return getDecay(i).getDecayModel(); 
-	  }
+    std::vector<double> weights(_nmode,0.0);
+    double previousBrSum=0.0;
+    for (i=0;i<_nmode;i++) {
+      double brfrSum=getDecay(i).getBrfrSum();
+      if (_channelThreshold[i]<static_cast<int>(interval)) {
+	weights[i]=brfrSum-previousBrSum;
       }
-      previousBrSum=getDecay(i).getBrfrSum();
+      previousBrSum=brfrSum;
+    }
+
+    _channelTables[interval]=new EvtAliasTable(weights);
+
   }
 
-  EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Could not decay:"
-			 <<EvtPDL::name(p->getId()).c_str()
-			 <<" with mass:"<<p->mass()
-			 <<" will throw event away! "<<endl;
-  
-  EvtStatus::setRejectFlag();
-  return 0;
+  return _channelTables[interval];
 
 }
 
+void EvtParticleDecayList::clearChannelTables(){
+
+  for (size_t i=0;i<_channelTables.size();i++){
+    delete _channelTables[i];
+  }
+  _channelTables.clear();
+  _thresholds.clear();
+  _channelThreshold.clear();
+  _channelTablesBuilt=false;
+
+}
 
 void EvtParticleDecayList::setNMode(int nmode){
 
+  clearChannelTables();
+
   EvtParticleDecayPtr* _decaylist_new= new EvtParticleDecayPtr[nmode];
 
   if (_nmode!=0){
@@ -265,6 +317,8 @@ void EvtParticleDecayList::makeChargeConj(EvtParticleDecayList* conjDecayList){
 void EvtParticleDecayList::addMode(EvtDecayBase* decay, double brfrsum,
 				   double massmin){
 
+  clearChannelTables();
+
   EvtParticleDecayPtr* newlist=new EvtParticleDecayPtr[_nmode+1];
 
   int i;
@@ -314,6 +368,8 @@ void EvtParticleDecayList::addMode(EvtDecayBase* decay, double brfrsum,
 
 void EvtParticleDecayList::finalize(){
 
+  clearChannelTables();
+
   if (_nmode>0) {
     if ( _rawbrfrsum< 0.000001 ) {
       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Please give me a "
@@ -388,6 +444,8 @@ EvtParticleDecayList& EvtParticleDecayList::operator=(const EvtParticleDecayList
 
 
 void EvtParticleDecayList::removeMode(EvtDecayBase* decay) {
+
+   clearChannelTables();
    // here we will delete a decay with the same final state particles
    // and recalculate the branching fractions for the remaining modes
    int match = -1;
@@ -0,0 +1,200 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtParticlePool
+//
+// Description: Memory pool for EvtParticle objects, see EvtParticlePool.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtParticlePool.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+
+#include <new>
+
+const std::size_t EvtParticlePool::headerSize;
+const std::size_t EvtParticlePool::granularity;
+const int EvtParticlePool::nSizeClasses;
+const std::size_t EvtParticlePool::chunkSize;
+
+EvtParticlePool::EvtParticlePool() :
+  _freeLists(nSizeClasses, (void*)0),
+  _chunkUsed(chunkSize),
+  _inUse(0),
+  _remoteBalance(0),
+  _destroyed(false),
+#ifdef EVTGEN_CPP11
+  _owner(std::this_thread::get_id()),
+#endif
+  _remoteFree(0)
+{
+}
+
+EvtParticlePool::~EvtParticlePool() {
+
+  for (size_t i=0; i<_chunks.size(); i++) {
+    delete [] _chunks[i];
+  }
+
+}
+
+void EvtParticlePool::destroy() {
+
+  // From here on every release goes through releaseRemote
+  _destroyed = true;
+
+#ifdef EVTGEN_CPP11
+  long left = _remoteBalance.fetch_add(_inUse)+_inUse;
+#else
+  long left = _remoteBalance += _inUse;
+#endif
+  if (left == 0) delete this;
+
+}
+
+void* EvtParticlePool::allocate(std::size_t size) {
+
+  int sizeClass = (size+granularity-1)/granularity;
+  if (sizeClass == 0) sizeClass = 1;
+
+  void* block;
+
+  if (sizeClass >= nSizeClasses) {
+    // Too large to pool; the header tells release to use the heap
+    block = ::operator new(headerSize+size);
+    Header* header = static_cast<Header*>(block);
+    header->pool = 0;
+    header->sizeClass = -1;
+    return static_cast<char*>(block)+headerSize;
+  }
+
+#ifdef EVTGEN_CPP11
+  std::thread::id self = std::this_thread::get_id();
+  if (_owner.load(std::memory_order_relaxed) != self) {
+    _owner.store(self, std::memory_order_relaxed);
+  }
+#endif
+
+  block = _freeLists[sizeClass];
+  if (block == 0) {
+    collectRemote();
+    block = _freeLists[sizeClass];
+  }
+
+  if (block != 0) {
+    _freeLists[sizeClass] = next(block);
+  } else {
+    block = newBlock(sizeClass);
+  }
+
+  _inUse++;
+  return static_cast<char*>(block)+headerSize;
+
+}
+
+void EvtParticlePool::release(void* pointer) {
+
+  if (pointer == 0) return;
+
+  void* block = static_cast<char*>(pointer)-headerSize;
+  EvtParticlePool* pool = static_cast<Header*>(block)->pool;
+
+  if (pool == 0) {
+    ::operator delete(block);
+    return;
+  }
+
+#ifdef EVTGEN_CPP11
+  bool owner = pool->_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+#else
+  bool owner = EvtGenContext::current()->getParticlePool() == pool;
+#endif
+
+  if (owner && !pool->_destroyed) {
+    pool->freeLocal(block);
+    pool->_inUse--;
+    return;
+  }
+
+  pool->releaseRemote(block);
+
+}
+
+void EvtParticlePool::releaseRemote(void* block) {
+
+  // Not the owning thread: hand the block back for the owner to reuse.
+#ifdef EVTGEN_CPP11
+  void* head = _remoteFree.load(std::memory_order_relaxed);
+  do {
+    next(block) = head;
+  } while (!_remoteFree.compare_exchange_weak(head, block,
+					      std::memory_order_release,
+					      std::memory_order_relaxed));
+  long left = _remoteBalance.fetch_sub(1, std::memory_order_acq_rel)-1;
+#else
+  next(block) = _remoteFree;
+  _remoteFree = block;
+  long left = --_remoteBalance;
+#endif
+
+  // Only reached after destroy, which made the balance positive
+  if (left == 0) delete this;
+
+}
+
+void* EvtParticlePool::newBlock(int sizeClass) {
+
+  std::size_t blockSize = headerSize+sizeClass*granularity;
+
+  if (_chunkUsed+blockSize > chunkSize) {
+    _chunks.push_back(new char[chunkSize]);
+    _chunkUsed = 0;
+  }
+
+  void* block = _chunks.back()+_chunkUsed;
+  _chunkUsed += blockSize;
+
+  Header* header = static_cast<Header*>(block);
+  header->pool = this;
+  header->sizeClass = sizeClass;
+
+  return block;
+
+}
+
+void EvtParticlePool::collectRemote() {
+
+#ifdef EVTGEN_CPP11
+  void* block = _remoteFree.exchange(0, std::memory_order_acquire);
+#else
+  void* block = _remoteFree;
+  _remoteFree = 0;
+#endif
+
+  // These were counted as released by releaseRemote
+  while (block != 0) {
+    void* following = next(block);
+    freeLocal(block);
+    block = following;
+  }
+
+}
+
+void EvtParticlePool::freeLocal(void* block) {
+
+  int sizeClass = static_cast<Header*>(block)->sizeClass;
+  next(block) = _freeLists[sizeClass];
+  _freeLists[sizeClass] = block;
+
+}
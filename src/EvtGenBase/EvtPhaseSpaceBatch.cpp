@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtPhaseSpaceBatch
+//
+// Description: Batch of phase space configurations, see EvtPhaseSpaceBatch.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtPhaseSpaceBatch.hh"
+#include "EvtGenBase/EvtVector4R.hh"
+
+EvtPhaseSpaceBatch::EvtPhaseSpaceBatch() :
+  _nDaug(0),
+  _size(0),
+  _position(0),
+  _mp(0.0)
+{
+}
+
+void EvtPhaseSpaceBatch::resize(int nDaug, int nEvents) {
+
+  if (nDaug < 0) nDaug = 0;
+  if (nEvents < 0) nEvents = 0;
+
+  _nDaug = nDaug;
+  _size = nEvents;
+  _position = 0;
+
+  std::vector<double>::size_type n = nDaug*nEvents;
+  _e.resize(n);
+  _px.resize(n);
+  _py.resize(n);
+  _pz.resize(n);
+
+}
+
+EvtVector4R EvtPhaseSpaceBatch::getP4(int daug, int event) const {
+
+  int i = daug*_size+event;
+  return EvtVector4R(_e[i], _px[i], _py[i], _pz[i]);
+
+}
+
+void EvtPhaseSpaceBatch::setKinematics(int nDaug, const double mass[], double mp) {
+
+  _mass.assign(mass, mass+nDaug);
+  _mp = mp;
+  _size = 0;
+  _position = 0;
+
+}
+
+bool EvtPhaseSpaceBatch::matches(int nDaug, const double mass[], double mp) const {
+
+  if (mp != _mp || nDaug != (int)_mass.size()) return false;
+  for (int i=0; i<nDaug; i++) {
+    if (mass[i] != _mass[i]) return false;
+  }
+  return true;
+
+}
+
+bool EvtPhaseSpaceBatch::next(EvtVector4R p4[]) {
+
+  if (_position >= _size) return false;
+
+  for (int i=0; i<_nDaug; i++) {
+    int j = i*_size+_position;
+    p4[i].set(_e[j], _px[j], _py[j], _pz[j]);
+  }
+  _position++;
+
+  return true;
+
+}
+
+void EvtPhaseSpaceBatch::clear() {
+
+  _mass.clear();
+  _mp = 0.0;
+  _size = 0;
+  _position = 0;
+
+}
@@ -0,0 +1,178 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtPhiloxRandomEngine
+//
+// Counter-based random number generator using Philox4x32-10.
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtPhiloxRandomEngine.hh"
+#include "EvtGenBase/EvtReport.hh"
+
+#include <iostream>
+#include <stdlib.h>
+
+namespace {
+
+  const uint32_t philoxM0 = 0xD2511F53;
+  const uint32_t philoxM1 = 0xCD9E8D57;
+  const uint32_t philoxW0 = 0x9E3779B9;
+  const uint32_t philoxW1 = 0xBB67AE85;
+
+  inline void philoxRound(uint32_t ctr[4], const uint32_t key[2]) {
+
+    uint64_t prod0 = (uint64_t)philoxM0 * ctr[0];
+    uint64_t prod1 = (uint64_t)philoxM1 * ctr[2];
+
+    uint32_t hi0 = (uint32_t)(prod0 >> 32);
+    uint32_t lo0 = (uint32_t)prod0;
+    uint32_t hi1 = (uint32_t)(prod1 >> 32);
+    uint32_t lo1 = (uint32_t)prod1;
+
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+
+  }
+
+  // Philox4x32-10 of ctr with key, in place
+  void philoxBlock(uint32_t ctr[4], const uint32_t key0[2]) {
+
+    uint32_t key[2];
+    key[0] = key0[0];
+    key[1] = key0[1];
+
+    for (int i=0; i<10; i++) {
+      if (i > 0) {
+        key[0] += philoxW0;
+        key[1] += philoxW1;
+      }
+      philoxRound(ctr, key);
+    }
+
+  }
+
+}
+
+EvtPhiloxRandomEngine::EvtPhiloxRandomEngine(uint32_t seed) :
+  _event(0),
+  _position(0)
+{
+
+  if (!checkKnownAnswers()) {
+    EvtGenReport(EVTGEN_ERROR,"EvtPhiloxRandomEngine")
+      <<"Philox4x32-10 does not reproduce the known-answer vectors."<<std::endl;
+    EvtGenReport(EVTGEN_ERROR,"EvtPhiloxRandomEngine")<<"Will terminate execution!"<<std::endl;
+    ::abort();
+  }
+
+  _key[0] = seed;
+  _key[1] = 0;
+  generateBlock(0);
+
+  EvtGenReport(EVTGEN_INFO,"EvtPhiloxRandomEngine")
+    <<"Philox4x32-10 counter-based random number generator with seed = "<<seed<<std::endl;
+
+}
+
+bool EvtPhiloxRandomEngine::setStream(uint32_t run, uint64_t event) {
+
+  _key[1] = run;
+  _event = event;
+  _position = 0;
+  generateBlock(0);
+  return true;
+
+}
+
+void EvtPhiloxRandomEngine::generateBlock(uint64_t block) {
+
+  uint32_t ctr[4];
+  ctr[0] = (uint32_t)block;
+  ctr[1] = (uint32_t)(block >> 32);
+  ctr[2] = (uint32_t)_event;
+  ctr[3] = (uint32_t)(_event >> 32);
+
+  philoxBlock(ctr, _key);
+
+  for (int i=0; i<4; i++) _output[i] = ctr[i];
+  _block = block;
+
+}
+
+bool EvtPhiloxRandomEngine::checkKnownAnswers() {
+
+  // Counter (ctr0..ctr3), key (key0, key1) and the expected block
+  static const uint32_t vectors[3][10] = {
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+     0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+     0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+  };
+
+  for (int i=0; i<3; i++) {
+    const uint32_t* v = vectors[i];
+    uint32_t ctr[4] = {v[0], v[1], v[2], v[3]};
+    uint32_t key[2] = {v[4], v[5]};
+    philoxBlock(ctr, key);
+    for (int k=0; k<4; k++) {
+      if (ctr[k] != v[6+k]) return false;
+    }
+  }
+
+  return true;
+
+}
+
+double EvtPhiloxRandomEngine::toDouble(const uint32_t* words) {
+
+  // 53 random bits, centred in their bin so that 0 and 1 never occur
+  uint64_t bits = ((uint64_t)words[0] << 21) ^ (words[1] >> 11);
+  return (bits + 0.5) * (1.0/9007199254740992.0);
+
+}
+
+double EvtPhiloxRandomEngine::random() {
+
+  uint64_t block = _position >> 1;
+  if (block != _block) generateBlock(block);
+
+  const uint32_t* words = _output + 2*(_position & 1);
+  _position++;
+
+  return toDouble(words);
+
+}
+
+void EvtPhiloxRandomEngine::randomArray(double* values, int n) {
+
+  int i(0);
+
+  // Finish the current block first, then take whole blocks
+  if (n > 0 && (_position & 1)) values[i++] = random();
+
+  for (; i+1<n; i+=2) {
+    generateBlock(_position >> 1);
+    values[i] = toDouble(_output);
+    values[i+1] = toDouble(_output+2);
+    _position += 2;
+  }
+
+  if (i < n) values[i] = random();
+
+}
@@ -0,0 +1,160 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtProbMaxCache
+//
+// Description: Cache of learned maximum probabilities, see
+//              EvtProbMaxCache.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtProbMaxCache.hh"
+#include "EvtGenBase/EvtDecayTable.hh"
+#include "EvtGenBase/EvtDecayBase.hh"
+#include "EvtGenBase/EvtPDL.hh"
+#include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtFileReplacer.hh"
+
+#include <fstream>
+#include <sstream>
+
+using std::endl;
+
+bool EvtProbMaxCache::read(const std::string& fileName) {
+
+  std::ifstream input(fileName.c_str());
+
+  if (!input) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can not read probmax cache "
+					<< fileName << endl;
+    return false;
+  }
+
+  int nEntries(0);
+  std::string line;
+
+  while (std::getline(input, line)) {
+
+    if (line.empty() || line[0] == '#') continue;
+
+    std::istringstream fields(line);
+    double probMax(0.0);
+    std::string key;
+
+    if (!(fields >> probMax) || !std::getline(fields >> std::ws, key) ||
+	key.empty()) {
+      EvtGenReport(EVTGEN_WARNING,"EvtGen") << "Skipping bad line in probmax cache "
+					    << fileName << ": " << line << endl;
+      continue;
+    }
+
+    merge(key, probMax);
+    nEntries++;
+
+  }
+
+  EvtGenReport(EVTGEN_INFO,"EvtGen") << "Read " << nEntries
+				     << " maximum probabilities from " << fileName << endl;
+
+  return true;
+
+}
+
+bool EvtProbMaxCache::write(const std::string& fileName) const {
+
+  // Replaced in one step, so that jobs sharing the cache always read a
+  // complete file
+  EvtFileReplacer replacer(fileName);
+
+  if (!replacer.isOpen()) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can not write probmax cache "
+					<< fileName << endl;
+    return false;
+  }
+
+  std::ostream& output = replacer.stream();
+
+  output << "# EvtGen probmax cache: probmax model parent -> daughters ; arguments" << endl;
+
+  // Written with all digits so that reading the file back gives the
+  // same maxima, and hence the same events.
+  output.precision(17);
+  std::map<std::string, double>::const_iterator iter;
+  for (iter = _probMax.begin(); iter != _probMax.end(); ++iter) {
+    output << iter->second << " " << iter->first << endl;
+  }
+
+  if (!replacer.commit()) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can not write probmax cache "
+					<< fileName << endl;
+    return false;
+  }
+
+  return true;
+
+}
+
+void EvtProbMaxCache::collect(EvtDecayTable* decayTable) {
+
+  if (!decayTable) return;
+
+  int nParticles = EvtPDL::entries();
+
+  for (int i=0; i<nParticles; i++) {
+
+    int nModes = decayTable->getNModes(i);
+
+    for (int j=0; j<nModes; j++) {
+      EvtDecayBase* decay = decayTable->getDecay(i, j);
+      double probMax(0.0);
+      if (decay && decay->getLearnedProbMax(probMax)) {
+	merge(decay->getProbMaxKey(), probMax);
+      }
+    }
+
+  }
+
+}
+
+void EvtProbMaxCache::merge(const std::string& key, double probMax) {
+
+  std::map<std::string, double>::iterator iter = _probMax.find(key);
+
+  if (iter == _probMax.end()) {
+    _probMax[key] = probMax;
+  } else if (probMax > iter->second) {
+    iter->second = probMax;
+  }
+
+}
+
+void EvtProbMaxCache::merge(const EvtProbMaxCache& other) {
+
+  std::map<std::string, double>::const_iterator iter;
+  for (iter = other._probMax.begin(); iter != other._probMax.end(); ++iter) {
+    merge(iter->first, iter->second);
+  }
+
+}
+
+bool EvtProbMaxCache::get(const std::string& key, double& probMax) const {
+
+  std::map<std::string, double>::const_iterator iter = _probMax.find(key);
+
+  if (iter == _probMax.end()) return false;
+
+  probMax = iter->second;
+  return true;
+
+}
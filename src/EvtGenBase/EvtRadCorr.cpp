@@ -25,49 +25,59 @@
 #include <iostream>
 #include "EvtGenBase/EvtAbsRadCorr.hh"
 #include "EvtGenBase/EvtRadCorr.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 #include "EvtGenBase/EvtReport.hh"
 using std::endl;
 
 
-EvtAbsRadCorr* EvtRadCorr::_fsrEngine=0;
-bool EvtRadCorr::_alwaysRadCorr=false;
-bool EvtRadCorr::_neverRadCorr=false;
-
 EvtRadCorr::EvtRadCorr() {
-  _fsrEngine=0;
-  _alwaysRadCorr=false;
-  _neverRadCorr=false;
+  EvtGenContext* context=EvtGenContext::current();
+  context->setRadCorrEngine(0);
+  context->alwaysRadCorr()=false;
+  context->neverRadCorr()=false;
 }
 
 EvtRadCorr::~EvtRadCorr() {
-  if ( _fsrEngine ) delete _fsrEngine;
-  _fsrEngine=0;
+  //The engine is owned either by the caller or by the context.
+  EvtGenContext::current()->setRadCorrEngine(0);
 }
 
 void EvtRadCorr::setRadCorrEngine(EvtAbsRadCorr* fsrEngine){
-  _fsrEngine=fsrEngine;
+  EvtGenContext::current()->setRadCorrEngine(fsrEngine);
 }
 
 
 void EvtRadCorr::doRadCorr(EvtParticle *p){
 
-  if (_fsrEngine==0){
+  EvtGenContext* context=EvtGenContext::current();
+  EvtAbsRadCorr* fsrEngine=context->getRadCorrEngine();
+
+  if (fsrEngine==0){
     EvtGenReport(EVTGEN_ERROR,"EvtGen") <<"No RadCorr model available in "
 			   <<"EvtRadCorr::doRadCorr()."<<endl;
     ::abort();
   }
 
-  if ( !_neverRadCorr) _fsrEngine->doRadCorr(p);
+  if ( !context->neverRadCorr()) fsrEngine->doRadCorr(p);
   return;
 }
 
 
-bool EvtRadCorr::alwaysRadCorr() {return _alwaysRadCorr;}
-bool EvtRadCorr::neverRadCorr() {return _neverRadCorr;}
+bool EvtRadCorr::alwaysRadCorr() {return EvtGenContext::current()->alwaysRadCorr();}
+bool EvtRadCorr::neverRadCorr() {return EvtGenContext::current()->neverRadCorr();}
 
-void EvtRadCorr::setAlwaysRadCorr() { _alwaysRadCorr=true; _neverRadCorr=false;}
-void EvtRadCorr::setNeverRadCorr() { _alwaysRadCorr=false; _neverRadCorr=true;}
-void EvtRadCorr::setNormalRadCorr() {_alwaysRadCorr=false; _neverRadCorr=false;}
+void EvtRadCorr::setAlwaysRadCorr() {
+  EvtGenContext* context=EvtGenContext::current();
+  context->alwaysRadCorr()=true; context->neverRadCorr()=false;
+}
+void EvtRadCorr::setNeverRadCorr() {
+  EvtGenContext* context=EvtGenContext::current();
+  context->alwaysRadCorr()=false; context->neverRadCorr()=true;
+}
+void EvtRadCorr::setNormalRadCorr() {
+  EvtGenContext* context=EvtGenContext::current();
+  context->alwaysRadCorr()=false; context->neverRadCorr()=false;
+}
 
 
 
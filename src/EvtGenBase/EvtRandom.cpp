@@ -16,6 +16,8 @@
 // Modification history:
 //
 //    DJL/RYD   September 25, 1996           Module created
+//              Oct 2026                     Numbers come from the buffer
+//                                           of the generator context
 //
 //------------------------------------------------------------------------
 //
@@ -27,28 +29,26 @@
 #include <iostream>
 #include "EvtGenBase/EvtRandomEngine.hh"
 #include "EvtGenBase/EvtRandom.hh"
+#include "EvtGenBase/EvtGenContext.hh"
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenBase/EvtConst.hh"
 
 using std::endl;
 
 
-EvtRandomEngine* EvtRandom::_randomEngine=0;
-
 void EvtRandom::setRandomEngine(EvtRandomEngine* randomEngine){
-  _randomEngine=randomEngine;
+  EvtGenContext::current()->setRandomEngine(randomEngine);
 }
 
 
-double EvtRandom::random(){
+void EvtRandom::setBufferSize(int n){
+  EvtGenContext::current()->setRandomBufferSize(n);
+}
 
-  if (_randomEngine==0){
-    EvtGenReport(EVTGEN_ERROR,"EvtGen") <<"No random engine available in "
-			   <<"EvtRandom::random()."<<endl;
-    ::abort();
-  }
 
-  return _randomEngine->random();
+double EvtRandom::random(){
+
+  return EvtGenContext::current()->nextRandom();
 
 }
 
@@ -0,0 +1,59 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtReportUtils
+//
+// Description: Helpers of the run reports, see EvtReportUtils.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtReportUtils.hh"
+
+#include <cstdio>
+
+#ifdef EVTGEN_CPP11
+#include <chrono>
+#else
+#include <sys/time.h>
+#endif
+
+double EvtReportUtils::wallTime() {
+#ifdef EVTGEN_CPP11
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().
+				       time_since_epoch()).count();
+#else
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return now.tv_sec+1e-6*now.tv_usec;
+#endif
+}
+
+std::string EvtReportUtils::jsonString(const std::string& text) {
+  std::string result("\"");
+  for (std::size_t i=0; i<text.size(); i++) {
+    char c = text[i];
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::sprintf(escaped, "\\u%04x", static_cast<unsigned char>(c));
+      result += escaped;
+    } else {
+      result += c;
+    }
+  }
+  result += '"';
+  return result;
+}
@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    RYD       May 29,1997       Module created
+//              Oct 2026          Inline storage for up to spin 3/2
 //
 //------------------------------------------------------------------------
 // 
@@ -30,28 +31,33 @@ using std::endl;
 using std::ostream;
 
 
-EvtSpinDensity::EvtSpinDensity(const EvtSpinDensity& density){
-  dim=0;
-  rho=0;
+const int EvtSpinDensity::maxDim;
+const int EvtSpinDensity::inlineDim;
 
-  int i,j;
-  setDim(density.dim);
+EvtSpinDensity::EvtSpinDensity(const EvtSpinDensity& density):
+  rho(inlineRho),
+  dim(0),
+  overflowRho(0),
+  overflowSize(0)
+{
 
-  for(i=0;i<dim;i++){
-    for(j=0;j<dim;j++){
-      rho[i][j]=density.rho[i][j];
-    }
+  resize(density.dim);
+
+  int i;
+  for(i=0;i<dim*dim;i++){
+    rho[i]=density.rho[i];
   }
 }
 
 EvtSpinDensity& EvtSpinDensity::operator=(const EvtSpinDensity& density){
-  int i,j;
-  setDim(density.dim);
 
-  for(i=0;i<dim;i++){
-    for(j=0;j<dim;j++){
-      rho[i][j]=density.rho[i][j];
-    }
+  if (this==&density) return *this;
+
+  resize(density.dim);
+
+  int i;
+  for(i=0;i<dim*dim;i++){
+    rho[i]=density.rho[i];
   }
 
   return *this;
@@ -59,68 +65,61 @@ EvtSpinDensity& EvtSpinDensity::operator=(const EvtSpinDensity& density){
 }
 
 EvtSpinDensity::~EvtSpinDensity(){
+  delete [] overflowRho;
+}
 
-  if (dim!=0){
-    int i;
-    for(i=0;i<dim;i++) delete [] rho[i];
-  }
-  
-  delete [] rho;
-
+EvtSpinDensity::EvtSpinDensity():
+  rho(inlineRho),
+  dim(0),
+  overflowRho(0),
+  overflowSize(0)
+{
 }
 
-EvtSpinDensity::EvtSpinDensity(){
-  dim=0;
-  rho=0;
+void EvtSpinDensity::resize(int n){
+  dim=n;
+  if (n<=inlineDim) {
+    rho=inlineRho;
+    return;
+  }
+  // Kept for later matrices of the same size
+  if (overflowSize<n*n) {
+    delete [] overflowRho;
+    overflowRho=new EvtComplex[n*n];
+    overflowSize=n*n;
+  }
+  rho=overflowRho;
 }
 
 void EvtSpinDensity::setDim(int n){
   if (dim==n) return;
-  if (dim!=0){
-    int i;
-    for(i=0;i<dim;i++) delete [] rho[i];
-    delete [] rho;
-    rho=0;
-    dim=0;
-  }
-  if (n==0) return;
-  dim=n;
-  rho=new EvtComplexPtr[n];
+  if (n<0||n>maxDim) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"Spin density matrix of dimension "<<n
+				      <<" requested, at most "<<maxDim
+				      <<" is supported."<<endl;
+    ::abort();
+  }
+  resize(n);
+  // A resized matrix starts out as zero
   int i;
-  for(i=0;i<n;i++){
-    rho[i]=new EvtComplex[n];
+  for(i=0;i<n*n;i++){
+    rho[i]=EvtComplex(0.0,0.0);
   }
-
-
-}
-
-int EvtSpinDensity::getDim() const {
-  return dim;
-}
-
-void EvtSpinDensity::set(int i,int j,const EvtComplex& rhoij){
-  assert(i<dim&&j<dim);
-  rho[i][j]=rhoij;
-}
-
-const EvtComplex& EvtSpinDensity::get(int i,int j)const{
-  assert(i<dim&&j<dim);
-  return rho[i][j];
 }
 
 void EvtSpinDensity::setDiag(int n){
   setDim(n);
-  int i,j;
+  int i;
 
+  for(i=0;i<n*n;i++){
+    rho[i]=EvtComplex(0.0);
+  }
   for(i=0;i<n;i++){
-    for(j=0;j<n;j++){
-      rho[i][j]=EvtComplex(0.0);
-    }
-    rho[i][i]=EvtComplex(1.0);
+    rho[i*n+i]=EvtComplex(1.0);
   }
 }
 
-double EvtSpinDensity::normalizedProb(const EvtSpinDensity& d){
+double EvtSpinDensity::normalizedProb(const EvtSpinDensity& d) const {
 
   int i,j;
   EvtComplex prob(0.0,0.0);
@@ -132,9 +131,9 @@ double EvtSpinDensity::normalizedProb(const EvtSpinDensity& d){
   }
 
   for(i=0;i<dim;i++){
-    norm+=real(rho[i][i]);
+    norm+=real(rho[i*dim+i]);
     for(j=0;j<dim;j++){
-      prob+=rho[i][j]*d.rho[i][j];
+      prob+=rho[i*dim+j]*d.rho[i*dim+j];
     }
   }
 
@@ -149,7 +148,7 @@ double EvtSpinDensity::normalizedProb(const EvtSpinDensity& d){
 
 }
 
-int EvtSpinDensity::check(){
+int EvtSpinDensity::check() const {
 
   if (dim<1) {
     EvtGenReport(EVTGEN_ERROR,"EvtGen")<<"dim="<<dim<<"in SpinDensity::Check"<<endl;
@@ -160,13 +159,13 @@ int EvtSpinDensity::check(){
   double trace(0.0);
 
   for (i=0;i<dim;i++) {
-    trace += abs(rho[i][i]);
+    trace += abs(rho[i*dim+i]);
   }
 
   for(i=0;i<dim;i++){
 
-    if (real(rho[i][i])<0.0) return 0;
-    if (imag(rho[i][i])*1000000.0>trace) {
+    if (real(rho[i*dim+i])<0.0) return 0;
+    if (imag(rho[i*dim+i])*1000000.0>trace) {
       EvtGenReport(EVTGEN_INFO,"EvtGen") << *this << endl;
       EvtGenReport(EVTGEN_INFO,"EvtGen") << trace << endl;
       EvtGenReport(EVTGEN_INFO,"EvtGen") << "Failing 1"<<endl;
@@ -176,13 +175,13 @@ int EvtSpinDensity::check(){
 
   for(i=0;i<dim;i++){
     for(j=i+1;j<dim;j++){
-      if (fabs(real(rho[i][j]-rho[j][i]))>
-	  0.00000001*(abs(rho[i][i])+abs(rho[j][j]))) {
+      if (fabs(real(rho[i*dim+j]-rho[j*dim+i]))>
+	  0.00000001*(abs(rho[i*dim+i])+abs(rho[j*dim+j]))) {
 	EvtGenReport(EVTGEN_INFO,"EvtGen") << "Failing 2"<<endl;
 	return 0;
       }
-      if (fabs(imag(rho[i][j]+rho[j][i]))>
-	  0.00000001*(abs(rho[i][i])+abs(rho[j][j]))) {
+      if (fabs(imag(rho[i*dim+j]+rho[j*dim+i]))>
+	  0.00000001*(abs(rho[i*dim+i])+abs(rho[j*dim+j]))) {
 	EvtGenReport(EVTGEN_INFO,"EvtGen") << "Failing 3"<<endl;
 	return 0;
       }
@@ -201,7 +200,7 @@ ostream& operator<<(ostream& s,const EvtSpinDensity& d){
 
   for (i=0;i<d.dim;i++){
     for (j=0;j<d.dim;j++){
-     s << d.rho[i][j]<<" ";
+     s << d.rho[i*d.dim+j]<<" ";
     }
     s <<endl;
   }
@@ -0,0 +1,211 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtStartupProfile
+//
+// Description: Profile of the generator set up, see EvtStartupProfile.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtStartupProfile.hh"
+#include "EvtGenBase/EvtGenContext.hh"
+#include "EvtGenBase/EvtReport.hh"
+#include "EvtGenBase/EvtReportUtils.hh"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using std::endl;
+
+namespace {
+
+  // Bytes handed out by malloc in the whole process
+  long long heapInUse() {
+#if defined(__GLIBC__) && __GLIBC__*100+__GLIBC_MINOR__ >= 233
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks)+static_cast<long long>(info.hblkhd);
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return static_cast<long long>(static_cast<unsigned int>(info.uordblks))+
+      static_cast<long long>(static_cast<unsigned int>(info.hblkhd));
+#else
+    return 0;
+#endif
+  }
+
+}
+
+void EvtStartupProfile::setEnabled(bool enabled) {
+  EvtGenContext::current()->setStartupProfileEnabled(enabled);
+}
+
+bool EvtStartupProfile::isEnabled() {
+  return EvtGenContext::current()->isStartupProfileEnabled();
+}
+
+bool EvtStartupProfile::heapAvailable() {
+#ifdef __GLIBC__
+  return true;
+#else
+  return false;
+#endif
+}
+
+EvtStartupProfile::Phase::Phase(const char* phase, const std::string& detail) :
+  _profile(0),
+  _phase(phase),
+  _start(0.0),
+  _heap(0),
+  _firstEntry(0)
+{
+
+  EvtGenContext* context = EvtGenContext::current();
+  if (!context->isStartupProfileEnabled()) return;
+
+  _profile = &context->getStartupProfile();
+  _profile->_depth++;
+  _firstEntry = _profile->_entries.size();
+  _detail = detail;
+  _heap = heapInUse();
+  _start = EvtReportUtils::wallTime();
+
+}
+
+EvtStartupProfile::Phase::~Phase() {
+
+  if (_profile == 0) return;
+
+  double seconds = EvtReportUtils::wallTime()-_start;
+  long long heapBytes = heapInUse()-_heap;
+
+  _profile->_depth--;
+  _profile->add(_phase, _detail, _profile->_depth, _firstEntry,
+		seconds, heapBytes, _label);
+
+}
+
+void EvtStartupProfile::add(const char* phase, const std::string& detail, int depth,
+			    std::size_t position, double seconds, long long heapBytes,
+			    const std::string& label) {
+
+  std::string key = std::string(phase)+'\n'+detail;
+  std::map<std::string,std::size_t>::iterator found = _index.find(key);
+
+  if (found == _index.end()) {
+    Entry entry;
+    entry.phase = phase;
+    entry.detail = detail;
+    entry.depth = depth;
+    entry.calls = 1;
+    entry.seconds = seconds;
+    entry.heapBytes = heapBytes;
+    entry.maxSeconds = seconds;
+    entry.slowest = label;
+    // The phases within this one end first, but are listed after it
+    if (position > _entries.size()) position = _entries.size();
+    _entries.insert(_entries.begin()+position, entry);
+    for (std::map<std::string,std::size_t>::iterator it = _index.begin();
+	 it != _index.end(); ++it) {
+      if (it->second >= position) it->second++;
+    }
+    _index[key] = position;
+    return;
+  }
+
+  Entry& entry = _entries[found->second];
+  entry.calls++;
+  entry.seconds += seconds;
+  entry.heapBytes += heapBytes;
+  if (seconds > entry.maxSeconds) {
+    entry.maxSeconds = seconds;
+    entry.slowest = label;
+  }
+
+}
+
+void EvtStartupProfile::print(std::ostream& output) const {
+
+  std::ios::fmtflags flags = output.flags();
+  std::streamsize precision = output.precision();
+
+  output << "    seconds    calls   heap kB  phase" << endl;
+  output << std::fixed;
+
+  for (std::size_t i=0; i<_entries.size(); i++) {
+    const Entry& entry = _entries[i];
+    output << std::setw(11) << std::setprecision(4) << entry.seconds
+	   << std::setw(9) << entry.calls
+	   << std::setw(10) << std::setprecision(0) << entry.heapBytes/1024.0
+	   << "  " << std::string(2*entry.depth, ' ') << entry.phase;
+    if (!entry.detail.empty()) output << " " << entry.detail;
+    if (entry.calls > 1 && !entry.slowest.empty()) {
+      output << "  (slowest " << std::setprecision(4) << entry.maxSeconds
+	     << " s: " << entry.slowest << ")";
+    }
+    output << endl;
+  }
+
+  output.flags(flags);
+  output.precision(precision);
+
+}
+
+void EvtStartupProfile::writeJSON(std::ostream& output) const {
+
+  std::streamsize precision = output.precision();
+  output.precision(9);
+
+  output << "{\n  \"heapMeasured\": " << (heapAvailable() ? "true" : "false")
+	 << ",\n  \"phases\": [";
+
+  for (std::size_t i=0; i<_entries.size(); i++) {
+    const Entry& entry = _entries[i];
+    output << (i == 0 ? "\n" : ",\n")
+	   << "    {\"phase\": " << EvtReportUtils::jsonString(entry.phase)
+	   << ", \"detail\": " << EvtReportUtils::jsonString(entry.detail)
+	   << ", \"depth\": " << entry.depth
+	   << ", \"calls\": " << entry.calls
+	   << ", \"seconds\": " << entry.seconds
+	   << ", \"heapBytes\": " << entry.heapBytes
+	   << ", \"maxSeconds\": " << entry.maxSeconds
+	   << ", \"slowest\": " << EvtReportUtils::jsonString(entry.slowest) << "}";
+  }
+
+  output << "\n  ]\n}\n";
+
+  output.precision(precision);
+
+}
+
+bool EvtStartupProfile::writeJSON(const std::string& fileName) const {
+
+  std::ofstream output(fileName.c_str());
+
+  if (!output) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Can not write startup profile "
+					<< fileName << endl;
+    return false;
+  }
+
+  writeJSON(output);
+
+  return output.good();
+
+}
@@ -0,0 +1,179 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtTaskPool
+//
+// Description: Work-stealing task scheduler, see EvtTaskPool.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenBase/EvtTaskPool.hh"
+
+EvtTaskPool::EvtTaskPool(int nWorkers) :
+  _nWorkers(nWorkers > 0 ? nWorkers : 1),
+  _task(0),
+  _queues(_nWorkers)
+{
+
+#ifdef EVTGEN_CPP11
+  for (int i=0; i<_nWorkers; i++) {
+    _queueLocks.push_back(new std::mutex());
+  }
+#endif
+
+}
+
+EvtTaskPool::~EvtTaskPool() {
+
+  wait();
+
+#ifdef EVTGEN_CPP11
+  for (size_t i=0; i<_queueLocks.size(); i++) {
+    delete _queueLocks[i];
+  }
+#endif
+
+}
+
+int EvtTaskPool::hardwareThreads() {
+
+#ifdef EVTGEN_CPP11
+  int n = std::thread::hardware_concurrency();
+  if (n > 0) return n;
+#endif
+  return 1;
+
+}
+
+void EvtTaskPool::setInitThreads(int n) {
+
+  initThreads() = n > 0 ? n : 0;
+
+}
+
+int EvtTaskPool::getInitThreads() {
+
+  int n = initThreads();
+  return n > 0 ? n : hardwareThreads();
+
+}
+
+int& EvtTaskPool::initThreads() {
+
+  // 0 uses all cores
+  static int nThreads(0);
+  return nThreads;
+
+}
+
+void EvtTaskPool::start(Task& task, int nTasks, int chunkSize) {
+
+  wait();
+
+  if (chunkSize <= 0) {
+    // Aim for several chunks per worker so that there is something to
+    // steal, but keep them small enough for the workers to stay close
+    // together in task number.
+    chunkSize = nTasks/(8*_nWorkers);
+    if (chunkSize < 1) chunkSize = 1;
+    if (chunkSize > 64) chunkSize = 64;
+  }
+
+  _task = &task;
+
+  int iChunk(0);
+  for (int first=0; first<nTasks; first+=chunkSize, iChunk++) {
+    Chunk chunk;
+    chunk.first = first;
+    chunk.last = first+chunkSize < nTasks ? first+chunkSize : nTasks;
+    _queues[iChunk%_nWorkers].push_back(chunk);
+  }
+
+#ifdef EVTGEN_CPP11
+  for (int i=0; i<_nWorkers; i++) {
+    _threads.push_back(std::thread(&EvtTaskPool::work, this, i));
+  }
+#endif
+
+}
+
+void EvtTaskPool::wait() {
+
+  if (_task == 0) return;
+
+#ifdef EVTGEN_CPP11
+  for (size_t i=0; i<_threads.size(); i++) {
+    _threads[i].join();
+  }
+  _threads.clear();
+#else
+  for (int i=0; i<_nWorkers; i++) {
+    work(i);
+  }
+#endif
+
+  _task = 0;
+
+}
+
+void EvtTaskPool::run(Task& task, int nTasks, int chunkSize) {
+
+  start(task, nTasks, chunkSize);
+  wait();
+
+}
+
+bool EvtTaskPool::nextChunk(int iWorker, Chunk& chunk) {
+
+  // Own queue first, lowest task numbers first
+  {
+#ifdef EVTGEN_CPP11
+    std::lock_guard<std::mutex> lock(*_queueLocks[iWorker]);
+#endif
+    std::deque<Chunk>& queue = _queues[iWorker];
+    if (!queue.empty()) {
+      chunk = queue.front();
+      queue.pop_front();
+      return true;
+    }
+  }
+
+  // Then steal the highest chunk of the next busy worker
+  for (int i=1; i<_nWorkers; i++) {
+    int victim = (iWorker+i)%_nWorkers;
+#ifdef EVTGEN_CPP11
+    std::lock_guard<std::mutex> lock(*_queueLocks[victim]);
+#endif
+    std::deque<Chunk>& queue = _queues[victim];
+    if (!queue.empty()) {
+      chunk = queue.back();
+      queue.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+
+}
+
+void EvtTaskPool::work(int iWorker) {
+
+  Chunk chunk;
+  while (nextChunk(iWorker, chunk)) {
+    for (int iTask=chunk.first; iTask<chunk.last; iTask++) {
+      _task->run(iTask, iWorker);
+    }
+  }
+
+}
@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    John Back       April 2011            Module created
+//                    Oct 2026              Serialise the engine decays
 //
 //------------------------------------------------------------------------------
 //
@@ -38,6 +39,19 @@
 #include <iostream>
 using std::endl;
 
+#ifdef EVTGEN_CPP11
+#include <mutex>
+
+namespace {
+
+  std::mutex& engineMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+}
+#endif
+
 EvtExternalGenFactory::EvtExternalGenFactory() {
 
   _extGenMap.clear();
@@ -159,6 +173,16 @@ EvtAbsExternalGen* EvtExternalGenFactory::getGenerator(int genId) {
 
 }
 
+bool EvtExternalGenFactory::doDecay(EvtAbsExternalGen* engine, EvtParticle* theMother) {
+
+#ifdef EVTGEN_CPP11
+  std::lock_guard<std::mutex> lock(engineMutex());
+#endif
+
+  return engine->doDecay(theMother);
+
+}
+
 void EvtExternalGenFactory::initialiseAllGenerators() {
 
   ExtGenMap::iterator iter;
@@ -18,6 +18,7 @@
 //
 //    RYD     October 1, 1997        Module created
 //    JJB     May 2011               Modified to use new PHOTOS generator
+//            Oct 2026               Decay through the factory lock
 //
 //------------------------------------------------------------------------
 //
@@ -43,7 +44,7 @@ void EvtPHOTOS::doRadCorr(EvtParticle *p) {
   }
 
   if (_photosEngine != 0) {
-    _photosEngine->doDecay(p);
+    EvtExternalGenFactory::doDecay(_photosEngine, p);
   }
   
 }
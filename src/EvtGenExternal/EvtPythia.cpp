@@ -16,6 +16,7 @@
 //
 //    RYD       January 8, 1997       Module created
 //    JJB       April 2011            Modified to use new Pythia8 interface
+//              Oct 2026              Decay through the factory lock
 //
 //------------------------------------------------------------------------
 
@@ -88,7 +89,7 @@ void EvtPythia::decay( EvtParticle *p ){
   }
     
   if (_pythiaEngine != 0) {
-    _pythiaEngine->doDecay(p);
+    EvtExternalGenFactory::doDecay(_pythiaEngine, p);
   }
 
   this->fixPolarisations(p);
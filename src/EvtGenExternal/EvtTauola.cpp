@@ -13,6 +13,7 @@
 // Modification history:
 //
 //    John Back    May 2011   Module created
+//                 Oct 2026   Decay through the factory lock
 //
 //------------------------------------------------------------------------
 
@@ -76,7 +77,7 @@ void EvtTauola::decay( EvtParticle *p ){
   }
     
   if (_tauolaEngine != 0) {
-    _tauolaEngine->doDecay(p);
+    EvtExternalGenFactory::doDecay(_tauolaEngine, p);
   }
 
 }
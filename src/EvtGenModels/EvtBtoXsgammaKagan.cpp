@@ -22,10 +22,13 @@
 //       theoretical hadronic mass spectra is computed for the first time
 //       the init method is called. Then, all the other times (eg if we want to decay a B0 
 //       as well as an anti-B0) the vector mass info stored the first time is used again.
+//       The mass bins are integrated in parallel, and the spectra can be kept in a file
+//       (setSpectrumCacheFile) so that later jobs do not compute them again.
 //
 // Modification history:
 //
 //      Jane Tinslay, Francesca Di Lodovico  March 21, 2001       Module created
+//      Oct 2026  Parallel and cached hadronic mass spectra
 //------------------------------------------------------------------------
 //
 #include "EvtGenBase/EvtPatches.hh"
@@ -48,17 +51,140 @@
 #include "EvtGenModels/EvtItgFourCoeffFcn.hh"
 #include "EvtGenModels/EvtItgAbsIntegrator.hh"
 #include "EvtGenModels/EvtBtoXsgammaFermiUtil.hh"
+#include "EvtGenBase/EvtTaskPool.hh"
+#include "EvtGenBase/EvtFileReplacer.hh"
 
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+
+#ifdef EVTGEN_CPP11
+#include <mutex>
+#endif
 using std::endl;
 using std::fstream;
 
-bool EvtBtoXsgammaKagan::bbprod = false;
-double EvtBtoXsgammaKagan::intervalMH = 0;
+namespace {
+
+  // The spectra (masses and branching fractions) computed or read so far,
+  // by model arguments, shared by all instances of the model. Generators
+  // on other threads may initialise the model at the same time, so the
+  // map and the cache file are only used with spectraMutex held.
+  typedef std::pair<std::vector<double>, std::vector<double> > Spectrum;
+  std::map<std::vector<double>, Spectrum> theSpectra;
+
+#ifdef EVTGEN_CPP11
+  std::mutex& spectraMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+#endif
+
+}
+
+// The s22 and s27 coefficients, one point in y per task
+class EvtBtoXsgammaKagan::SCoeffTask : public EvtTaskPool::Task {
+
+public:
+
+  SCoeffTask(double z, double yMax, const std::vector<double> &yp) :
+    _sCoeffs(1, z), _yMax(yMax), _yp(yp), _s22Coeffs(yp.size()), _s27Coeffs(yp.size()) {}
+
+  virtual void run(int iTask, int /*iWorker*/) {
+
+    EvtItgPtrFunction mys22Func(&s22Func, 0., _yMax+0.1, _sCoeffs);
+    EvtItgPtrFunction mys27Func(&s27Func, 0., _yMax+0.1, _sCoeffs);
+    EvtItgSimpsonIntegrator mys22Simp(mys22Func, 1.0e-4, 20);
+    EvtItgSimpsonIntegrator mys27Simp(mys27Func, 1.0e-4, 50);
+
+    _s22Coeffs[iTask] = (16./27.)*mys22Simp.evaluate(1.0e-20,_yp[iTask]);
+    _s27Coeffs[iTask] = (-8./9.)*_sCoeffs[0]*mys27Simp.evaluate(1.0e-20,_yp[iTask]);
+  }
+
+  const std::vector<double>& s22Coeffs() const {return _s22Coeffs;}
+  const std::vector<double>& s27Coeffs() const {return _s27Coeffs;}
+
+private:
+
+  std::vector<double> _sCoeffs;
+  double _yMax;
+  const std::vector<double>& _yp;
+  std::vector<double> _s22Coeffs;
+  std::vector<double> _s27Coeffs;
+
+};
+
+// The Delta, s77, s88, s78, s22 and s27 integrals, one hadronic mass bin
+// per task. The integrands only differ in ymH, so every task sets up its
+// own functions and integrators.
+class EvtBtoXsgammaKagan::HadronicMassTask : public EvtTaskPool::Task {
+
+public:
+
+  enum {nIntegrals=6};
+
+  HadronicMassTask(double mB, double mb, const std::vector<double> &mH,
+                   const std::vector<double> &FermiCoeffs, const std::vector<double> &varCoeffs,
+                   const std::vector<double> &DeltaCoeffs, const std::vector<double> &s88Coeffs,
+                   const std::vector<double> &sInitCoeffs, const std::vector<double> &s22Coeffs,
+                   const std::vector<double> &s27Coeffs) :
+    _mB(mB), _mb(mb), _mH(mH), _FermiCoeffs(FermiCoeffs), _varCoeffs(varCoeffs),
+    _DeltaCoeffs(DeltaCoeffs), _s88Coeffs(s88Coeffs), _sInitCoeffs(sInitCoeffs),
+    _s22Coeffs(s22Coeffs), _s27Coeffs(s27Coeffs), _results(nIntegrals*mH.size()) {}
+
+  virtual void run(int iTask, int /*iWorker*/) {
+
+    double ymH = 1. - ((_mH[iTask]*_mH[iTask])/(_mB*_mB));
+
+    //Need to set ymH as one of the input parameters
+    std::vector<double> varCoeffs(_varCoeffs);
+    varCoeffs[2] = ymH;
+
+    EvtItgThreeCoeffFcn myDeltaFermiFunc(&DeltaFermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs, _DeltaCoeffs);
+    EvtItgTwoCoeffFcn mys77FermiFunc(&s77FermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs);
+    EvtItgThreeCoeffFcn mys88FermiFunc(&s88FermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs, _s88Coeffs);
+    EvtItgTwoCoeffFcn mys78FermiFunc(&s78FermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs);
+    EvtItgFourCoeffFcn mys22FermiFunc(&sFermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs, _sInitCoeffs, _s22Coeffs);
+    EvtItgFourCoeffFcn mys27FermiFunc(&sFermiFunc, -_mb, _mB-_mb, _FermiCoeffs, varCoeffs, _sInitCoeffs, _s27Coeffs);
+
+    EvtItgSimpsonIntegrator myDeltaFermiSimp(myDeltaFermiFunc, 1.0e-4, 40);
+    EvtItgSimpsonIntegrator mys77FermiSimp(mys77FermiFunc, 1.0e-4, 40);
+    EvtItgSimpsonIntegrator mys88FermiSimp(mys88FermiFunc, 1.0e-4, 40);
+    EvtItgSimpsonIntegrator mys78FermiSimp(mys78FermiFunc, 1.0e-4, 40);
+    EvtItgSimpsonIntegrator mys22FermiSimp(mys22FermiFunc, 1.0e-4, 40);
+    EvtItgSimpsonIntegrator mys27FermiSimp(mys27FermiFunc, 1.0e-4, 40);
+
+    double* result = &_results[nIntegrals*iTask];
+    result[0] = myDeltaFermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+    result[1] = mys77FermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+    result[2] = mys88FermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+    result[3] = mys78FermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+    result[4] = mys22FermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+    result[5] = mys27FermiSimp.evaluate((_mB*ymH-_mb),_mB-_mb);
+  }
+
+  // Delta, s77, s88, s78, s22 and s27 for mass bin i
+  const double* results(int i) const {return &_results[nIntegrals*i];}
+
+private:
+
+  double _mB;
+  double _mb;
+  const std::vector<double>& _mH;
+  const std::vector<double>& _FermiCoeffs;
+  const std::vector<double>& _varCoeffs;
+  const std::vector<double>& _DeltaCoeffs;
+  const std::vector<double>& _s88Coeffs;
+  const std::vector<double>& _sInitCoeffs;
+  const std::vector<double>& _s22Coeffs;
+  const std::vector<double>& _s27Coeffs;
+  std::vector<double> _results;
+
+};
 
 EvtBtoXsgammaKagan::~EvtBtoXsgammaKagan(){
-  delete [] massHad;
-  delete [] brHad;
 }
 
 void EvtBtoXsgammaKagan::init(int nArg, double* args){
@@ -76,13 +202,19 @@ void EvtBtoXsgammaKagan::init(int nArg, double* args){
   }
   
   if(nArg == 1){
-    bbprod = true;
+    _bbprod = true;
     getDefaultHadronicMass();
   }else{
-    bbprod = false;
+    _bbprod = false;
     computeHadronicMass(nArg, args);
   }
 
+  //Height of the box used in GetMass
+  _boxHeight = 0.;
+  for (size_t i=0;i<_brHad.size();i++) {
+    if(_brHad[i]>_boxHeight)_boxHeight=_brHad[i];
+  }
+
   double mHminLimit=0.6373;
   double mHmaxLimit=4.5;
 
@@ -116,18 +248,12 @@ void EvtBtoXsgammaKagan::init(int nArg, double* args){
 
 void EvtBtoXsgammaKagan::getDefaultHadronicMass(){
 
-    massHad = new double[81];
-    brHad = new double[81];
-  
     double mass[81] = { 0, 0.0625995, 0.125199, 0.187798, 0.250398, 0.312997, 0.375597, 0.438196, 0.500796, 0.563395, 0.625995, 0.688594, 0.751194, 0.813793, 0.876392, 0.938992, 1.00159, 1.06419, 1.12679, 1.18939, 1.25199, 1.31459, 1.37719, 1.43979, 1.50239, 1.56499, 1.62759, 1.69019, 1.75278, 1.81538, 1.87798, 1.94058, 2.00318, 2.06578, 2.12838, 2.19098, 2.25358, 2.31618, 2.37878, 2.44138, 2.50398, 2.56658, 2.62918, 2.69178, 2.75438, 2.81698, 2.87958, 2.94217, 3.00477, 3.06737, 3.12997, 3.19257, 3.25517, 3.31777, 3.38037, 3.44297, 3.50557, 3.56817, 3.63077, 3.69337, 3.75597, 3.81857, 3.88117, 3.94377, 4.00637, 4.06896, 4.13156, 4.19416, 4.25676, 4.31936, 4.38196, 4.44456, 4.50716, 4.56976, 4.63236, 4.69496, 4.75756, 4.82016, 4.88276, 4.94536, 5.00796};
 
     double br[81] = { 0, 1.03244e-09, 3.0239e-08, 1.99815e-07, 7.29392e-07, 1.93129e-06, 4.17806e-06, 7.86021e-06, 1.33421e-05, 2.09196e-05, 3.07815e-05, 4.29854e-05, 5.74406e-05, 7.3906e-05, 9.2003e-05, 0.000111223, 0.000130977, 0.000150618, 0.000169483, 0.000186934, 0.000202392, 0.000215366, 0.000225491, 0.000232496, 0.000236274, 0.000236835, 0.000234313, 0.000228942, 0.000221042, 0.000210994, 0.000199215, 0.000186137, 0.000172194, 0.000157775, 0.000143255, 0.000128952, 0.000115133, 0.000102012, 8.97451e-05, 7.84384e-05, 6.81519e-05, 5.89048e-05, 5.06851e-05, 4.34515e-05, 3.71506e-05, 3.1702e-05, 2.70124e-05, 2.30588e-05, 1.96951e-05, 1.68596e-05, 1.44909e-05, 1.25102e-05, 1.08596e-05, 9.48476e-06, 8.34013e-06, 7.38477e-06, 6.58627e-06, 5.91541e-06, 5.35022e-06, 4.87047e-06, 4.46249e-06, 4.11032e-06, 3.80543e-06, 3.54051e-06, 3.30967e-06, 3.10848e-06, 2.93254e-06, 2.78369e-06, 2.65823e-06, 2.55747e-06, 2.51068e-06, 2.57179e-06, 2.74684e-06, 3.02719e-06, 3.41182e-06, 3.91387e-06, 4.56248e-06, 5.40862e-06, 6.53915e-06, 8.10867e-06, 1.04167e-05 };
 
-  for(int i=0; i<81; i++){
-    massHad[i] = mass[i];
-    brHad[i] = br[i];
-  }
-  intervalMH=80;
+  _massHad.assign(mass, mass+81);
+  _brHad.assign(br, br+81);
 }
 
 void EvtBtoXsgammaKagan::computeHadronicMass(int /*nArg*/, double* args){
@@ -142,10 +268,10 @@ void EvtBtoXsgammaKagan::computeHadronicMass(int /*nArg*/, double* args){
   _z = args[7];
   _nIntervalS = args[8];
   _nIntervalmH = args[9];
-  std::vector<double> mHVect(int(_nIntervalmH+1.0));
-  massHad = new double[int(_nIntervalmH+1.0)];
-  brHad = new double[int(_nIntervalmH+1.0)];
-  intervalMH=_nIntervalmH;
+
+  //The spectrum only depends on these arguments
+  std::vector<double> key(args+1, args+10);
+  if (readSpectrum(key)) return;
 
   //Going to have to add a new entry into the data file - takes ages...
   EvtGenReport(EVTGEN_WARNING,"EvtGen") << "EvtBtoXsgammaKagan: calculating new hadronic mass spectra. This takes a while..." << endl;
@@ -195,39 +321,27 @@ void EvtBtoXsgammaKagan::computeHadronicMass(int /*nArg*/, double* args){
   
   //Build s22 and s27 vector - saves time because double
   //integration is required otherwise
-  std::vector<double> s22Coeffs(int(_nIntervalS+1.0));
-  std::vector<double> s27Coeffs(int(_nIntervalS+1.0));
-  std::vector<double> s28Coeffs(int(_nIntervalS+1.0));
+  std::vector<double> ypVect(int(_nIntervalS+1.0));
   
   double dy = (yMax - yMin)/_nIntervalS;
   double yp = yMin;
-  
-  std::vector<double> sCoeffs(1);
-  sCoeffs[0] = _z;
-  
-  //Define s22 and s27 functions
-  EvtItgPtrFunction *mys22Func = new EvtItgPtrFunction(&s22Func, 0., yMax+0.1, sCoeffs);
-  EvtItgPtrFunction *mys27Func = new EvtItgPtrFunction(&s27Func, 0., yMax+0.1, sCoeffs);
-  
-  //Use a simpson integrator
-  EvtItgAbsIntegrator *mys22Simp = new EvtItgSimpsonIntegrator(*mys22Func, 1.0e-4, 20);
-  EvtItgAbsIntegrator *mys27Simp = new EvtItgSimpsonIntegrator(*mys27Func, 1.0e-4, 50);
 
   int i;
 
   for (i=0;i<int(_nIntervalS+1.0);i++) {
-    
-    s22Coeffs[i] = (16./27.)*mys22Simp->evaluate(1.0e-20,yp);
-    s27Coeffs[i] = (-8./9.)*_z*mys27Simp->evaluate(1.0e-20,yp);
-    s28Coeffs[i] = -s27Coeffs[i]/3.;
+    ypVect[i] = yp;
     yp = yp + dy;
-    
   }
 
-  delete mys22Func;
-  delete mys27Func;
-  delete mys22Simp;
-  delete mys27Simp;
+  //Both loops below are spread over all cores, or as many threads as set
+  //with EvtTaskPool::setInitThreads
+  EvtTaskPool pool(EvtTaskPool::getInitThreads());
+
+  SCoeffTask sTask(_z, yMax, ypVect);
+  pool.run(sTask, ypVect.size());
+
+  const std::vector<double>& s22Coeffs = sTask.s22Coeffs();
+  const std::vector<double>& s27Coeffs = sTask.s27Coeffs();
   
   //Define functions and vectors used to calculate mHVect. Each function takes a set
   //of vectors which are used as the function coefficients
@@ -314,119 +428,198 @@ void EvtBtoXsgammaKagan::computeHadronicMass(int /*nArg*/, double* args){
     
   }
   
-  //Define functions
-  EvtItgThreeCoeffFcn* myDeltaFermiFunc = new EvtItgThreeCoeffFcn(&DeltaFermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs, DeltaCoeffs);
-  EvtItgThreeCoeffFcn* mys88FermiFunc = new EvtItgThreeCoeffFcn(&s88FermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs, s88Coeffs);
-  EvtItgTwoCoeffFcn* mys77FermiFunc = new EvtItgTwoCoeffFcn(&s77FermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs);
-  EvtItgTwoCoeffFcn* mys78FermiFunc = new EvtItgTwoCoeffFcn(&s78FermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs);
-  EvtItgFourCoeffFcn* mys22FermiFunc = new EvtItgFourCoeffFcn(&sFermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs, sInitCoeffs, s22Coeffs);
-  EvtItgFourCoeffFcn* mys27FermiFunc = new EvtItgFourCoeffFcn(&sFermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs, sInitCoeffs, s27Coeffs);
-  EvtItgFourCoeffFcn* mys28FermiFunc = new EvtItgFourCoeffFcn(&sFermiFunc, -_mb, _mB-_mb, FermiCoeffs, varCoeffs, sInitCoeffs, s28Coeffs);
-  
-  //Define integrators
-  EvtItgSimpsonIntegrator* myDeltaFermiSimp = 
-    new EvtItgSimpsonIntegrator(*myDeltaFermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys77FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys77FermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys88FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys88FermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys78FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys78FermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys22FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys22FermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys27FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys27FermiFunc, 1.0e-4, 40);
-  EvtItgSimpsonIntegrator* mys28FermiSimp = 
-    new EvtItgSimpsonIntegrator(*mys28FermiFunc, 1.0e-4, 40);
-  
-  //Finally calculate mHVect for the range of hadronic masses
+  //Finally calculate the branching fractions for the range of hadronic masses
   double mHmin = sqrt(_mB*_mB - 2.*_mB*eGammaMax);
   double mHmax = sqrt(_mB*_mB - 2.*_mB*eGammaMin);
   double dmH = (mHmax - mHmin)/_nIntervalmH;
   
+  std::vector<double> mHVect(int(_nIntervalmH+1.0));
   double mH=mHmin;
 
+  for (i=0;i<int(_nIntervalmH+1.0);i++) {
+    mHVect[i] = mH;
+    mH = mH+dmH;
+  }
+
+  HadronicMassTask mHTask(_mB, _mb, mHVect, FermiCoeffs, varCoeffs, DeltaCoeffs,
+                          s88Coeffs, sInitCoeffs, s22Coeffs, s27Coeffs);
+  pool.run(mHTask, mHVect.size());
+
+  _massHad.resize(mHVect.size());
+  _brHad.resize(mHVect.size());
+
   //Calculating the Branching Fractions
   for (i=0;i<int(_nIntervalmH+1.0);i++) {
     
-    double ymH = 1. - ((mH*mH)/(_mB*_mB));
-    
-    //Need to set ymH as one of the input parameters
-    myDeltaFermiFunc->setCoeff(2, 2, ymH);
-    mys77FermiFunc->setCoeff(2, 2, ymH);
-    mys88FermiFunc->setCoeff(2, 2, ymH);
-    mys78FermiFunc->setCoeff(2, 2, ymH);
-    mys22FermiFunc->setCoeff(2, 2, ymH);
-    mys27FermiFunc->setCoeff(2, 2, ymH);
-    mys28FermiFunc->setCoeff(2, 2, ymH);
-    
-    //Integrate
-    
-    double deltaResult = myDeltaFermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    double s77Result = mys77FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    double s88Result = mys88FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    double s78Result = mys78FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    double s22Result = mys22FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    double s27Result = mys27FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
-    mys28FermiSimp->evaluate((_mB*ymH-_mb),_mB-_mb);
+    mH = mHVect[i];
+    const double* result = mHTask.results(i);
+
+    double deltaResult = result[0];
+    double s77Result = result[1];
+    double s88Result = result[2];
+    double s78Result = result[3];
+    double s22Result = result[4];
+    double s27Result = result[5];
     
     double py = (pow(_CKMrat,2.)*(6./_fz)*(_alpha/EvtConst::pi)*(deltaResult*_cDeltatot  + (_alphasmu/EvtConst::pi)*(s77Result*pow(_c70mu,2.) + s27Result*_c2mu*(_c70mu  - _c80mu/3.) + s78Result*_c70mu*_c80mu + s22Result*_c2mu*_c2mu  + s88Result*_c80mu*_c80mu )  ) );
     
-    mHVect[i] = 2.*(mH/(_mB*_mB))*0.105*Nsl*py;
-
-    massHad[i] = mH;
-    brHad[i] =  2.*(mH/(_mB*_mB))*0.105*Nsl*py;
-
-    mH = mH+dmH;
+    _massHad[i] = mH;
+    _brHad[i] =  2.*(mH/(_mB*_mB))*0.105*Nsl*py;
     
   }
 
-  //Clean up
-  delete  myDeltaFermiFunc; myDeltaFermiFunc=0;
-  delete mys88FermiFunc; mys88FermiFunc=0;
-  delete mys77FermiFunc; mys77FermiFunc=0;
-  delete mys78FermiFunc; mys78FermiFunc=0;
-  delete mys22FermiFunc; mys22FermiFunc=0;
-  delete mys27FermiFunc; mys27FermiFunc=0;
-  delete mys28FermiFunc; mys28FermiFunc=0;
-  
-  delete myDeltaFermiSimp; myDeltaFermiSimp=0;
-  delete mys77FermiSimp; mys77FermiSimp=0;
-  delete mys88FermiSimp; mys88FermiSimp=0;
-  delete mys78FermiSimp; mys78FermiSimp=0;
-  delete mys22FermiSimp; mys22FermiSimp=0;
-  delete mys27FermiSimp; mys27FermiSimp=0;
-  delete mys28FermiSimp; mys28FermiSimp=0;
+#ifdef EVTGEN_CPP11
+  std::lock_guard<std::mutex> lock(spectraMutex());
+#endif
+
+  theSpectra[key] = Spectrum(_massHad, _brHad);
+  writeSpectrum(key);
   
 }
 
+bool EvtBtoXsgammaKagan::readSpectrum(const std::vector<double> &key) {
+
+#ifdef EVTGEN_CPP11
+  std::lock_guard<std::mutex> lock(spectraMutex());
+#endif
+
+  std::map<std::vector<double>, Spectrum>::const_iterator it = theSpectra.find(key);
+  if (it != theSpectra.end()) {
+    _massHad = it->second.first;
+    _brHad = it->second.second;
+    return true;
+  }
+
+  const std::string& fileName = spectrumCacheFile();
+  if (fileName.empty()) return false;
+
+  std::ifstream cacheFile(fileName.c_str());
+  if (!cacheFile) return false;
+
+  //Lines are "KAGAN", the key, the number of masses and then pairs of
+  //mass and branching fraction; lines starting with # are comments
+  std::string line;
+  while (std::getline(cacheFile, line)) {
+
+    if (line.empty() || line[0] == '#') continue;
+
+    std::istringstream input(line);
+    std::string tag;
+    input >> tag;
+    if (tag != "KAGAN") continue;
+
+    bool match(true);
+    for (size_t k=0; k<key.size(); k++) {
+      double value(0);
+      input >> value;
+      if (!input || value != key[k]) match = false;
+    }
+    if (!match) continue;
+
+    int n(0);
+    input >> n;
+    if (!input || n < 2) continue;
+
+    std::vector<double> mass(n), br(n);
+    for (int k=0; k<n; k++) input >> mass[k] >> br[k];
+    if (!input) {
+      EvtGenReport(EVTGEN_WARNING,"EvtGen") << "EvtBtoXsgammaKagan: ignoring incomplete spectrum in "
+                                            << fileName << endl;
+      continue;
+    }
+
+    EvtGenReport(EVTGEN_INFO,"EvtGen") << "EvtBtoXsgammaKagan: using hadronic mass spectra from "
+                                       << fileName << endl;
+    _massHad = mass;
+    _brHad = br;
+    theSpectra[key] = Spectrum(mass, br);
+    return true;
+
+  }
+
+  return false;
+
+}
+
+void EvtBtoXsgammaKagan::writeSpectrum(const std::vector<double> &key) const {
+
+  const std::string& fileName = spectrumCacheFile();
+  if (fileName.empty()) return;
+
+  //The new spectrum is added to a copy of the file, which then replaces
+  //it in one step, so that other jobs never read a partly written line
+  std::string oldLines;
+  std::ifstream oldFile(fileName.c_str());
+  if (oldFile) {
+    std::ostringstream lines;
+    lines << oldFile.rdbuf();
+    oldLines = lines.str();
+  }
+
+  EvtFileReplacer replacer(fileName);
+  if (!replacer.isOpen()) {
+    EvtGenReport(EVTGEN_WARNING,"EvtGen") << "EvtBtoXsgammaKagan: could not write to "
+                                          << fileName << endl;
+    return;
+  }
+
+  std::ostream& cacheFile = replacer.stream();
+  if (oldLines.empty()) {
+    cacheFile << "# EvtBtoXsgammaKagan hadronic mass spectra" << endl;
+    cacheFile << "# KAGAN fermi mB mb mu lam1 delta z nIntervalS nIntervalmH n mass_0 br_0 ... mass_n-1 br_n-1" << endl;
+  } else {
+    cacheFile << oldLines;
+    if (oldLines[oldLines.size()-1] != '\n') cacheFile << endl;
+  }
+
+  cacheFile << "KAGAN" << std::setprecision(17);
+  for (size_t k=0; k<key.size(); k++) cacheFile << " " << key[k];
+  cacheFile << " " << _massHad.size();
+  for (size_t k=0; k<_massHad.size(); k++) cacheFile << " " << _massHad[k] << " " << _brHad[k];
+  cacheFile << endl;
+
+  if (!replacer.commit()) {
+    EvtGenReport(EVTGEN_WARNING,"EvtGen") << "EvtBtoXsgammaKagan: could not write to "
+                                          << fileName << endl;
+  }
+
+}
+
+void EvtBtoXsgammaKagan::setSpectrumCacheFile(const std::string& fileName) {
+  spectrumCacheFile() = fileName;
+}
+
+std::string& EvtBtoXsgammaKagan::spectrumCacheFile() {
+  static std::string fileName;
+  return fileName;
+}
+
 double EvtBtoXsgammaKagan::GetMass( int /*Xscode*/ ){
  
 //  Get hadronic mass for the event according to the hadronic mass spectra computed in computeHadronicMass
   double mass=0.0;
   double min=_mHmin;
-  if(bbprod)min=1.1;
+  if(_bbprod)min=1.1;
   //  double max=4.5;
   double max=_mHmax;
   double xbox(0), ybox(0);
-  double boxheight(0);
+  double boxheight=_boxHeight;
   double trueHeight(0);
   double boxwidth=max-min;
   double wgt(0.);
 
-  for (int i=0;i<int(intervalMH+1.0);i++) {
-    if(brHad[i]>boxheight)boxheight=brHad[i];
-  }
+  int n = _massHad.size();
+
   while ((mass > max) || (mass < min)){
     xbox = EvtRandom::Flat(boxwidth)+min;
     ybox=EvtRandom::Flat(boxheight);
     trueHeight=0.0;
     // Correction by Peter Richardson
-    for( int i = 1 ; i < int( intervalMH + 1.0 ) ; ++i ) {
-      if ( ( massHad[i] >= xbox ) && ( 0.0 == trueHeight ) ) {
-	wgt=(xbox-massHad[i-1])/(massHad[i]-massHad[i-1]);
-	trueHeight=brHad[i-1]+wgt*(brHad[i]-brHad[i-1]);
-      }
+    // The masses are increasing, so this starts at the first one above xbox
+    int first = std::lower_bound(_massHad.begin()+1, _massHad.end(), xbox) - _massHad.begin();
+    for( int i = first ; i < n && 0.0 == trueHeight ; ++i ) {
+      wgt=(xbox-_massHad[i-1])/(_massHad[i]-_massHad[i-1]);
+      trueHeight=_brHad[i-1]+wgt*(_brHad[i]-_brHad[i-1]);
     }
 
     if (ybox>trueHeight) {
@@ -709,7 +902,7 @@ double EvtBtoXsgammaKagan::Fz(double z) {
   return (1. -8.*z + 8.*pow(z,3.) - pow(z,4.) - 12.*pow(z,2.)*log(z));
 }
 
-double EvtBtoXsgammaKagan::GetArrayVal(double xp, double nInterval, double xMin, double xMax, std::vector<double> array) {
+double EvtBtoXsgammaKagan::GetArrayVal(double xp, double nInterval, double xMin, double xMax, const std::vector<double> &array) {
  
   double dx = (xMax - xMin)/nInterval;
   int bin1 = int(((xp-xMin)/(xMax - xMin))*nInterval);
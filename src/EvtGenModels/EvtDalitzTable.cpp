@@ -15,6 +15,8 @@
 // Modification history:
 //
 //    DCC     16 December, 2011         Module created
+//            Oct 2026                  Parallel probMax scan with a
+//                                      cache of its results
 //
 //------------------------------------------------------------------------
 
@@ -25,14 +27,102 @@
 #include "EvtGenBase/EvtSpinType.hh"
 #include "EvtGenBase/EvtDalitzPlot.hh"
 #include "EvtGenBase/EvtCyclic3.hh"
+#include "EvtGenBase/EvtProbMaxCache.hh"
+#include "EvtGenBase/EvtTaskPool.hh"
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 
 using std::endl;
 using std::fstream;
 using std::ifstream;
 
+namespace {
+
+  typedef std::vector<std::pair<EvtComplex,EvtDalitzReso> > EvtDalitzResoList;
+
+  double dalitzProb(const EvtDalitzPoint& point, EvtDalitzResoList& resonances) {
+
+    EvtComplex amp(0,0);
+    EvtDalitzResoList::iterator i = resonances.begin();
+    for( ; i!= resonances.end(); i++) {
+      amp += i->first * i->second.evaluate( point );
+    }
+    return abs2(amp);
+  }
+
+  // One row of the probMax grid per task: task i scans row i%nStep of
+  // the AB-BC, BC-CA or CA-AB plane. EvtDalitzReso::evaluate is not
+  // const, so every worker has its own copy of the resonances.
+  class EvtDalitzScanTask : public EvtTaskPool::Task {
+
+  public:
+
+    EvtDalitzScanTask(const EvtDalitzPlot& dp, const EvtDalitzResoList& resonances,
+                      int nStep, int nWorkers) :
+      _dp(dp), _nStep(nStep), _resonances(nWorkers, resonances), _maxProb(nWorkers, 0.) {}
+
+    virtual void run(int iTask, int iWorker) {
+
+      static const EvtCyclic3::Pair pairs[4] = {EvtCyclic3::AB, EvtCyclic3::BC,
+                                                EvtCyclic3::CA, EvtCyclic3::AB};
+
+      EvtCyclic3::Pair pair1 = pairs[iTask/_nStep];
+      EvtCyclic3::Pair pair2 = pairs[iTask/_nStep+1];
+      int i = iTask%_nStep;
+
+      double min = _dp.qAbsMin(pair1);
+      double max = _dp.qAbsMax(pair1);
+      double step = (max-min)/_nStep;
+      double q1 = min + i*step;
+
+      double min2 = _dp.qMin(pair2,pair1,q1);
+      double max2 = _dp.qMax(pair2,pair1,q1);
+      double step2 = (max2-min2)/_nStep;
+
+      double& maxProb = _maxProb[iWorker];
+      for(int j=0; j<_nStep; ++j) {
+        double q2 = min2+ j*step2;
+        EvtDalitzCoord coord(pair1,q1,pair2,q2);
+        EvtDalitzPoint point(_dp,coord);
+        double prob = dalitzProb(point,_resonances[iWorker]);
+        if(prob > maxProb) maxProb = prob;
+      }
+    }
+
+    double maxProb() const {
+      double maxProb(0);
+      for(size_t i=0; i<_maxProb.size(); ++i) {
+        if(_maxProb[i] > maxProb) maxProb = _maxProb[i];
+      }
+      return maxProb;
+    }
+
+  private:
+
+    const EvtDalitzPlot& _dp;
+    int _nStep;
+    std::vector<EvtDalitzResoList> _resonances;
+    std::vector<double> _maxProb;
+
+  };
+
+  // FNV-1a, to key the probMax cache by the description of a decay
+  uint64_t hashKey(const std::string& key) {
+
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i=0; i<key.size(); ++i) {
+      hash ^= static_cast<unsigned char>(key[i]);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+}
+
 EvtDalitzTable::EvtDalitzTable() {
   _dalitztable.clear();
   _readFiles.clear();
@@ -84,6 +174,10 @@ void EvtDalitzTable::readXMLDecayFile(const std::string dec_name, bool verbose){
   std::string daugStr = "";
   EvtId daughter[3];
 
+  //everything the probMax scan depends on, to find it in the cache
+  std::ostringstream scanKey;
+  scanKey.precision(17);
+
   EvtDalitzPlot dp;
   EvtComplex cAmp;
   std::vector< std::pair<EvtCyclic3::Pair,EvtCyclic3::Pair> > angAndResPairs;
@@ -134,6 +228,9 @@ void EvtDalitzTable::readXMLDecayFile(const std::string dec_name, bool verbose){
 
         dp = EvtDalitzPlot( m_d1, m_d2, m_d3, M );
 
+        scanKey.str("");
+        scanKey << M << " " << m_d1 << " " << m_d2 << " " << m_d3;
+
         dalitzDecay = new EvtDalitzDecayInfo(daughter[0],daughter[1],daughter[2]);
 
       } else if(parser.getTagTitle() == "copyDalitz") {
@@ -314,6 +411,14 @@ void EvtDalitzTable::readXMLDecayFile(const std::string dec_name, bool verbose){
           }
         }
 
+        scanKey << " | " << shape << " " << spinType << " " << mass << " " << width
+                << " " << FFp << " " << FFr << " " << alpha << " " << aLass << " " << rLass
+                << " " << BLass << " " << phiBLass << " " << RLass << " " << phiRLass
+                << " " << cutoffLass << " " << ::real(cAmp) << " " << ::imag(cAmp);
+        for(size_t i=0; i<angAndResPairs.size(); ++i) {
+          scanKey << " " << angAndResPairs[i].first << angAndResPairs[i].second;
+        }
+
         if(parser.isTagInline()) {
           std::vector< std::pair<EvtCyclic3::Pair,EvtCyclic3::Pair> >::iterator it = angAndResPairs.begin();
           for( ; it != angAndResPairs.end(); it++) {
@@ -325,8 +430,7 @@ void EvtDalitzTable::readXMLDecayFile(const std::string dec_name, bool verbose){
       } else if(parser.getTagTitle() == "/dalitzDecay") {
         if(probMax < 0) {
           EvtGenReport(EVTGEN_INFO,"EvtGen") << "probMax is not defined for " << decayParent << " -> " << daugStr << endl;
-          EvtGenReport(EVTGEN_INFO,"EvtGen") << "Will now estimate probMax. This may take a while. Once probMax is calculated, update the XML file to skip this step in future." << endl;
-          probMax = calcProbMax(dp,dalitzDecay);
+          probMax = findProbMax(decayParent+" -> "+daugStr,scanKey.str(),dp,dalitzDecay);
         }
         dalitzDecay->setProbMax(probMax);
         addDecay(ipar, *dalitzDecay);
@@ -344,6 +448,7 @@ void EvtDalitzTable::readXMLDecayFile(const std::string dec_name, bool verbose){
                              parser.readAttributeDouble("mass2"),
                              parser.readAttributeDouble("g"));
         flatteParams.push_back(param);
+        scanKey << " flatte " << param.m1() << " " << param.m2() << " " << param.g();
       } else if(parser.getTagTitle() == "/resonance") {
         std::vector< std::pair<EvtCyclic3::Pair,EvtCyclic3::Pair> >::iterator it = angAndResPairs.begin();
         for( ; it != angAndResPairs.end(); it++) {
@@ -483,81 +588,69 @@ int EvtDalitzTable::getDaughterPairs(EvtId* resDaughter, EvtId* daughter, std::v
   return n;
 }
 
-double EvtDalitzTable::calcProbMax(EvtDalitzPlot dp, EvtDalitzDecayInfo* model) {
+double EvtDalitzTable::findProbMax(const std::string& decay, const std::string& scanKey,
+                                   EvtDalitzPlot dp, EvtDalitzDecayInfo* model) {
 
-  double factor = 1.2; //factor to increase our final answer by
-  int nStep(1000);      //number of steps - total points will be 3*nStep*nStep
+  const std::string& fileName = probMaxCacheFile();
 
-  double maxProb(0);
-  double min(0), max(0), step(0), min2(0), max2(0), step2(0);
-
-  //first do AB, BC
-  min = dp.qAbsMin(EvtCyclic3::AB);
-  max = dp.qAbsMax(EvtCyclic3::AB);
-  step = (max-min)/nStep;
-  for(int i=0; i<nStep; ++i) {
-    double qAB = min + i*step;
-    min2 = dp.qMin(EvtCyclic3::BC,EvtCyclic3::AB,qAB);
-    max2 = dp.qMax(EvtCyclic3::BC,EvtCyclic3::AB,qAB);
-    step2 = (max2-min2)/nStep;
-    for(int j=0; j<nStep; ++j) {
-      double qBC = min2+ j*step2;
-      EvtDalitzCoord coord(EvtCyclic3::AB,qAB,EvtCyclic3::BC,qBC);
-      EvtDalitzPoint point(dp,coord);
-      double prob = calcProb(point,model);
-      if(prob > maxProb) maxProb = prob;
-    }
+  if(fileName.empty()) return calcProbMax(dp,model);
+
+  EvtProbMaxCache cache;
+  ifstream cacheFile(fileName.c_str());
+  if(cacheFile) {
+    cacheFile.close();
+    cache.read(fileName);
   }
 
-  //next do BC, CA
-  min = dp.qAbsMin(EvtCyclic3::BC);
-  max = dp.qAbsMax(EvtCyclic3::BC);
-  step = (max-min)/nStep;
-  for(int i=0; i<nStep; ++i) {
-    double qBC = min + i*step;
-    min2 = dp.qMin(EvtCyclic3::CA,EvtCyclic3::BC,qBC);
-    max2 = dp.qMax(EvtCyclic3::CA,EvtCyclic3::BC,qBC);
-    step2 = (max2-min2)/nStep;
-    for(int j=0; j<nStep; ++j) {
-      double qCA = min2+ j*step2;
-      EvtDalitzCoord coord(EvtCyclic3::BC,qBC,EvtCyclic3::CA,qCA);
-      EvtDalitzPoint point(dp,coord);
-      double prob = calcProb(point,model);
-      if(prob > maxProb) maxProb = prob;
-    }
+  std::ostringstream key;
+  key << "DALITZ " << decay << " ; " << std::hex << std::setfill('0') << std::setw(16) << hashKey(scanKey);
+
+  double probMax(0);
+  if(cache.get(key.str(),probMax)) {
+    EvtGenReport(EVTGEN_INFO,"EvtGen") << "Using probMax " << probMax << " from " << fileName << endl;
+    return probMax;
   }
 
-  //finally do CA, AB
-  min = dp.qAbsMin(EvtCyclic3::CA);
-  max = dp.qAbsMax(EvtCyclic3::CA);
-  step = (max-min)/nStep;
-  for(int i=0; i<nStep; ++i) {
-    double qCA = min + i*step;
-    min2 = dp.qMin(EvtCyclic3::AB,EvtCyclic3::CA,qCA);
-    max2 = dp.qMax(EvtCyclic3::AB,EvtCyclic3::CA,qCA);
-    step2 = (max2-min2)/nStep;
-    for(int j=0; j<nStep; ++j) {
-      double qAB = min2+ j*step2;
-      EvtDalitzCoord coord(EvtCyclic3::CA,qCA,EvtCyclic3::AB,qAB);
-      EvtDalitzPoint point(dp,coord);
-      double prob = calcProb(point,model);
-      if(prob > maxProb) maxProb = prob;
-    }
+  probMax = calcProbMax(dp,model);
+
+  // Pick up what other jobs added during the scan before replacing the file
+  cacheFile.open(fileName.c_str());
+  if(cacheFile) {
+    cacheFile.close();
+    cache.read(fileName);
   }
+  cache.merge(key.str(),probMax);
+  cache.write(fileName);
+
+  return probMax;
+}
+
+double EvtDalitzTable::calcProbMax(EvtDalitzPlot dp, EvtDalitzDecayInfo* model) {
+
+  EvtGenReport(EVTGEN_INFO,"EvtGen") << "Will now estimate probMax. This may take a while. Once probMax is calculated, update the XML file to skip this step in future." << endl;
+
+  double factor = 1.2; //factor to increase our final answer by
+  int nStep(1000);      //number of steps - total points will be 3*nStep*nStep
+
+  //the rows of the AB-BC, BC-CA and CA-AB scans are spread over all cores,
+  //or as many threads as set with EvtTaskPool::setInitThreads
+  int nWorkers = EvtTaskPool::getInitThreads();
+  EvtDalitzScanTask task(dp, model->getResonances(), nStep, nWorkers);
+  EvtTaskPool pool(nWorkers);
+  pool.run(task, 3*nStep);
+
+  double maxProb = task.maxProb();
+
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "Largest probability found was " << maxProb << endl;
   EvtGenReport(EVTGEN_INFO,"EvtGen") << "Setting probMax to " << factor*maxProb << endl;
   return factor*maxProb;
 }
 
-double EvtDalitzTable::calcProb(EvtDalitzPoint point, EvtDalitzDecayInfo* model) {
-
-  std::vector<std::pair<EvtComplex,EvtDalitzReso> > resonances = model->getResonances();
+void EvtDalitzTable::setProbMaxCacheFile(const std::string& fileName) {
+  probMaxCacheFile() = fileName;
+}
 
-  EvtComplex amp(0,0);
-  std::vector<std::pair<EvtComplex,EvtDalitzReso> >::iterator i = resonances.begin();
-  for( ; i!= resonances.end(); i++) {
-    std::pair<EvtComplex,EvtDalitzReso> res = (*i);
-    amp += res.first * res.second.evaluate( point );
-  }
-  return abs2(amp);
+std::string& EvtDalitzTable::probMaxCacheFile() {
+  static std::string fileName;
+  return fileName;
 }
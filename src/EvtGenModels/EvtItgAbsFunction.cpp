@@ -18,6 +18,7 @@
 //
 //    Jane Tinslay                March 21, 2001       Module adapted for use in 
 //                                                     EvtGen
+//                                Oct 2026             Added values()
 //
 //------------------------------------------------------------------------
 #include "EvtGenBase/EvtPatches.hh"
@@ -54,3 +55,8 @@ double
 EvtItgAbsFunction::operator()(double x) const{
   return myFunction(x);
 }
+
+void
+EvtItgAbsFunction::values(int n, const double x[], double f[]) const{
+  for (int i=0; i<n; i++) f[i] = myFunction(x[i]);
+}
@@ -0,0 +1,198 @@
+//--------------------------------------------------------------------------
+//
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Module: EvtItgGaussKronrodIntegrator.cc
+//
+// Description:
+//      Adaptive Gauss-Kronrod integrator, see EvtItgGaussKronrodIntegrator.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenModels/EvtItgGaussKronrodIntegrator.hh"
+
+//---------------
+// C++ Headers --
+//---------------
+
+#include <math.h>
+#include <float.h>
+
+//-------------------------------
+// Collaborating Class Headers --
+//-------------------------------
+
+#include "EvtGenModels/EvtItgAbsFunction.hh"
+#include "EvtGenBase/EvtReport.hh"
+using std::endl;
+
+namespace {
+
+  // Abscissae and weights of the 15 point Kronrod rule and of the
+  // 7 point Gauss rule embedded in it (QUADPACK qk15)
+  const double xgk[8] = {
+    0.991455371120812639206854697526329,
+    0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926,
+    0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013,
+    0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245,
+    0.000000000000000000000000000000000
+  };
+
+  const double wgk[8] = {
+    0.022935322010529224963732008058970,
+    0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518,
+    0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550,
+    0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649,
+    0.209482141084727828012999174891714
+  };
+
+  const double wg[4] = {
+    0.129484966168869693270611432679082,
+    0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975,
+    0.417959183673469387755102040816327
+  };
+
+}
+
+EvtItgGaussKronrodIntegrator::EvtItgGaussKronrodIntegrator(const EvtItgAbsFunction &theFunction, double precision, int maxIntervals):
+  EvtItgAbsIntegrator(theFunction),
+  _precision(precision),
+  _maxIntervals(maxIntervals)
+{
+  if (_maxIntervals < 1) _maxIntervals = 1;
+  if (_maxIntervals > maxIntervalsLimit) _maxIntervals = maxIntervalsLimit;
+}
+
+
+//--------------
+// Destructor --
+//--------------
+
+EvtItgGaussKronrodIntegrator::~EvtItgGaussKronrodIntegrator()
+{}
+
+void
+EvtItgGaussKronrodIntegrator::rule(double lower, double upper, double &result, double &error) const{
+
+  double centre = 0.5*(lower+upper);
+  double halfLength = 0.5*(upper-lower);
+
+  // x[2*j] and x[2*j+1] are the pair at +-xgk[j], x[14] the centre
+  double x[15], f[15];
+  for (int j=0; j<7; j++) {
+    x[2*j] = centre - halfLength*xgk[j];
+    x[2*j+1] = centre + halfLength*xgk[j];
+  }
+  x[14] = centre;
+
+  myFunctionValues(15, x, f);
+
+  double resultKronrod = wgk[7]*f[14];
+  double resultGauss = wg[3]*f[14];
+  double resultAbs = fabs(resultKronrod);
+  for (int j=0; j<7; j++) {
+    double sum = f[2*j] + f[2*j+1];
+    resultKronrod += wgk[j]*sum;
+    resultAbs += wgk[j]*(fabs(f[2*j]) + fabs(f[2*j+1]));
+    if (j%2==1) resultGauss += wg[j/2]*sum;
+  }
+
+  double mean = 0.5*resultKronrod;
+  double resultAsc = wgk[7]*fabs(f[14]-mean);
+  for (int j=0; j<7; j++) {
+    resultAsc += wgk[j]*(fabs(f[2*j]-mean) + fabs(f[2*j+1]-mean));
+  }
+
+  double length = fabs(halfLength);
+  result = resultKronrod*halfLength;
+  resultAbs *= length;
+  resultAsc *= length;
+  error = fabs((resultKronrod-resultGauss)*halfLength);
+
+  // QUADPACK's scaling of the error estimate
+  if (resultAsc != 0.0 && error != 0.0) {
+    double scale = pow(200.0*error/resultAsc, 1.5);
+    if (scale < 1.0) error = resultAsc*scale;
+    else error = resultAsc;
+  }
+  if (resultAbs > DBL_MIN/(50.0*DBL_EPSILON) && error < 50.0*DBL_EPSILON*resultAbs) {
+    error = 50.0*DBL_EPSILON*resultAbs;
+  }
+
+}
+
+double
+EvtItgGaussKronrodIntegrator::evaluateIt(double lower, double higher) const{
+
+  // The intervals and their estimates; no allocation per integral
+  double a[maxIntervalsLimit], b[maxIntervalsLimit];
+  double r[maxIntervalsLimit], e[maxIntervalsLimit];
+
+  int n = 1;
+  a[0] = lower;
+  b[0] = higher;
+  rule(lower, higher, r[0], e[0]);
+
+  double result = r[0];
+  double error = e[0];
+
+  while (error > _precision*fabs(result) && error != 0.0) {
+
+    // bisect the interval with the largest error
+    int worst = 0;
+    for (int i=1; i<n; i++) {
+      if (e[i] > e[worst]) worst = i;
+    }
+
+    double middle = 0.5*(a[worst]+b[worst]);
+    if (n >= _maxIntervals ||
+        fabs(b[worst]-a[worst]) < 100.0*DBL_EPSILON*(fabs(middle)+DBL_MIN)) {
+      EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Severe error in EvtItgGaussKronrodIntegrator.  Failed to converge with "
+                                          << n << " intervals, error estimate " << error
+                                          << " of integral " << result << "." << endl;
+      return 0.0;
+    }
+
+    double r1, e1, r2, e2;
+    rule(a[worst], middle, r1, e1);
+    rule(middle, b[worst], r2, e2);
+
+    a[n] = middle;
+    b[n] = b[worst];
+    r[n] = r2;
+    e[n] = e2;
+    n++;
+
+    b[worst] = middle;
+    r[worst] = r1;
+    e[worst] = e1;
+
+    result = 0.0;
+    error = 0.0;
+    for (int i=0; i<n; i++) {
+      result += r[i];
+      error += e[i];
+    }
+
+  }
+
+  return result;
+
+}
@@ -199,7 +199,7 @@ EvtModelReg::EvtModelReg(const std::list<EvtDecayBase*>* extraModels)
     if(extraModels){
       for(std::list<EvtDecayBase*>::const_iterator it = extraModels->begin(); 
 	  it != extraModels->end(); ++it){
-	modelist.registerModel(*it);
+	modelist.registerModel(*it,false);
       }
     }
 
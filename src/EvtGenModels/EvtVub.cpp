@@ -15,6 +15,7 @@
 // Modification history:
 //
 //    Sven Menke       January 17, 2001       Module created
+//                     Oct 2026               Weights in an EvtVubBinnedWeights
 //
 //------------------------------------------------------------------------
 //
@@ -34,8 +35,6 @@ using std::endl;
 
 EvtVub::~EvtVub() {
   if (_dGamma) delete _dGamma;
-  if (_masses) delete [] _masses;
-  if (_weights) delete [] _weights;
 }
 
 std::string EvtVub::getName(){
@@ -70,8 +69,8 @@ void EvtVub::init(){
   _alphas  	= getArg(2);
   _nbins        = abs((int)getArg(3));
   _storeQplus   = (getArg(3)<0?1:0);
-  _masses       = new double[_nbins];
-  _weights      = new double[_nbins];
+  _masses.resize(_nbins);
+  std::vector<double> weights(_nbins);
  
   if (getNArg()-4 != 2*_nbins) {
     EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVub generator expected " 
@@ -90,15 +89,15 @@ void EvtVub::init(){
 			     << "Will terminate execution!"<<endl;
       ::abort();
     }
-    _weights[i] = getArg(j++);
-    if (_weights[i] < 0) {
+    weights[i] = getArg(j++);
+    if (weights[i] < 0) {
       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVub generator expected " 
 			     << " weights >= 0, but found: " 
-			     <<_weights[i] <<endl;
+			     <<weights[i] <<endl;
       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution!"<<endl;
       ::abort();
     }
-    if ( _weights[i] > maxw ) maxw = _weights[i];
+    if ( weights[i] > maxw ) maxw = weights[i];
   }
   if (maxw == 0) {
     EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVub generator expected at least one " 
@@ -106,7 +105,9 @@ void EvtVub::init(){
 			   << "Will terminate execution!"<<endl;
     ::abort();
   }
-  for (i=0;i<_nbins;i++) _weights[i]/=maxw;
+  for (i=0;i<_nbins;i++) weights[i]/=maxw;
+  _weights.addAxis(_masses, EvtVubBinnedWeights::closedAbove);
+  _weights.setWeights(weights);
 
   // the maximum dGamma*p2 value depends on alpha_s only:
 
@@ -241,9 +242,8 @@ void EvtVub::decay( EvtParticle *p ){
     // reweight the Mx distribution
     if(_nbins>0){
       double xran1 = EvtRandom::Flat();
-      double m = sqrt(sh);j=0;
-      while ( j < _nbins && m > _masses[j] ) j++; 
-      double w = _weights[j-1]; 
+      int bin = _weights.findBin(0, sqrt(sh));
+      double w = bin >= 0 ? _weights.getWeight(bin) : 0.;
       if ( w >= xran1 ) rew = false;
     } else {
       rew = false;
@@ -5,6 +5,11 @@
 // Analytic Coupling Model (based on hep-ph/0608047 by Aglietti, Ferrera and Ricciardi)
 // Author: Michael Sigamani           May 2008
 //
+// Modification history:
+//
+//            Oct 2026   Tabulated rate with bounded error, static tables
+//                       in Sigma and Lambda^2 computed once
+//
 ///////////////////////////////////////////////////////////////
 
 #include "EvtGenBase/EvtPatches.hh"
@@ -15,6 +20,7 @@
 #include "EvtGenBase/EvtReport.hh"
 #include "EvtGenModels/EvtVubAC.hh"
 #include <string>
+#include <algorithm>
 #include "EvtGenBase/EvtVector4R.hh"
 #include "EvtGenModels/EvtPFermi.hh"
 #include "EvtGenBase/EvtRandom.hh"
@@ -22,6 +28,37 @@
 using std::cout;
 using std::endl;
 
+namespace {
+
+  // The rate is tabulated in u, s = w/(1+u) and t, the position of xb
+  // between its limits w*u/(1+u) and w/(1+u), which all run from 0 to 1
+  // over the phase space. nGrid cells in each.
+  const int nGrid = 32;
+
+  int node(int iu, int is, int it) {
+    return (iu*(nGrid+1)+is)*(nGrid+1)+it;
+  }
+
+  int cell(int iu, int is, int it) {
+    return (iu*nGrid+is)*nGrid+it;
+  }
+
+  // Trilinear interpolation of entry i of the nodes of the cell iu, is,
+  // it at the fractions du, ds and dt of its size
+  double interpolate(const std::vector<double>& table, int i,
+                     int iu, int is, int it, double du, double ds, double dt) {
+    const double* r = &table[2*node(iu,is,it)+i];
+    const int ds1 = 2*(nGrid+1);
+    const int du1 = 2*(nGrid+1)*(nGrid+1);
+    double r00 = r[0]*(1-dt) + r[2]*dt;
+    double r01 = r[ds1]*(1-dt) + r[ds1+2]*dt;
+    double r10 = r[du1]*(1-dt) + r[du1+2]*dt;
+    double r11 = r[du1+ds1]*(1-dt) + r[du1+ds1+2]*dt;
+    return (r00*(1-ds) + r01*ds)*(1-du) + (r10*(1-ds) + r11*ds)*du;
+  }
+
+}
+
 EvtVubAC::~EvtVubAC() {
 }
 
@@ -54,20 +91,17 @@ void EvtVubAC::init() {
   beta0 = (11.0/3.0*CA - 2.0/3.0*nf)/(4*M_PI);
   alphaSmB = 0.22*alphaSmZ/0.1189;
 
-  gvars.push_back(0.0); // 0
-  gvars.push_back(0.0); // 1
-  gvars.push_back(0.0); // 2
-  gvars.push_back(alphaSmB); // 3
-  gvars.push_back(alphaSmZ); // 4
-  gvars.push_back(mB); // 5
-  gvars.push_back(beta0); // 6
-  gvars.push_back(c); // 7
-  gvars.push_back(q); // 8
-  gvars.push_back(k); // 9
+  // Lambda^2 of the analytic coupling, the same for every call of alphaS
+  LambdaQCD2 = FindRoot(alphaSmZ);
 
-  // check that there are 3 daughters and 1 argument
+  // check that there are 3 daughters and 1 or 2 arguments
   checkNDaug(3);
-  checkNArg(1);
+  checkNArg(1,2);
+
+  // optional relative tolerance of the tabulated rate
+  tolerance = 0.0;
+  if (getNArg()>1) tolerance = getArg(1);
+  if (tolerance>0.0) fillRateTable();
 
 }
 
@@ -108,7 +142,7 @@ void EvtVubAC::decay(EvtParticle *Bmeson) {
 
 	if ( ((w*u)/(1.0+u) < xb) && (xb < w/(1.0+u)) && (max(0, w - 1.0) < u) && (sh > 4.0*mpi*mpi) && ( El > ml ) ){ 
 
-     		pdf = rate(u,w,xb);  
+     		pdf = tolerance>0.0 ? interpolatedRate(u,w,xb) : rate(u,w,xb);
      		double testRan = EvtRandom::Flat(0.0,24.2);
 			if (pdf >= testRan) tryit = false;
 	}
@@ -214,15 +248,120 @@ void EvtVubAC::decay(EvtParticle *Bmeson) {
 }
 
 double EvtVubAC::rate(double u, double w, double xb) {
-std::vector<double> vars(11);
-vars[0] = u;
-vars[1] = w;
-vars[2] = xb;
 double dGam = Coeff(u,w,xb)*Sigma(wreg(w/(1+u)),ularge(u)) + d(u,w,xb);
 
 return dGam;
 }
 
+void EvtVubAC::fillRateTable() {
+
+  // Coeff and d are tabulated and Sigma, itself a fine table, is
+  // evaluated as it is. The cells at u = 1 and at s = 0 are always
+  // evaluated exactly, as the rate is singular there, so those nodes
+  // are not needed.
+  rateTable.assign(2*(nGrid+1)*(nGrid+1)*(nGrid+1),0.0);
+  exactCell.assign(nGrid*nGrid*nGrid,1);
+
+  double h = 1.0/nGrid;
+  double meanRate = 0.0;
+  int nNode = 0;
+
+  int iu, is, it;
+  for (iu=0; iu<nGrid; iu++) {
+    for (is=1; is<=nGrid; is++) {
+      for (it=0; it<=nGrid; it++) {
+        double u = iu*h;
+        double s = is*h;
+        double t = it*h;
+        double w = s*(1+u);
+        double xb = s*(u+t*(1-u));
+        double coeff = Coeff(u,w,xb);
+        double dd = d(u,w,xb);
+        rateTable[2*node(iu,is,it)] = coeff;
+        rateTable[2*node(iu,is,it)+1] = dd;
+        if (is<nGrid) {
+          meanRate += fabs(coeff*Sigma(wreg(s),ularge(u))+dd);
+          nNode++;
+        }
+      }
+    }
+  }
+  meanRate /= nNode;
+
+  // Compare to the exact rate at the centre, the face centres and just
+  // inside the corners of each cell; the error is measured relative to
+  // the rate, or to the mean rate where the rate is smaller
+  const double eps = 0.01;
+  const int nCheck = 15;
+  const double check[nCheck][3] = {
+    {0.5,0.5,0.5},
+    {0.0,0.5,0.5}, {1.0,0.5,0.5}, {0.5,0.0,0.5},
+    {0.5,1.0,0.5}, {0.5,0.5,0.0}, {0.5,0.5,1.0},
+    {eps,eps,eps}, {eps,eps,1-eps}, {eps,1-eps,eps}, {eps,1-eps,1-eps},
+    {1-eps,eps,eps}, {1-eps,eps,1-eps}, {1-eps,1-eps,eps}, {1-eps,1-eps,1-eps}
+  };
+
+  int nCell = 0;
+  int nExact = 0;
+  for (iu=0; iu<nGrid-1; iu++) {
+    for (is=1; is<nGrid; is++) {
+      for (it=0; it<nGrid; it++) {
+        bool good = true;
+        for (int k=0; k<nCheck && good; k++) {
+          double fu = check[k][0];
+          double fs = check[k][1];
+          double ft = check[k][2];
+          double u = (iu+fu)*h;
+          double s = (is+fs)*h;
+          double t = (it+ft)*h;
+          double w = s*(1+u);
+          double xb = s*(u+t*(1-u));
+          double exact = rate(u,w,xb);
+          double interpolated = interpolate(rateTable,0,iu,is,it,fu,fs,ft)*
+            Sigma(wreg(s),ularge(u)) + interpolate(rateTable,1,iu,is,it,fu,fs,ft);
+          if (!(fabs(interpolated-exact) <= tolerance*std::max(fabs(exact),meanRate))) good = false;
+        }
+        nCell++;
+        if (good) {
+          exactCell[cell(iu,is,it)] = 0;
+        } else {
+          nExact++;
+        }
+      }
+    }
+  }
+
+  EvtGenReport(EVTGEN_DEBUG,"EvtGen") << "EvtVubAC: " << nExact << " of "
+                                      << nCell << " cells not within tolerance "
+                                      << tolerance << endl;
+
+}
+
+double EvtVubAC::interpolatedRate(double u, double w, double xb) {
+
+  double s = w/(1+u);
+  double t = (xb/s-u)/(1-u);
+
+  double fu = u*nGrid;
+  double fs = s*nGrid;
+  double ft = t*nGrid;
+  int iu = (int)fu;
+  int is = (int)fs;
+  int it = (int)ft;
+
+  if (iu<0 || is<1 || it<0 || iu>=nGrid || is>=nGrid || it>=nGrid
+      || exactCell[cell(iu,is,it)]) {
+    return rate(u,w,xb);
+  }
+
+  fu -= iu;
+  fs -= is;
+  ft -= it;
+  return interpolate(rateTable,0,iu,is,it,fu,fs,ft)*Sigma(wreg(s),ularge(u)) +
+    interpolate(rateTable,1,iu,is,it,fu,fs,ft);
+
+}
+
 double EvtVubAC::PolyLog(double v, double z) {
 
 if (z >= 1) cout << "Error in EvtVubAC: 2nd argument to PolyLog is >= 1." << endl;
@@ -242,63 +381,39 @@ return lb;
 }
 
 double EvtVubAC::wreg(double w) {
-std::vector<double> vars(11);
-vars[1] = w;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}  
 double K=(1+c)/(1+c+pow(c,2));
 return K*(c+pow(w,2)/(w+c));
 }
 
 double EvtVubAC::ureg(double u) {
-std::vector<double> vars(11);  
-vars[0] = u;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 return q + u*u/(u+q);
 }
 
 double EvtVubAC::ularge(double u) {
-std::vector<double> vars(11);
-vars[0] = u;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 return u - k*u*u;
 }
 
 double EvtVubAC::alphaS(double Q) {
-std::vector<double> vars(11);
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 
-double a =1.0/(log(Q*Q/FindRoot(alphaSmZ)));
-double b= FindRoot(alphaSmZ)/(FindRoot(alphaSmZ) - Q*Q);
+double a =1.0/(log(Q*Q/LambdaQCD2));
+double b= LambdaQCD2/(LambdaQCD2 - Q*Q);
 double ans = 1.0/beta0*( a + b );
 
 return ans;
 }
 
 double EvtVubAC::Coeff(double u, double w, double xb) {
-std::vector<double> vars(11);  
-vars[0] = u;
-vars[1] = w;
-vars[2] = xb;
 
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 
 double coeff = Coeff0(w,xb) + alphaS(mB*wreg(w/(1+u)))*Coeff1(w,xb);
 return coeff;
 }
 
 double EvtVubAC::Coeff0(double w, double xb) {
-std::vector<double> vars(11);
-vars[1] = w;
-vars[2] = xb;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 return 12.0*(1+xb-w)*(w-xb);
 }
 
 double EvtVubAC::Coeff1(double w, double xb) {
-std::vector<double> vars(11);
-vars[1] = w;
-vars[2] = xb;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 double a = 1+xb-w; 
 double b = -PolyLog(2,1-w)-3.0/2.0*log(wreg(w)) - 1.0/2.0*w*f(w) - 35.0/8.0 + (M_PI*M_PI)/6.0;
 double c = 1.0/2.0*xb*f(wreg(w));
@@ -309,22 +424,12 @@ return ans;
 }
 
 double EvtVubAC::d(double u, double w, double xb) {
-std::vector<double> vars(11); 
-vars[0] = u;
-vars[1] = w;
-vars[2] = xb;
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 
 return alphaS(mB*wreg(w/(1.0+u)))*CF/M_PI*d1(u,w,xb);
 
 }
 
 double EvtVubAC::d1(double u, double w, double xb) {
-std::vector<double> vars(11);
-vars[0] = u;
-vars[1] = w;
-vars[2] = xb; 
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 
 double a = 3*pow(w,4)*(24+3*w-8*xb)/(4*pow(1+u,5));
 double b = 9*pow(w,4)*(24+3*w-8*xb)/(8*pow(1+u,4));
@@ -349,9 +454,6 @@ return rem;
 }
 
 double EvtVubAC::f(double w) {
-std::vector<double> vars(11);
-vars[1] = w;      
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
   if (w != 1)
         return log(w)/(1-w);
                 else
@@ -359,16 +461,12 @@ for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 }
 
 double EvtVubAC::Lambda2(double x, const double alphaSmZ) {
-std::vector<double> vars(11);
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 double alphaSmB =  0.22*alphaSmZ/0.1189;
 double func = (1/beta0)*(1/log(mB*mB/x)+x/(x-mB*mB))-alphaSmB;
 return func;
 }
 
 double EvtVubAC::FindRoot(const double alphaSmZ){
-std::vector<double> vars(11);
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
    double root;
    const double precision=1e-8;
    Bisect(0.0,1.0, precision, root, alphaSmZ);
@@ -376,9 +474,7 @@ return root;
 }
 
 int EvtVubAC::Bisect(double x1,double x2, double precision,double& root, const double alphaSmZ){
-std::vector<double> vars(11);
 
-for (int j=3;j<11;j++) {vars[j] = gvars[j];}
 
     if( Lambda2(x1,alphaSmZ)*Lambda2(x2,alphaSmZ) > 0 ){
         root = 0;
@@ -422,7 +518,7 @@ int KMAX = 6282;
         else{
 
  
-double sigma[6283][21] = {{1.4165575231667025e-6,2.367068423885654e-6,3.010516455581869e-6,3.5037825936986625e-6,3.929518324374288e-6,4.306057170491293e-6,4.670305737607004e-6,5.03601978363166e-6,5.38081382734055e-6,5.706111094422232e-6,6.01592741932564e-6,6.312683745642994e-6,6.599149887344445e-6,6.876589598409881e-6,7.146140172115845e-6,7.408228896739411e-6,7.66381903520912e-6,7.914216132923142e-6,8.158375083092094e-6,8.387923687779773e-6,8.609047991600152e-6},
+static const double sigma[6283][21] = {{1.4165575231667025e-6,2.367068423885654e-6,3.010516455581869e-6,3.5037825936986625e-6,3.929518324374288e-6,4.306057170491293e-6,4.670305737607004e-6,5.03601978363166e-6,5.38081382734055e-6,5.706111094422232e-6,6.01592741932564e-6,6.312683745642994e-6,6.599149887344445e-6,6.876589598409881e-6,7.146140172115845e-6,7.408228896739411e-6,7.66381903520912e-6,7.914216132923142e-6,8.158375083092094e-6,8.387923687779773e-6,8.609047991600152e-6},
 {1.4242950283096505e-6,2.3821813865451333e-6,3.0321094979724177e-6,3.531463105585163e-6,3.963281819193405e-6,4.345928764350666e-6,4.716578534159503e-6,5.0891092458471885e-6,5.440882358124266e-6,5.773300334146699e-6,6.090393611799158e-6,6.394582544259559e-6,6.6886559040585555e-6,6.973876196346317e-6,7.251379536127028e-6,7.521582534359883e-6,7.78545760383978e-6,8.044322886507219e-6,8.297093782815202e-6,8.535252273580483e-6,8.76506526572483e-6},
 {1.432085473265309e-6,2.397426211753438e-6,3.053927960769999e-6,3.559478172452427e-6,3.997507657500483e-6,4.386409405362107e-6,4.763630567689123e-6,5.143175144213434e-6,5.5021483329791995e-6,5.841932217571044e-6,6.166572855026258e-6,6.478490721190443e-6,6.780495077370961e-6,7.073848449513044e-6,7.359687275376904e-6,7.638419489154442e-6,7.911031108690893e-6,8.178859267303823e-6,8.440787940213002e-6,8.688163613340468e-6,8.92736042107122e-6},
 {1.439929354714352e-6,2.41280463514272e-6,3.0759756040991857e-6,3.5878345116181944e-6,4.0322066625519e-6,4.427515357355928e-6,4.811485212210924e-6,5.198250042510372e-6,5.564655974117598e-6,5.912066071547593e-6,6.244545266975116e-6,6.5645198876533405e-6,6.874832084123841e-6,7.176767831207023e-6,7.471508054632459e-6,7.759532156090581e-6,8.04198240629201e-6,8.32045326864888e-6,8.594180689511984e-6,8.854977185824032e-6,9.110250789357704e-6},
@@ -6707,12 +6803,12 @@ double sigma[6283][21] = {{1.4165575231667025e-6,2.367068423885654e-6,3.01051645
 {-24.95702726318268,-28.41603374108672,-28.208046173589537,-27.370962059532758,-26.53450110432459,-25.74412687594304,-25.16476929106284,-24.74265667324653,-24.324929237249307,-23.945858225924894,-23.597706217726227,-23.258072621247265,-22.94115044485079,-22.649432538542897,-22.379161227901932,-22.12788341025589,-21.893044561729766,-21.672730688005686,-21.465751135896426,-21.24358945764834,-21.022028209641576}};
 
 
-double wreg[]= {0.04, 0.088, 0.136, 0.18400000000000002, 0.232, 0.27999999999999997,
+static const double wreg[]= {0.04, 0.088, 0.136, 0.18400000000000002, 0.232, 0.27999999999999997,
        0.328, 0.376, 0.424, 0.472, 0.52, 0.5680000000000001, 
        0.6160000000000001, 0.664, 0.7120000000000001, 0.76, 0.808, 
 	 0.8560000000000001, 0.904, 0.9520000000000001, 1.0}; 
 
-double ularge[]={0., 0.000999525142261537, 0.0019980512340131984, 0.002995579273830762, 
+static const double ularge[]={0., 0.000999525142261537, 0.0019980512340131984, 0.002995579273830762, 
        0.0039921102592925806, 0.00498764518697925, 0.00598218505247583, 
        0.006975730850371842, 0.007968283574262824, 0.008959844216751223, 
        0.009950413769447386, 0.010939993222970568, 0.011928583566949591, 
@@ -8812,15 +8908,12 @@ double ularge[]={0., 0.000999525142261537, 0.0019980512340131984, 0.002995579273
 
                 if ( x1==wreg[JMAX] ){j=JMAX;}
                         else{
-                for (int y=0; y<=JMAX; y++){
-                        if ( (wreg[y] <= x1) && ( x1 < wreg[y+1]) ) { j=y; break;}
-                }
+                j = std::upper_bound(wreg, wreg+JMAX+1, x1) - wreg - 1;
                         }
  		if ( x2>ularge[KMAX-1] ){k=KMAX;}
                         else{
-                for (int z=0; z<=KMAX; z++){
-                        if ( (ularge[z] <= x2) && ( x2 < ularge[z+1]) ) { k=z; break;}
-                }
+                k = std::upper_bound(ularge, ularge+KMAX+1, x2) - ularge - 1;
+                if ( k<0 ) k=0;
                         }
 
                 //Calculate sigma() using Bi-Linear interpolaion
@@ -17,7 +17,7 @@
 #include "EvtGenModels/EvtVubBLNP.hh"
 #include <string>
 #include "EvtGenBase/EvtVector4R.hh"
-#include "EvtGenModels/EvtItgSimpsonIntegrator.hh"
+#include "EvtGenModels/EvtItgGaussKronrodIntegrator.hh"
 #include "EvtGenModels/EvtItgPtrFunction.hh"
 #include "EvtGenBase/EvtRandom.hh"
 #include "EvtGenModels/EvtPFermi.hh"
@@ -32,7 +32,27 @@
 using std::cout;
 using std::endl;
 
+EvtVubBLNP::EvtVubBLNP()
+  : _funcJS(0), _func1(0), _func2(0), _func3(0),
+    _integJS(0), _integ1(0), _integ2(0), _integ3(0),
+    _grid(0)
+{}
+
 EvtVubBLNP::~EvtVubBLNP() {
+  deleteIntegrators();
+}
+
+void EvtVubBLNP::deleteIntegrators() {
+  delete _integJS;
+  delete _integ1;
+  delete _integ2;
+  delete _integ3;
+  delete _funcJS;
+  delete _func1;
+  delete _func2;
+  delete _func3;
+  _integJS = _integ1 = _integ2 = _integ3 = 0;
+  _funcJS = _func1 = _func2 = _func3 = 0;
 }
 
 std::string EvtVubBLNP::getName(){
@@ -131,7 +151,6 @@ void EvtVubBLNP::init() {
   flag2loop = 1;
 
   // stuff for the integrator
-  maxLoop = 20;
   //precision = 1.0e-3;
   precision = 2.0e-2;
 
@@ -149,6 +168,27 @@ void EvtVubBLNP::init() {
   gvars.push_back(beta2); // 10
   gvars.push_back(dtype); // 11
 
+  // Pp and Pm (gvars[0] and gvars[1]) are set for each integral; the
+  // integrands are only evaluated between 0.001*Pp and 0.999*Pp < mBB
+  deleteIntegrators();
+  _funcJS = new EvtItgPtrFunction(&IntJS, 0.0, mBB, gvars);
+  _func1 = new EvtItgPtrFunction(&Int1, 0.0, mBB, gvars);
+  _func2 = new EvtItgPtrFunction(&Int2, 0.0, mBB, gvars);
+  _func3 = new EvtItgPtrFunction(&Int3, 0.0, mBB, gvars);
+  _integJS = new EvtItgGaussKronrodIntegrator(*_funcJS, precision);
+  _integ1 = new EvtItgGaussKronrodIntegrator(*_func1, precision);
+  _integ2 = new EvtItgGaussKronrodIntegrator(*_func2, precision);
+  _integ3 = new EvtItgGaussKronrodIntegrator(*_func3, precision);
+
+  // VUB_BLNP and VUB_BLNPHYBRID share their grids
+  _grid = 0;
+  if (EvtVubIntegralGrid::getTolerance() > 0.0) {
+    std::vector<double> key(1, 1.0);
+    for (int i=0; i<10; i++) key.push_back(getArg(i));
+    GridFunction function(*this);
+    _grid = EvtVubIntegralGrid::getGrid(key, 4, function);
+  }
+
   // check that there are 3 daughters and 10 arguments
   checkNDaug(3);
   checkNArg(10);
@@ -339,14 +379,29 @@ void EvtVubBLNP::decay(EvtParticle *Bmeson) {
 
 double EvtVubBLNP::rate3(double Pp, double Pl, double Pm) {
 
+  double done[4];
+  double mB = gvars[5];
+  if (!_grid || !_grid->interpolate(sqrt(Pp/mB), (Pm - Pp)/(mB - Pp), done)) {
+    done[0] = DoneJS(Pp, Pm, mui);
+    done[1] = Done1(Pp, Pm, mui);
+    done[2] = Done2(Pp, Pm, mui);
+    done[3] = Done3(Pp, Pm, mui);
+  }
+
+  return rate3(Pp, Pl, Pm, done);
+
+}
+
+double EvtVubBLNP::rate3(double Pp, double Pl, double Pm, const double done[]) {
+
   // rate3 in units of GF^2*Vub^2/pi^3
 
   double factor = 1.0/16*(mBB-Pp)*U1lo(muh, mui)*pow( (Pm - Pp)/(mBB - Pp), alo(muh, mui));
 
-  double doneJS = DoneJS(Pp, Pm, mui);
-  double done1 = Done1(Pp, Pm, mui);
-  double done2 = Done2(Pp, Pm, mui);
-  double done3 = Done3(Pp, Pm, mui);
+  double doneJS = done[0];
+  double done1 = done[1];
+  double done2 = done[2];
+  double done3 = done[3];
 
   // The EvtSimpsonIntegrator returns zero for bad integrals.
   // So if any of the integrals are zero (ie bad), return zero.
@@ -439,79 +494,63 @@ double EvtVubBLNP::F3(double Pp, double Pm, double /*muh*/, double /*mui*/, doub
 
 }
 
-double EvtVubBLNP::DoneJS(double Pp, double Pm, double /*mui*/) {
+void EvtVubBLNP::GridFunction::values(double u, double v, double f[]) const {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
-  
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;
+  double mB = _model.gvars[5];
+  double Pp = u*u*mB;
+  double Pm = Pp + v*(mB - Pp);
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&IntJS, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+  f[0] = _model.DoneJS(Pp, Pm, _model.mui);
+  f[1] = _model.Done1(Pp, Pm, _model.mui);
+  f[2] = _model.Done2(Pp, Pm, _model.mui);
+  f[3] = _model.Done3(Pp, Pm, _model.mui);
 
 }
 
-double EvtVubBLNP::Done1(double Pp, double Pm, double /*mui*/) {
+double EvtVubBLNP::GridFunction::rate(double u, double v, double w, const double f[]) const {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  double mB = _model.gvars[5];
+  double Pp = u*u*mB;
+  double Pm = Pp + v*(mB - Pp);
+  double Pl = Pp + w*(Pm - Pp);
+
+  return _model.rate3(Pp, Pl, Pm, f);
+
+}
+
+double EvtVubBLNP::Done(EvtItgPtrFunction *func, const EvtItgAbsIntegrator *integ, double Pp, double Pm) {
+
+  func->setCoeff(1, 0, Pp);
+  func->setCoeff(1, 1, Pm);
 
   double lowerlim = 0.001*Pp;
   double upperlim = (1.0-0.001)*Pp;
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int1, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+  return integ->evaluate(lowerlim, upperlim);
 
 }
 
-double EvtVubBLNP::Done2(double Pp, double Pm, double /*mui*/) {
+double EvtVubBLNP::DoneJS(double Pp, double Pm, double /*mui*/) {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  return Done(_funcJS, _integJS, Pp, Pm);
 
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;
+}
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int2, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+double EvtVubBLNP::Done1(double Pp, double Pm, double /*mui*/) {
+
+  return Done(_func1, _integ1, Pp, Pm);
 
 }
 
-double EvtVubBLNP::Done3(double Pp, double Pm, double /*mui*/) {
+double EvtVubBLNP::Done2(double Pp, double Pm, double /*mui*/) {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  return Done(_func2, _integ2, Pp, Pm);
 
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;  
-
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int3, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+}
+
+double EvtVubBLNP::Done3(double Pp, double Pm, double /*mui*/) {
+
+  return Done(_func3, _integ3, Pp, Pm);
 
 }
 
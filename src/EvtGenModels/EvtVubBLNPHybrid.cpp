@@ -18,7 +18,7 @@
 #include "EvtGenModels/EvtVubBLNPHybrid.hh"
 #include <string>
 #include "EvtGenBase/EvtVector4R.hh"
-#include "EvtGenModels/EvtItgSimpsonIntegrator.hh"
+#include "EvtGenModels/EvtItgGaussKronrodIntegrator.hh"
 #include "EvtGenModels/EvtItgPtrFunction.hh"
 #include "EvtGenBase/EvtRandom.hh"
 #include "EvtGenModels/EvtPFermi.hh"
@@ -36,16 +36,28 @@ using std::endl;
 EvtVubBLNPHybrid::EvtVubBLNPHybrid() 
   : _noHybrid(false), _storeWhat(true),
     _nbins_mX(0), _nbins_q2(0), _nbins_El(0), _nbins(0),
-    _masscut(0.28), _bins_mX(0), _bins_q2(0), _bins_El(0),
-    _weights(0)
+    _masscut(0.28),
+    _funcJS(0), _func1(0), _func2(0), _func3(0),
+    _integJS(0), _integ1(0), _integ2(0), _integ3(0),
+    _grid(0)
 {}
 
 
 EvtVubBLNPHybrid::~EvtVubBLNPHybrid() {
-  delete [] _bins_mX;
-  delete [] _bins_q2;
-  delete [] _bins_El;
-  delete [] _weights;
+  deleteIntegrators();
+}
+
+void EvtVubBLNPHybrid::deleteIntegrators() {
+  delete _integJS;
+  delete _integ1;
+  delete _integ2;
+  delete _integ3;
+  delete _funcJS;
+  delete _func1;
+  delete _func2;
+  delete _func3;
+  _integJS = _integ1 = _integ2 = _integ3 = 0;
+  _funcJS = _func1 = _func2 = _func3 = 0;
 }
 
 std::string EvtVubBLNPHybrid::getName(){
@@ -165,7 +177,6 @@ void EvtVubBLNPHybrid::init() {
   flag2loop = 1;
 
   // stuff for the integrator
-  maxLoop = 20;
   //precision = 1.0e-3;
   precision = 2.0e-2;
 
@@ -183,6 +194,27 @@ void EvtVubBLNPHybrid::init() {
   gvars.push_back(beta2); // 10
   gvars.push_back(dtype); // 11
 
+  // Pp and Pm (gvars[0] and gvars[1]) are set for each integral; the
+  // integrands are only evaluated between 0.001*Pp and 0.999*Pp < mBB
+  deleteIntegrators();
+  _funcJS = new EvtItgPtrFunction(&IntJS, 0.0, mBB, gvars);
+  _func1 = new EvtItgPtrFunction(&Int1, 0.0, mBB, gvars);
+  _func2 = new EvtItgPtrFunction(&Int2, 0.0, mBB, gvars);
+  _func3 = new EvtItgPtrFunction(&Int3, 0.0, mBB, gvars);
+  _integJS = new EvtItgGaussKronrodIntegrator(*_funcJS, precision);
+  _integ1 = new EvtItgGaussKronrodIntegrator(*_func1, precision);
+  _integ2 = new EvtItgGaussKronrodIntegrator(*_func2, precision);
+  _integ3 = new EvtItgGaussKronrodIntegrator(*_func3, precision);
+
+  // VUB_BLNP and VUB_BLNPHYBRID share their grids
+  _grid = 0;
+  if (EvtVubIntegralGrid::getTolerance() > 0.0) {
+    std::vector<double> key(1, 1.0);
+    for (int i=0; i<10; i++) key.push_back(getArg(i));
+    GridFunction function(*this);
+    _grid = EvtVubIntegralGrid::getGrid(key, 4, function);
+  }
+
   // check that there are 3 daughters and 10 arguments
   checkNDaug(3);
   // A. Volk: check for number of arguments is not necessary
@@ -211,21 +243,24 @@ void EvtVubBLNPHybrid::init() {
   // read bin boundaries from decay.dec
   int i;
 
-  _bins_mX  = new double[_nbins_mX];
+  std::vector<double> bins_mX(_nbins_mX);
   for (i = 0; i < _nbins_mX; i++,nextArg++) {
-    _bins_mX[i] = getArg(nextArg);
+    bins_mX[i] = getArg(nextArg);
   }
-  _masscut = _bins_mX[0];
+  if (_nbins_mX > 0) _masscut = bins_mX[0];
+  _weights.addAxis(bins_mX);
   
-  _bins_q2  = new double[_nbins_q2];
+  std::vector<double> bins_q2(_nbins_q2);
   for (i = 0; i < _nbins_q2; i++,nextArg++) {
-    _bins_q2[i] = getArg(nextArg);    
+    bins_q2[i] = getArg(nextArg);    
   }
+  _weights.addAxis(bins_q2);
   
-  _bins_El  = new double[_nbins_El];
+  std::vector<double> bins_El(_nbins_El);
   for (i = 0; i < _nbins_El; i++,nextArg++) {
-    _bins_El[i] = getArg(nextArg);    
+    bins_El[i] = getArg(nextArg);    
   }
+  _weights.addAxis(bins_El);
   
   // read in weights (and rescale to range 0..1)
   readWeights(nextArg); 
@@ -436,14 +471,29 @@ void EvtVubBLNPHybrid::decay(EvtParticle *Bmeson) {
 
 double EvtVubBLNPHybrid::rate3(double Pp, double Pl, double Pm) {
 
+  double done[4];
+  double mB = gvars[5];
+  if (!_grid || !_grid->interpolate(sqrt(Pp/mB), (Pm - Pp)/(mB - Pp), done)) {
+    done[0] = DoneJS(Pp, Pm, mui);
+    done[1] = Done1(Pp, Pm, mui);
+    done[2] = Done2(Pp, Pm, mui);
+    done[3] = Done3(Pp, Pm, mui);
+  }
+
+  return rate3(Pp, Pl, Pm, done);
+
+}
+
+double EvtVubBLNPHybrid::rate3(double Pp, double Pl, double Pm, const double done[]) {
+
   // rate3 in units of GF^2*Vub^2/pi^3
 
   double factor = 1.0/16*(mBB-Pp)*U1lo(muh, mui)*pow( (Pm - Pp)/(mBB - Pp), alo(muh, mui));
 
-  double doneJS = DoneJS(Pp, Pm, mui);
-  double done1 = Done1(Pp, Pm, mui);
-  double done2 = Done2(Pp, Pm, mui);
-  double done3 = Done3(Pp, Pm, mui);
+  double doneJS = done[0];
+  double done1 = done[1];
+  double done2 = done[2];
+  double done3 = done[3];
 
   // The EvtSimpsonIntegrator returns zero for bad integrals.
   // So if any of the integrals are zero (ie bad), return zero.
@@ -536,79 +586,63 @@ double EvtVubBLNPHybrid::F3(double Pp, double Pm, double /*muh*/, double /* mui
 
 }
 
-double EvtVubBLNPHybrid::DoneJS(double Pp, double Pm, double /* mui */) {
+void EvtVubBLNPHybrid::GridFunction::values(double u, double v, double f[]) const {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
-  
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;
+  double mB = _model.gvars[5];
+  double Pp = u*u*mB;
+  double Pm = Pp + v*(mB - Pp);
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&IntJS, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+  f[0] = _model.DoneJS(Pp, Pm, _model.mui);
+  f[1] = _model.Done1(Pp, Pm, _model.mui);
+  f[2] = _model.Done2(Pp, Pm, _model.mui);
+  f[3] = _model.Done3(Pp, Pm, _model.mui);
 
 }
 
-double EvtVubBLNPHybrid::Done1(double Pp, double Pm, double /* mui */) {
+double EvtVubBLNPHybrid::GridFunction::rate(double u, double v, double w, const double f[]) const {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  double mB = _model.gvars[5];
+  double Pp = u*u*mB;
+  double Pm = Pp + v*(mB - Pp);
+  double Pl = Pp + w*(Pm - Pp);
+
+  return _model.rate3(Pp, Pl, Pm, f);
+
+}
+
+double EvtVubBLNPHybrid::Done(EvtItgPtrFunction *func, const EvtItgAbsIntegrator *integ, double Pp, double Pm) {
+
+  func->setCoeff(1, 0, Pp);
+  func->setCoeff(1, 1, Pm);
 
   double lowerlim = 0.001*Pp;
   double upperlim = (1.0-0.001)*Pp;
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int1, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+  return integ->evaluate(lowerlim, upperlim);
 
 }
 
-double EvtVubBLNPHybrid::Done2(double Pp, double Pm, double /* mui */ ) {
+double EvtVubBLNPHybrid::DoneJS(double Pp, double Pm, double /* mui */) {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  return Done(_funcJS, _integJS, Pp, Pm);
 
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;
+}
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int2, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+double EvtVubBLNPHybrid::Done1(double Pp, double Pm, double /* mui */) {
+
+  return Done(_func1, _integ1, Pp, Pm);
 
 }
 
-double EvtVubBLNPHybrid::Done3(double Pp, double Pm, double /* mui */) {
+double EvtVubBLNPHybrid::Done2(double Pp, double Pm, double /* mui */) {
 
-  std::vector<double> vars(12);
-  vars[0] = Pp;
-  vars[1] = Pm;
-  for (int j=2;j<12;j++) {vars[j] = gvars[j];}
+  return Done(_func2, _integ2, Pp, Pm);
 
-  double lowerlim = 0.001*Pp;
-  double upperlim = (1.0-0.001)*Pp;  
+}
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&Int3, lowerlim, upperlim, vars);
-  EvtItgSimpsonIntegrator *integ = new EvtItgSimpsonIntegrator(*func, precision, maxLoop);
-  double myintegral = integ->evaluate(lowerlim, upperlim);
-  delete integ;
-  delete func;
-  return myintegral;
+double EvtVubBLNPHybrid::Done3(double Pp, double Pm, double /* mui */) {
+
+  return Done(_func3, _integ3, Pp, Pm);
 
 }
 
@@ -1021,39 +1055,27 @@ double EvtVubBLNPHybrid::findBLNPWhat() {
 
 double EvtVubBLNPHybrid::getWeight(double mX, double q2, double El) {
 
-  int ibin_mX = -1;
-  int ibin_q2 = -1;
-  int ibin_El = -1;
-
-  for (int i = 0; i < _nbins_mX; i++) {
-    if (mX >= _bins_mX[i]) ibin_mX = i;
-  }
-  for (int i = 0; i < _nbins_q2; i++) {
-    if (q2 >= _bins_q2[i]) ibin_q2 = i;
-  }
-  for (int i = 0; i < _nbins_El; i++) {
-    if (El >= _bins_El[i]) ibin_El = i;
-  }
-  int ibin = ibin_mX + ibin_q2*_nbins_mX + ibin_El*_nbins_mX*_nbins_q2;
+  double x[3] = {mX, q2, El};
+  int ibin = _weights.findBin(x);
 
-  if ( (ibin_mX < 0) || (ibin_q2 < 0) || (ibin_El < 0) ) {
+  if (ibin < 0) {
     EvtGenReport(EVTGEN_ERROR,"EvtVubHybrid") << "Cannot determine hybrid weight "
                                  << "for this event " 
 				 << "-> assign weight = 0" << endl;
     return 0.0;
   }
 
-  return _weights[ibin];
+  return _weights.getWeight(ibin);
 }
 
 
 void EvtVubBLNPHybrid::readWeights(int startArg) {
-  _weights  = new double[_nbins];
+  std::vector<double> weights(_nbins);
 
   double maxw = 0.0;
   for (int i = 0; i < _nbins; i++, startArg++) {
-    _weights[i] = getArg(startArg);
-    if (_weights[i] > maxw) maxw = _weights[i];
+    weights[i] = getArg(startArg);
+    if (weights[i] > maxw) maxw = weights[i];
   }
 
   if (maxw == 0) {
@@ -1065,6 +1087,7 @@ void EvtVubBLNPHybrid::readWeights(int startArg) {
 
   // rescale weights (to be in range 0..1)
   for (int i = 0; i < _nbins; i++) {
-    _weights[i] /= maxw;
+    weights[i] /= maxw;
   }
+  _weights.setWeights(weights);
 }
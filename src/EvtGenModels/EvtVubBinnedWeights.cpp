@@ -0,0 +1,177 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtVubBinnedWeights
+//
+// Description: Binned reweighting table, see EvtVubBinnedWeights.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenModels/EvtVubBinnedWeights.hh"
+#include "EvtGenBase/EvtReport.hh"
+
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+
+using std::endl;
+
+namespace {
+
+  // Cells per bin of an axis
+  const int cellsPerBin = 4;
+
+}
+
+void EvtVubBinnedWeights::addAxis(const std::vector<double> &edges, EdgeType type) {
+
+  Axis axis;
+  axis.edges = edges;
+  axis.closedBelow = (type == closedBelow);
+  axis.ascending = true;
+  axis.low = 0.;
+  axis.scale = 0.;
+
+  int n = edges.size();
+  for (int i=1; i<n; i++) {
+    if (!(edges[i] >= edges[i-1])) axis.ascending = false;
+  }
+
+  if (n > 0 && axis.ascending) {
+    int nCells = cellsPerBin*n;
+    axis.low = edges[0];
+    if (edges[n-1] > edges[0]) axis.scale = nCells/(edges[n-1]-edges[0]);
+    else nCells = 1;
+    axis.cellBin.resize(nCells);
+    for (int c=0; c<nCells; c++) {
+      double x = axis.scale > 0. ? axis.low + c/axis.scale : axis.low;
+      int i = findBinLinear(axis, x);
+      axis.cellBin[c] = i > 0 ? i : 0;
+    }
+  }
+
+  // The lookup has to choose the same bins as the linear search
+  std::vector<double> points;
+  for (int i=0; i<n; i++) {
+    points.push_back(edges[i]);
+    points.push_back(nextafter(edges[i], -DBL_MAX));
+    points.push_back(nextafter(edges[i], DBL_MAX));
+    if (i+1 < n) points.push_back(0.5*(edges[i]+edges[i+1]));
+  }
+  if (n > 0) points.push_back(edges[n-1]+1.);
+
+  for (size_t k=0; k<points.size(); k++) {
+    if (findBin(axis, points[k]) != findBinLinear(axis, points[k])) {
+      EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVubBinnedWeights: bin lookup failed at "
+                                          << points[k] << ", found bin " << findBin(axis, points[k])
+                                          << " instead of " << findBinLinear(axis, points[k]) << endl;
+      EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution!" << endl;
+      ::abort();
+    }
+  }
+
+  _axes.push_back(axis);
+
+}
+
+void EvtVubBinnedWeights::setWeights(const std::vector<double> &weights) {
+
+  size_t nBins = 1;
+  for (size_t a=0; a<_axes.size(); a++) nBins *= _axes[a].edges.size();
+
+  if (weights.size() != nBins) {
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVubBinnedWeights: expected " << nBins
+                                        << " weights but found " << weights.size() << endl;
+    EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution!" << endl;
+    ::abort();
+  }
+
+  _weights = weights;
+
+}
+
+int EvtVubBinnedWeights::findBin(int axis, double x) const {
+
+  return findBin(_axes[axis], x);
+
+}
+
+int EvtVubBinnedWeights::findBin(const double x[]) const {
+
+  int bin(0), stride(1);
+  for (size_t a=0; a<_axes.size(); a++) {
+    int i = findBin(_axes[a], x[a]);
+    if (i < 0) return -1;
+    bin += i*stride;
+    stride *= _axes[a].edges.size();
+  }
+  return bin;
+
+}
+
+bool EvtVubBinnedWeights::aboveEdge(const Axis &axis, double x, int i) {
+
+  return axis.closedBelow ? x >= axis.edges[i] : x > axis.edges[i];
+
+}
+
+int EvtVubBinnedWeights::findBinLinear(const Axis &axis, double x) {
+
+  int n = axis.edges.size();
+
+  // The last edge at or below x, as the hybrid models did
+  if (axis.closedBelow) {
+    int bin(-1);
+    for (int i=0; i<n; i++) {
+      if (x >= axis.edges[i]) bin = i;
+    }
+    return bin;
+  }
+
+  // The first edge at or above x, less one, as EvtVub did
+  int j(0);
+  while (j < n && x > axis.edges[j]) j++;
+  return j-1;
+
+}
+
+int EvtVubBinnedWeights::findBin(const Axis &axis, double x) {
+
+  if (!axis.ascending) return findBinLinear(axis, x);
+
+  int n = axis.edges.size();
+  if (n == 0 || !aboveEdge(axis, x, 0)) return -1;
+
+  // The bins at the lower ends of the cell and of the next one bound the
+  // bin of x; bisect the edges in between, which are few however the
+  // edges are clustered
+  int nCells = axis.cellBin.size();
+  double c = (x-axis.low)*axis.scale;
+  int lo = c < nCells ? axis.cellBin[int(c)] : n-1;
+  int hi = c+1 < nCells ? axis.cellBin[int(c)+1] : n-1;
+
+  std::vector<double>::const_iterator first = axis.edges.begin()+lo+1;
+  std::vector<double>::const_iterator last = axis.edges.begin()+hi+1;
+  std::vector<double>::const_iterator above = axis.closedBelow ?
+    std::upper_bound(first, last, x) : std::lower_bound(first, last, x);
+  int i = above-axis.edges.begin()-1;
+
+  // Rounding of the cell number may put x just outside the range
+  while (i+1 < n && aboveEdge(axis, x, i+1)) i++;
+  while (i > 0 && !aboveEdge(axis, x, i)) i--;
+
+  return i;
+
+}
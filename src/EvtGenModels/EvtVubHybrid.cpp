@@ -16,6 +16,7 @@
 //
 //   Jochen Dingfelder February 1, 2005  Created Module as update of the
 //                                       original module EvtVub by Sven Menke 
+//   Oct 2026                            Weights in an EvtVubBinnedWeights
 //---------------------------------------------------------------------------
 //
 #include "EvtGenBase/EvtPatches.hh"
@@ -45,16 +46,11 @@ EvtVubHybrid::EvtVubHybrid()
   : _noHybrid(false), _storeQplus(true),
     _mb(4.62), _a(2.27), _alphas(0.22), _dGMax(3.),
     _nbins_mX(0), _nbins_q2(0), _nbins_El(0), _nbins(0),
-    _masscut(0.28), _bins_mX(0), _bins_q2(0), _bins_El(0),
-    _weights(0), _dGamma(0)
+    _masscut(0.28), _dGamma(0)
 {}
 
 EvtVubHybrid::~EvtVubHybrid() {
   delete _dGamma;
-  delete [] _bins_mX;
-  delete [] _bins_q2;
-  delete [] _bins_El;
-  delete [] _weights;
 
 }
 
@@ -155,21 +151,24 @@ void EvtVubHybrid::init(){
   // read bin boundaries from decay.dec
   int i;
 
-  _bins_mX  = new double[_nbins_mX];
+  std::vector<double> bins_mX(_nbins_mX);
   for (i = 0; i < _nbins_mX; i++,nextArg++) {
-    _bins_mX[i] = getArg(nextArg);
+    bins_mX[i] = getArg(nextArg);
   }
-  _masscut = _bins_mX[0];
+  if (_nbins_mX > 0) _masscut = bins_mX[0];
+  _weights.addAxis(bins_mX);
 
-  _bins_q2  = new double[_nbins_q2];
+  std::vector<double> bins_q2(_nbins_q2);
   for (i = 0; i < _nbins_q2; i++,nextArg++) {
-    _bins_q2[i] = getArg(nextArg);    
+    bins_q2[i] = getArg(nextArg);    
   }
+  _weights.addAxis(bins_q2);
 
-  _bins_El  = new double[_nbins_El];
+  std::vector<double> bins_El(_nbins_El);
   for (i = 0; i < _nbins_El; i++,nextArg++) {
-    _bins_El[i] = getArg(nextArg);    
+    bins_El[i] = getArg(nextArg);    
   }
+  _weights.addAxis(bins_El);
     
   // read in weights (and rescale to range 0..1)
   readWeights(nextArg); 
@@ -428,39 +427,27 @@ double EvtVubHybrid::findPFermi() {
 
 double EvtVubHybrid::getWeight(double mX, double q2, double El) {
 
-  int ibin_mX = -1;
-  int ibin_q2 = -1;
-  int ibin_El = -1;
+  double x[3] = {mX, q2, El};
+  int ibin = _weights.findBin(x);
 
-  for (int i = 0; i < _nbins_mX; i++) {
-    if (mX >= _bins_mX[i]) ibin_mX = i;
-  }
-  for (int i = 0; i < _nbins_q2; i++) {
-    if (q2 >= _bins_q2[i]) ibin_q2 = i;
-  }
-  for (int i = 0; i < _nbins_El; i++) {
-    if (El >= _bins_El[i]) ibin_El = i;
-  }
-  int ibin = ibin_mX + ibin_q2*_nbins_mX + ibin_El*_nbins_mX*_nbins_q2;
-
-  if ( (ibin_mX < 0) || (ibin_q2 < 0) || (ibin_El < 0) ) {
+  if (ibin < 0) {
     EvtGenReport(EVTGEN_ERROR,"EvtVubHybrid") << "Cannot determine hybrid weight "
                                  << "for this event " 
 				 << "-> assign weight = 0" << endl;
     return 0.0;
   }
 
-  return _weights[ibin];
+  return _weights.getWeight(ibin);
 }
 
 
 void EvtVubHybrid::readWeights(int startArg) {
-  _weights  = new double[_nbins];
+  std::vector<double> weights(_nbins);
 
   double maxw = 0.0;
   for (int i = 0; i < _nbins; i++, startArg++) {
-    _weights[i] = getArg(startArg);
-    if (_weights[i] > maxw) maxw = _weights[i];
+    weights[i] = getArg(startArg);
+    if (weights[i] > maxw) maxw = weights[i];
   }
 
   if (maxw == 0) {
@@ -472,6 +459,7 @@ void EvtVubHybrid::readWeights(int startArg) {
 
   // rescale weights (to be in range 0..1)
   for (int i = 0; i < _nbins; i++) {
-    _weights[i] /= maxw;
+    weights[i] /= maxw;
   }
+  _weights.setWeights(weights);
 }
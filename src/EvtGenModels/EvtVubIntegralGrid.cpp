@@ -0,0 +1,211 @@
+//--------------------------------------------------------------------------
+//
+// Environment:
+//      This software is part of the EvtGen package. If you use all or part
+//      of it, please give an appropriate acknowledgement.
+//
+// Copyright Information: See EvtGen/COPYRIGHT
+//
+// Module: EvtVubIntegralGrid
+//
+// Description: Tabulated shape function integrals, see EvtVubIntegralGrid.hh
+//
+// Modification history:
+//
+//    Oct 2026            Module created
+//
+//------------------------------------------------------------------------
+//
+#include "EvtGenBase/EvtPatches.hh"
+
+#include "EvtGenModels/EvtVubIntegralGrid.hh"
+#include "EvtGenBase/EvtReport.hh"
+
+#include <map>
+#include <cmath>
+#include <cfloat>
+
+#ifdef EVTGEN_CPP11
+#include <mutex>
+#endif
+
+using std::endl;
+
+double EvtVubIntegralGrid::_tolerance = 0.0;
+
+namespace {
+
+  // The grids made so far, by key (which includes the tolerance)
+  class GridStore {
+  public:
+    ~GridStore() {
+      std::map<std::vector<double>, EvtVubIntegralGrid*>::iterator it;
+      for (it=grids.begin(); it!=grids.end(); ++it) delete it->second;
+    }
+    std::map<std::vector<double>, EvtVubIntegralGrid*> grids;
+  };
+
+  GridStore theStore;
+
+#ifdef EVTGEN_CPP11
+  // Models may be initialised by generators on several threads
+  std::mutex& storeMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+#endif
+
+  // The points of a cell, in units of the cell size, at which the rate
+  // is compared: the centre, the edge centres and just inside the corners
+  const double eps = 0.01;
+  const int nPoint = 9;
+  const double pointCheck[nPoint][2] = {
+    {0.5,0.5},
+    {0.0,0.5}, {1.0,0.5}, {0.5,0.0}, {0.5,1.0},
+    {eps,eps}, {eps,1-eps}, {1-eps,eps}, {1-eps,1-eps}
+  };
+
+  // The points in w at which the rate is compared
+  const int nW = 3;
+  const double wCheck[nW] = {0.25, 0.5, 0.75};
+
+  const int nCheck = nPoint*nW;
+
+  bool isFinite(double x) {return x == x && fabs(x) <= DBL_MAX;}
+
+}
+
+const EvtVubIntegralGrid* EvtVubIntegralGrid::getGrid(const std::vector<double> &key, int nValues,
+                                                      const Function &function) {
+
+  std::vector<double> fullKey(key);
+  fullKey.push_back(nValues);
+  fullKey.push_back(_tolerance);
+
+#ifdef EVTGEN_CPP11
+  std::lock_guard<std::mutex> lock(storeMutex());
+#endif
+
+  std::map<std::vector<double>, EvtVubIntegralGrid*>::iterator it = theStore.grids.find(fullKey);
+  if (it != theStore.grids.end()) return it->second;
+
+  EvtVubIntegralGrid* grid = new EvtVubIntegralGrid(nValues, function, _tolerance);
+  theStore.grids[fullKey] = grid;
+
+  EvtGenReport(EVTGEN_INFO,"EvtGen") << "EvtVubIntegralGrid: tabulated the shape function integrals on a "
+                                     << (int)nGrid << "x" << (int)nGrid << " grid with tolerance " << _tolerance
+                                     << "; " << grid->getNExactCells() << " cells are evaluated exactly." << endl;
+
+  return grid;
+
+}
+
+EvtVubIntegralGrid::EvtVubIntegralGrid(int nValues, const Function &function, double tolerance) :
+  _nValues(nValues),
+  _nExact(0),
+  _table((nGrid+1)*(nGrid+1)*nValues, 0.0),
+  _exactCell(nGrid*nGrid, false)
+{
+
+  const double h = 1.0/nGrid;
+
+  // The nodes at u=0 or v=0 are only used by cells that are always
+  // evaluated exactly
+  for (int iu=1; iu<=nGrid; iu++) {
+    for (int iv=1; iv<=nGrid; iv++) {
+      function.values(iu*h, iv*h, &_table[(iu*(nGrid+1)+iv)*_nValues]);
+    }
+  }
+
+  // The rates at the check points of each cell, exact and interpolated
+  std::vector<double> exactRate(nGrid*nGrid*nCheck, 0.0);
+  std::vector<double> gridRate(nGrid*nGrid*nCheck, 0.0);
+  std::vector<double> exact(_nValues), interpolated(_nValues);
+
+  double sumRate = 0.0;
+  int nRate = 0;
+
+  for (int iu=0; iu<nGrid; iu++) {
+    for (int iv=0; iv<nGrid; iv++) {
+
+      int cell = iu*nGrid+iv;
+      if (iu == 0 || iv == 0) {
+        _exactCell[cell] = true;
+        continue;
+      }
+
+      for (int p=0; p<nPoint; p++) {
+
+        double u = (iu+pointCheck[p][0])*h;
+        double v = (iv+pointCheck[p][1])*h;
+        function.values(u, v, &exact[0]);
+        interpolateCell(iu, iv, pointCheck[p][0], pointCheck[p][1], &interpolated[0]);
+
+        for (int k=0; k<nW; k++) {
+          double re = function.rate(u, v, wCheck[k], &exact[0]);
+          double ri = function.rate(u, v, wCheck[k], &interpolated[0]);
+          exactRate[cell*nCheck+p*nW+k] = re;
+          gridRate[cell*nCheck+p*nW+k] = ri;
+          if (isFinite(re)) {
+            sumRate += fabs(re);
+            nRate++;
+          }
+        }
+
+      }
+
+    }
+  }
+
+  double meanRate = nRate > 0 ? sumRate/nRate : 0.0;
+
+  for (int cell=0; cell<nGrid*nGrid; cell++) {
+    if (_exactCell[cell]) continue;
+    for (int k=0; k<nCheck; k++) {
+      double re = exactRate[cell*nCheck+k];
+      double ri = gridRate[cell*nCheck+k];
+      double scale = fabs(re) > meanRate ? fabs(re) : meanRate;
+      if (!isFinite(re) || !isFinite(ri) || fabs(ri-re) > tolerance*scale) {
+        _exactCell[cell] = true;
+        break;
+      }
+    }
+  }
+
+  for (int cell=0; cell<nGrid*nGrid; cell++) {
+    if (_exactCell[cell]) _nExact++;
+  }
+
+}
+
+bool EvtVubIntegralGrid::interpolate(double u, double v, double f[]) const {
+
+  if (!(u > 0.0 && u < 1.0 && v > 0.0 && v < 1.0)) return false;
+
+  double x = u*nGrid;
+  double y = v*nGrid;
+  int iu = (int)x;
+  int iv = (int)y;
+  if (iu >= nGrid) iu = nGrid-1;
+  if (iv >= nGrid) iv = nGrid-1;
+
+  if (_exactCell[iu*nGrid+iv]) return false;
+
+  interpolateCell(iu, iv, x-iu, y-iv, f);
+  return true;
+
+}
+
+void EvtVubIntegralGrid::interpolateCell(int iu, int iv, double du, double dv,
+                                         double f[]) const {
+
+  const double* f00 = &_table[(iu*(nGrid+1)+iv)*_nValues];
+  const double* f01 = f00+_nValues;
+  const double* f10 = f00+(nGrid+1)*_nValues;
+  const double* f11 = f10+_nValues;
+
+  for (int i=0; i<_nValues; i++) {
+    f[i] = (1.0-du)*((1.0-dv)*f00[i] + dv*f01[i]) + du*((1.0-dv)*f10[i] + dv*f11[i]);
+  }
+
+}
@@ -16,6 +16,9 @@
 // Modification history:
 //
 //    Riccardo Faccini       Feb. 11, 2004       
+//                           Oct 2026            Reuse the jet function integrator
+//                           Oct 2026            Optional tabulation of the integrals
+//                           Oct 2026            Weights in an EvtVubBinnedWeights
 //
 //------------------------------------------------------------------------
 //
@@ -28,7 +31,8 @@
 #include "EvtGenModels/EvtVubNLO.hh"
 #include <string>
 #include "EvtGenBase/EvtVector4R.hh"
-#include "EvtGenModels/EvtItgSimpsonIntegrator.hh"
+#include "EvtGenModels/EvtItgGaussKronrodIntegrator.hh"
+#include "EvtGenModels/EvtVubIntegralGrid.hh"
 #include "EvtGenModels/EvtBtoXsgammaFermiUtil.hh"
 #include "EvtGenModels/EvtItgPtrFunction.hh"
 #include "EvtGenModels/EvtPFermi.hh"
@@ -39,8 +43,8 @@ using std::cout;
 using std::endl;
 
 EvtVubNLO::~EvtVubNLO() {
-  delete [] _masses;
-  delete [] _weights;
+  delete _jetSF;
+  delete _jetFunc;
   cout <<" max pdf : "<<_gmax<<endl;
   cout <<" efficiency : "<<(float)_ngood/(float)_ntot<<endl;
 
@@ -88,8 +92,8 @@ void EvtVubNLO::init(){
   _kpar         = getArg(3);// 0
   _idSF         = abs((int)getArg(4));// type of shape function 1: exponential (from Neubert)
   _nbins        = abs((int)getArg(5));
-  _masses       = new double[_nbins];
-  _weights      = new double[_nbins];
+  _masses.resize(_nbins);
+  std::vector<double> weights(_nbins);
 
   // Shape function normalization
   _mB=5.28;// temporary B meson mass for normalization
@@ -105,6 +109,13 @@ void EvtVubNLO::init(){
   sCoeffs[10] = 1.;
   _SFNorm = SFNorm(sCoeffs) ; // SF normalization;
 
+  // the coefficients are set by tripleDiff; the range leaves room for
+  // B mesons heavier than the temporary mass
+  delete _jetSF;
+  delete _jetFunc;
+  _jetFunc = new EvtItgPtrFunction(&integrand, 0., 2*_mB, sCoeffs);
+  _jetSF = new EvtItgGaussKronrodIntegrator(*_jetFunc,0.01);
+
 
   cout << " pdf 0.66, 1.32 , 4.32 "<<tripleDiff(0.66, 1.32 , 4.32)<<endl;
   cout << " pdf 0.23,0.37,3.76 "<<tripleDiff(0.23,0.37,3.76)<<endl;
@@ -130,15 +141,15 @@ void EvtVubNLO::init(){
 			     << "Will terminate execution!"<<endl;
       ::abort();
     }
-    _weights[i] = getArg(j++);
-    if (_weights[i] < 0) {
+    weights[i] = getArg(j++);
+    if (weights[i] < 0) {
       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVubNLO generator expected " 
 			     << " weights >= 0, but found: " 
-			     <<_weights[i] <<endl;
+			     <<weights[i] <<endl;
       EvtGenReport(EVTGEN_ERROR,"EvtGen") << "Will terminate execution!"<<endl;
       ::abort();
     }
-    if ( _weights[i] > maxw ) maxw = _weights[i];
+    if ( weights[i] > maxw ) maxw = weights[i];
   }
   if (maxw == 0) {
     EvtGenReport(EVTGEN_ERROR,"EvtGen") << "EvtVubNLO generator expected at least one " 
@@ -146,7 +157,9 @@ void EvtVubNLO::init(){
 			   << "Will terminate execution!"<<endl;
     ::abort();
   }
-  for (i=0;i<_nbins;i++) _weights[i]/=maxw;
+  for (i=0;i<_nbins;i++) weights[i]/=maxw;
+  _weights.addAxis(_masses, EvtVubBinnedWeights::closedAbove);
+  _weights.setWeights(weights);
 
   // the maximum dGamma*p2 value depends on alpha_s only:
 
@@ -161,6 +174,25 @@ void EvtVubNLO::init(){
   
   // check that there are 3 daughters
   checkNDaug(3);
+
+  // The integrals are tabulated here, for the nominal mass of the B;
+  // decays of B mesons of other masses integrate numerically
+  _grid = 0;
+  _gridMB = 0.;
+  if (EvtVubIntegralGrid::getTolerance() > 0.) {
+    _mB = EvtPDL::getMeanMass(getParentId());
+    std::vector<double> key(1, 2.);
+    key.push_back(_mB);
+    key.push_back(_mb);
+    key.push_back(_b);
+    key.push_back(_lambdaSF);
+    key.push_back(_idSF);
+    key.push_back(_mui);
+    key.push_back(_SFNorm);
+    GridFunction function(*this);
+    _grid = EvtVubIntegralGrid::getGrid(key, 2, function);
+    _gridMB = _mB;
+  }
 }
 
 void EvtVubNLO::initProbMax(){
@@ -189,7 +221,7 @@ void EvtVubNLO::decay( EvtParticle *p ){
   
   _mB = p->mass();
   ml = lepton->mass();
-  
+
   bool tryit = true;
   
   while (tryit) {
@@ -231,9 +263,8 @@ void EvtVubNLO::decay( EvtParticle *p ){
     if(!tryit && _nbins>0){
       _ngood++;
       double xran1 = EvtRandom::Flat();
-      double m = sqrt(sh);j=0;
-      while ( j < _nbins && m > _masses[j] ) j++; 
-      double w = _weights[j-1]; 
+      int bin = _weights.findBin(0, sqrt(sh));
+      double w = bin >= 0 ? _weights.getWeight(bin) : 0.;
       if ( w < xran1 ) tryit = true;// through away this candidate
     }
   }
@@ -344,6 +375,17 @@ void EvtVubNLO::decay( EvtParticle *p ){
 double
 EvtVubNLO::tripleDiff (  double pp, double pl, double pm){
 
+  double jetInt[2];
+  if (_grid && _gridMB == _mB && _grid->interpolate(sqrt(pp/_mB), (pm-pp)/(_mB-pp), jetInt)) {
+    return tripleDiff(pp, pl, pm, jetInt);
+  }
+  return tripleDiff(pp, pl, pm, 0);
+
+}
+
+std::vector<double>
+EvtVubNLO::coefficients (  double pp, double pl, double pm){
+
   std::vector<double> sCoeffs(11);
   sCoeffs[0] = pp;
   sCoeffs[1] = pl;
@@ -356,7 +398,15 @@ EvtVubNLO::tripleDiff (  double pp, double pl, double pm){
   sCoeffs[8] =  mu_h();
   sCoeffs[9] =  mu_i();
   sCoeffs[10] =  _SFNorm; // SF normalization;
-  
+
+  return sCoeffs;
+
+}
+
+double
+EvtVubNLO::tripleDiff (  double pp, double pl, double pm, const double jetInt[]){
+
+  std::vector<double> sCoeffs = coefficients(pp, pl, pm);
 
   double c1=(_mB+pl-pp-pm)*(pm-pl);
   double c2=2*(pl-pp)*(pm-pl);
@@ -367,11 +417,16 @@ EvtVubNLO::tripleDiff (  double pp, double pl, double pm){
   double td0=c1*aF1+c2*aF2+c3*aF3;
 
 
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&integrand, 0., _mB, sCoeffs);
-  EvtItgAbsIntegrator *jetSF = new EvtItgSimpsonIntegrator(*func,0.01,25);
-  double smallfrac=0.000001;// stop a bit before the end to avoid problems with numerical integration
-  double tdInt = jetSF->evaluate(0,pp*(1-smallfrac));
-  delete jetSF;
+  double tdInt;
+  if (jetInt) {
+    // F3Int is F2Int/(2y)
+    double y=(pm-pp)/(_mB-pp);
+    tdInt = c1*jetInt[0]+c2*jetInt[1]+c3*jetInt[1]/(2*y);
+  } else {
+    for (int i=0; i<11; i++) _jetFunc->setCoeff(1,i,sCoeffs[i]);
+    double smallfrac=0.000001;// stop a bit before the end to avoid problems with numerical integration
+    tdInt = _jetSF->evaluate(0,pp*(1-smallfrac));
+  }
   
   double SU=U1lo(mu_h(),mu_i())*pow((pm-pp)/(_mB-pp),alo(mu_h(),mu_i()));
   double TD=(_mB-pp)*SU*(td0+tdInt);
@@ -380,6 +435,36 @@ EvtVubNLO::tripleDiff (  double pp, double pl, double pm){
 
 }
 
+void
+EvtVubNLO::GridFunction::values(double u, double v, double f[]) const {
+
+  double mB = _model._mB;
+  double pp = u*u*mB;
+  double pm = pp + v*(mB-pp);
+  std::vector<double> sCoeffs = _model.coefficients(pp, pp, pm);
+
+  double smallfrac=0.000001;
+  EvtItgPtrFunction func1(&F1Int, 0., mB, sCoeffs);
+  EvtItgGaussKronrodIntegrator jetSF1(func1,0.01);
+  f[0] = jetSF1.evaluate(0,pp*(1-smallfrac));
+  EvtItgPtrFunction func2(&F2Int, 0., mB, sCoeffs);
+  EvtItgGaussKronrodIntegrator jetSF2(func2,0.01);
+  f[1] = jetSF2.evaluate(0,pp*(1-smallfrac));
+
+}
+
+double
+EvtVubNLO::GridFunction::rate(double u, double v, double w, const double f[]) const {
+
+  double mB = _model._mB;
+  double pp = u*u*mB;
+  double pm = pp + v*(mB-pp);
+  double pl = pp + w*(pm-pp);
+
+  return _model.tripleDiff(pp, pl, pm, f);
+
+}
+
 double
 EvtVubNLO::integrand(double omega, const std::vector<double> &coeffs){
   //double pp=coeffs[0];
@@ -648,7 +733,7 @@ double
 EvtVubNLO::Gamma(double z, double tmin) {
   std::vector<double> c(1);
   c[0]=z;
-  EvtItgPtrFunction *func = new EvtItgPtrFunction(&dgamma, tmin, 100., c);
-  EvtItgAbsIntegrator *jetSF = new EvtItgSimpsonIntegrator(*func,0.001);
-  return jetSF->evaluate(tmin,100.);
+  EvtItgPtrFunction func(&dgamma, tmin, 100., c);
+  EvtItgGaussKronrodIntegrator jetSF(func,0.001);
+  return jetSF.evaluate(tmin,100.);
 }